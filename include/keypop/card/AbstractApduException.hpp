@@ -39,7 +39,8 @@ public:
         const std::shared_ptr<CardResponseApi> cardResponseApi,
         const bool isCardResponseComplete,
         const std::string& message)
-    : std::exception(message)
+    : std::exception()
+    , mMessage(message)
     , mCardResponseApi(cardResponseApi)
     , mIsCardResponseComplete(isCardResponseComplete) {
     }
@@ -59,11 +60,35 @@ public:
         const bool isCardResponseComplete,
         const std::string& message,
         const std::shared_ptr<std::exception> cause)
-    : std::exception(message, cause)
+    : std::exception()
+    , mMessage(message)
+    , mCause(cause)
     , mCardResponseApi(cardResponseApi)
     , mIsCardResponseComplete(isCardResponseComplete) {
     }
 
+    /**
+     * Gets the message identifying the exception context.
+     *
+     * @return A not null C string.
+     * @since 2.1.0
+     */
+    const char*
+    what() const noexcept override {
+        return mMessage.c_str();
+    }
+
+    /**
+     * Gets the originating exception.
+     *
+     * @return Null if the exception has no cause.
+     * @since 2.1.0
+     */
+    const std::shared_ptr<std::exception>
+    getCause() const {
+        return mCause;
+    }
+
     /**
      * Gets the response data received so far.
      *
@@ -88,6 +113,16 @@ public:
     }
 
 private:
+    /**
+     *
+     */
+    const std::string mMessage;
+
+    /**
+     *
+     */
+    const std::shared_ptr<std::exception> mCause;
+
     /**
      *
      */
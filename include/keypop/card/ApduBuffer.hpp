@@ -0,0 +1,329 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Maximum length of a short APDU command: header (4) + Lc (1) + data (255) + Le (1).
+ *
+ * @since 2.1.0
+ */
+constexpr std::size_t SHORT_APDU_COMMAND_MAX_LENGTH = 261;
+
+/**
+ * Maximum length of a short APDU response: data (256) + status word (2).
+ *
+ * @since 2.1.0
+ */
+constexpr std::size_t SHORT_APDU_RESPONSE_MAX_LENGTH = 258;
+
+/**
+ * Maximum length of an extended APDU command: header (4) + Lc (3) + data (65535) + Le (2).
+ *
+ * @since 2.1.0
+ */
+constexpr std::size_t EXTENDED_APDU_COMMAND_MAX_LENGTH = 65544;
+
+/**
+ * Growable byte buffer with inline storage, intended to hold APDU bytes.
+ *
+ * <p>As long as its size does not exceed <b>InlineCapacity</b>, the bytes are stored inside the
+ * object itself and no heap allocation takes place. Larger contents (e.g. extended length APDUs)
+ * are transparently moved to a heap storage, whose capacity is kept for later reuse.
+ *
+ * @tparam InlineCapacity The number of bytes that can be stored without heap allocation.
+ * @since 2.1.0
+ */
+template <std::size_t InlineCapacity>
+class BasicApduBuffer final {
+public:
+    /**
+     * Builds an empty buffer.
+     *
+     * @since 2.1.0
+     */
+    BasicApduBuffer() noexcept
+    : mSize(0)
+    , mOnHeap(false) {
+    }
+
+    /**
+     * Builds a buffer containing a copy of the provided bytes.
+     *
+     * @param bytes The bytes to copy.
+     * @since 2.1.0
+     */
+    explicit BasicApduBuffer(const ByteSpan bytes)
+    : BasicApduBuffer() {
+        assign(bytes);
+    }
+
+    /**
+     *
+     */
+    BasicApduBuffer(const BasicApduBuffer& other)
+    : BasicApduBuffer() {
+        assign(other.view());
+    }
+
+    /**
+     *
+     */
+    BasicApduBuffer(BasicApduBuffer&& other) noexcept
+    : mHeap(std::move(other.mHeap))
+    , mSize(other.mSize)
+    , mOnHeap(other.mOnHeap) {
+        if (!mOnHeap) {
+            std::memcpy(mInline, other.mInline, mSize);
+        }
+        other.clear();
+    }
+
+    /**
+     *
+     */
+    BasicApduBuffer&
+    operator=(const BasicApduBuffer& other) {
+        if (this != &other) {
+            assign(other.view());
+        }
+
+        return *this;
+    }
+
+    /**
+     *
+     */
+    BasicApduBuffer&
+    operator=(BasicApduBuffer&& other) noexcept {
+        if (this != &other) {
+            mHeap = std::move(other.mHeap);
+            mSize = other.mSize;
+            mOnHeap = other.mOnHeap;
+            if (!mOnHeap) {
+                std::memcpy(mInline, other.mInline, mSize);
+            }
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    /**
+     * Replaces the content of the buffer by a copy of the provided bytes.
+     *
+     * @param bytes The bytes to copy (must not refer to this buffer).
+     * @since 2.1.0
+     */
+    void
+    assign(const ByteSpan bytes) {
+        resize(bytes.size());
+        if (!bytes.empty()) {
+            std::memcpy(data(), bytes.data(), bytes.size());
+        }
+    }
+
+    /**
+     * Appends a copy of the provided bytes at the end of the buffer.
+     *
+     * @param bytes The bytes to copy (must not refer to this buffer).
+     * @since 2.1.0
+     */
+    void
+    append(const ByteSpan bytes) {
+        const std::size_t offset = mSize;
+        resize(mSize + bytes.size());
+        if (!bytes.empty()) {
+            std::memcpy(data() + offset, bytes.data(), bytes.size());
+        }
+    }
+
+    /**
+     * Appends a single byte at the end of the buffer.
+     *
+     * @param value The byte to append.
+     * @since 2.1.0
+     */
+    void
+    push_back(const uint8_t value) {
+        resize(mSize + 1);
+        data()[mSize - 1] = value;
+    }
+
+    /**
+     * Changes the size of the buffer, keeping the existing bytes.
+     *
+     * <p>Added bytes have an unspecified value.
+     *
+     * @param size The new size.
+     * @since 2.1.0
+     */
+    void
+    resize(const std::size_t size) {
+        if (size <= InlineCapacity) {
+            if (mOnHeap) {
+                std::memcpy(mInline, mHeap.data(), size < mSize ? size : mSize);
+                mHeap.clear();
+                mOnHeap = false;
+            }
+        } else {
+            if (!mOnHeap) {
+                mHeap.assign(mInline, mInline + mSize);
+                mOnHeap = true;
+            }
+            mHeap.resize(size);
+        }
+
+        mSize = size;
+    }
+
+    /**
+     * Empties the buffer, keeping any heap capacity for later reuse.
+     *
+     * @since 2.1.0
+     */
+    void
+    clear() noexcept {
+        mHeap.clear();
+        mSize = 0;
+        mOnHeap = false;
+    }
+
+    /**
+     * @return A pointer to the first byte.
+     * @since 2.1.0
+     */
+    uint8_t*
+    data() noexcept {
+        return mOnHeap ? mHeap.data() : mInline;
+    }
+
+    /**
+     * @return A pointer to the first byte.
+     * @since 2.1.0
+     */
+    const uint8_t*
+    data() const noexcept {
+        return mOnHeap ? mHeap.data() : mInline;
+    }
+
+    /**
+     * @return The number of bytes in the buffer.
+     * @since 2.1.0
+     */
+    std::size_t
+    size() const noexcept {
+        return mSize;
+    }
+
+    /**
+     * @return True if the buffer contains no bytes.
+     * @since 2.1.0
+     */
+    bool
+    empty() const noexcept {
+        return mSize == 0;
+    }
+
+    /**
+     * Indicates whether the bytes are currently held in the inline storage.
+     *
+     * @return False if the content exceeded the inline capacity.
+     * @since 2.1.0
+     */
+    bool
+    isInline() const noexcept {
+        return !mOnHeap;
+    }
+
+    /**
+     * @return The number of bytes that can be stored without heap allocation.
+     * @since 2.1.0
+     */
+    static constexpr std::size_t
+    inlineCapacity() noexcept {
+        return InlineCapacity;
+    }
+
+    /**
+     *
+     */
+    uint8_t&
+    operator[](const std::size_t index) noexcept {
+        return data()[index];
+    }
+
+    /**
+     *
+     */
+    uint8_t
+    operator[](const std::size_t index) const noexcept {
+        return data()[index];
+    }
+
+    /**
+     * Gets a view over the content of the buffer.
+     *
+     * @return A view valid until the next modification of the buffer.
+     * @since 2.1.0
+     */
+    ByteSpan
+    view() const noexcept {
+        return ByteSpan(data(), mSize);
+    }
+
+private:
+    /**
+     *
+     */
+    uint8_t mInline[InlineCapacity];
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mHeap;
+
+    /**
+     *
+     */
+    std::size_t mSize;
+
+    /**
+     *
+     */
+    bool mOnHeap;
+};
+
+/**
+ * Buffer able to hold any short APDU command without heap allocation.
+ *
+ * @since 2.1.0
+ */
+using ApduCommandBuffer = BasicApduBuffer<SHORT_APDU_COMMAND_MAX_LENGTH>;
+
+/**
+ * Buffer able to hold any short APDU response without heap allocation.
+ *
+ * @since 2.1.0
+ */
+using ApduResponseBuffer = BasicApduBuffer<SHORT_APDU_RESPONSE_MAX_LENGTH>;
+
+} /* namespace card */
+} /* namespace keypop */
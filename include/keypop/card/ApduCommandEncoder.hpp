@@ -0,0 +1,174 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "keypop/card/ApduBuffer.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Encoder of a keypop::card::spi::ApduCommand into the APDUs to be exchanged with the card,
+ * according to the capabilities of a reader.
+ *
+ * <p>The command is sent in the fewest exchanges the reader allows:
+ * <ul>
+ * <li>a short APDU if the data and the expected length fit (Lc &le; 255, Le &le; 256),
+ * <li>otherwise an extended-length APDU if the reader accepts commands long enough,
+ * <li>otherwise a chain of APDUs (ISO 7816-4 command chaining): the data is split in chunks sent
+ *     with bit 5 of CLA set (10h), except for the last one which also carries the Le field. The
+ *     chaining bit applies to interindustry classes.
+ * </ul>
+ *
+ * <p>The reader sends the exchanges in order and stops the chain if an intermediate response is
+ * not 9000h; the response to the last exchange is the response to the command.
+ *
+ * <p>Instances are small immutable values.
+ *
+ * @since 2.1.0
+ */
+class ApduCommandEncoder final {
+public:
+    /**
+     * Builds an encoder for a reader accepting commands up to the provided length.
+     *
+     * @param maxCommandLength The maximum length of a command accepted by the reader, from
+     *        keypop::card::SHORT_APDU_COMMAND_MAX_LENGTH (short APDUs only) to
+     *        keypop::card::EXTENDED_APDU_COMMAND_MAX_LENGTH.
+     * @throw std::invalid_argument If the length is out of range.
+     * @since 2.1.0
+     */
+    explicit ApduCommandEncoder(
+        const std::size_t maxCommandLength = SHORT_APDU_COMMAND_MAX_LENGTH)
+    : mMaxCommandLength(maxCommandLength) {
+        if (maxCommandLength < SHORT_APDU_COMMAND_MAX_LENGTH
+            || maxCommandLength > EXTENDED_APDU_COMMAND_MAX_LENGTH) {
+            throw std::invalid_argument("Max command length out of range");
+        }
+    }
+
+    /**
+     * Indicates if the reader accepts extended-length APDUs.
+     *
+     * @return True if the maximum command length exceeds the one of short APDUs.
+     * @since 2.1.0
+     */
+    bool
+    isExtendedLengthSupported() const {
+        return mMaxCommandLength > SHORT_APDU_COMMAND_MAX_LENGTH;
+    }
+
+    /**
+     * Gets the number of exchanges needed to send a command.
+     *
+     * @param command The command.
+     * @return 1 if no chaining is needed.
+     * @since 2.1.0
+     */
+    std::size_t
+    getExchangeCount(const spi::ApduCommand& command) const {
+        const std::size_t chunkLength = getChunkLength(command);
+        const std::size_t dataLength = command.getDataLength();
+
+        return dataLength <= chunkLength ? 1 : (dataLength + chunkLength - 1) / chunkLength;
+    }
+
+    /**
+     * Encodes one exchange of a command.
+     *
+     * @param command The command.
+     * @param exchangeIndex The index of the exchange, lower than getExchangeCount().
+     * @param output The buffer receiving the APDU, replacing its content.
+     * @throw std::invalid_argument If the index is out of range, or if the expected length needs
+     *        an extended-length APDU not supported by the reader.
+     * @since 2.1.0
+     */
+    void
+    encode(
+        const spi::ApduCommand& command,
+        const std::size_t exchangeIndex,
+        ApduCommandBuffer& output) const {
+        const std::size_t exchangeCount = getExchangeCount(command);
+        if (exchangeIndex >= exchangeCount) {
+            throw std::invalid_argument("Exchange index out of range");
+        }
+        const bool isLast = exchangeIndex == exchangeCount - 1;
+        const std::size_t offset = exchangeIndex * getChunkLength(command);
+        const std::size_t lc = isLast ? command.getDataLength() - offset : getChunkLength(command);
+        const int le = isLast ? command.getLe() : static_cast<int>(spi::ApduCommand::NO_LE);
+        const bool isExtended = lc > 255 || le > 256;
+        if (isExtended && !isExtendedLengthSupported()) {
+            throw std::invalid_argument("Extended length not supported by the reader");
+        }
+
+        const ByteSpan header = command.getHeader();
+        output.resize(0);
+        output.push_back(static_cast<uint8_t>(isLast ? header[0] : header[0] | CHAINING_BIT));
+        output.append(header.subspan(1, 3));
+        if (lc > 0) {
+            if (isExtended) {
+                output.push_back(0x00);
+                output.push_back(static_cast<uint8_t>(lc >> 8));
+            }
+            output.push_back(static_cast<uint8_t>(lc));
+            const std::size_t dataOffset = output.size();
+            output.resize(dataOffset + lc);
+            command.copyData(offset, lc, output.data() + dataOffset);
+        }
+        if (le != spi::ApduCommand::NO_LE) {
+            if (isExtended) {
+                if (lc == 0) {
+                    output.push_back(0x00);
+                }
+                output.push_back(static_cast<uint8_t>(le >> 8));
+            }
+            /* 256 and 65536 are encoded as zeros */
+            output.push_back(static_cast<uint8_t>(le));
+        }
+    }
+
+private:
+    /**
+     * ISO 7816-4 command chaining indicator in the CLA byte.
+     */
+    enum : uint8_t { CHAINING_BIT = 0x10 };
+
+    /**
+     * Gets the maximum length of the data field of one exchange of a command, so that the last
+     * exchange fits in the reader in the form its Le requires.
+     */
+    std::size_t
+    getChunkLength(const spi::ApduCommand& command) const {
+        if (!isExtendedLengthSupported()) {
+            return 255;
+        }
+        /* Header (4) + Lc (3) + Le (2) in the extended form */
+        const std::size_t extendedChunkLength = mMaxCommandLength - 9;
+        /* An Le above 256 only fits in the extended form */
+        if (command.getLe() > 256) {
+            return extendedChunkLength;
+        }
+
+        return extendedChunkLength > 255 ? extendedChunkLength : 255;
+    }
+
+    /**
+     *
+     */
+    std::size_t mMaxCommandLength;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,159 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "keypop/card/ApduBuffer.hpp"
+#include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/ByteSpan.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Default implementation of keypop::card::ApduResponseApi based on an inline APDU buffer.
+ *
+ * <p>Short APDU responses are stored inside the object, so that building a response does not
+ * allocate on the heap.
+ *
+ * <p>The <b>std::vector</b> returned by getApdu() is only built on the first call of this legacy
+ * accessor, once even if several threads call it concurrently. Callers on the hot path should use
+ * getApduView() and getDataOutView() instead. The const methods can be called concurrently;
+ * setApdu() and reset() must not be called while the instance is shared.
+ *
+ * @since 2.1.0
+ */
+class ApduResponseAdapter final : public ApduResponseApi {
+public:
+    /**
+     * Builds a new APDU response from the provided bytes.
+     *
+     * @param apdu The response bytes, including the status word (at least 2 bytes).
+     * @since 2.1.0
+     */
+    explicit ApduResponseAdapter(const ByteSpan apdu)
+    : mApdu(apdu)
+    , mIsLegacyApduBuilt(false) {
+    }
+
+    /**
+     * Builds an empty APDU response, to be filled with setApdu().
+     *
+     * @since 2.1.0
+     */
+    ApduResponseAdapter()
+    : mIsLegacyApduBuilt(false) {
+    }
+
+    /**
+     * Replaces the response bytes.
+     *
+     * @param apdu The response bytes, including the status word (at least 2 bytes).
+     * @since 2.1.0
+     */
+    void
+    setApdu(const ByteSpan apdu) {
+        mApdu.assign(apdu);
+        mIsLegacyApduBuilt.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * Restores the empty state, keeping the allocated storage for reuse (see
+     * keypop::card::SharedObjectPool).
+     *
+     * @since 2.1.0
+     */
+    void
+    reset() {
+        mApdu.clear();
+        mLegacyApdu.clear();
+        mIsLegacyApduBuilt.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The first call copies the response bytes into a new vector.
+     *
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t>&
+    getApdu() const override {
+        if (!mIsLegacyApduBuilt.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mLegacyApduMutex);
+            if (!mIsLegacyApduBuilt.load(std::memory_order_relaxed)) {
+                mLegacyApdu = mApdu.view().toVector();
+                mIsLegacyApduBuilt.store(true, std::memory_order_release);
+            }
+        }
+
+        return mLegacyApdu;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<uint8_t>
+    getDataOut() const override {
+        return getDataOutView().toVector();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    int
+    getStatusWord() const override {
+        const std::size_t size = mApdu.size();
+
+        return size < 2 ? 0 : (mApdu[size - 2] << 8) | mApdu[size - 1];
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ByteSpan
+    getApduView() const override {
+        return mApdu.view();
+    }
+
+private:
+    /**
+     *
+     */
+    ApduResponseBuffer mApdu;
+
+    /**
+     *
+     */
+    mutable std::vector<uint8_t> mLegacyApdu;
+
+    /**
+     *
+     */
+    mutable std::atomic<bool> mIsLegacyApduBuilt;
+
+    /**
+     * Guards the build of the legacy vector.
+     */
+    mutable std::mutex mLegacyApduMutex;
+};
+
+} /* namespace card */
+} /* namespace keypop */
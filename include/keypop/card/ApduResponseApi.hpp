@@ -14,6 +14,9 @@
 #include <ostream>
 #include <vector>
 
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/HexFormat.hpp"
+
 namespace keypop {
 namespace card {
 
@@ -27,6 +30,11 @@ namespace card {
  */
 class ApduResponseApi {
 public:
+    /**
+     * Virtual destructor.
+     */
+    virtual ~ApduResponseApi() = default;
+
     /**
      * Gets the raw data received from the card (including the status word).
      *
@@ -51,15 +59,49 @@ public:
      */
     virtual int getStatusWord() const = 0;
 
+    /**
+     * Gets a view over the raw data received from the card (including the status word), without
+     * copying it.
+     *
+     * <p>The default implementation refers to the storage returned by getApdu(). Implementations
+     * keeping the response bytes in another storage should override it.
+     *
+     * @return A view of at least 2 bytes, valid as long as this object is alive.
+     * @since 2.1.0
+     */
+    virtual ByteSpan
+    getApduView() const {
+        return ByteSpan(getApdu());
+    }
+
+    /**
+     * Gets a view over the data part of the response received from the card (excluding the status
+     * word), without copying it.
+     *
+     * <p>Unlike getDataOut(), this method does not allocate.
+     *
+     * @return A view, empty if the response only contains the status word.
+     * @since 2.1.0
+     */
+    virtual ByteSpan
+    getDataOutView() const {
+        const ByteSpan apdu = getApduView();
+        return apdu.first(apdu.size() >= 2 ? apdu.size() - 2 : 0);
+    }
+
     /**
      *
      */
     friend std::ostream&
     operator<<(std::ostream& os, const std::shared_ptr<ApduResponseApi> ara) {
-        os << "APDU_RESPONSE_API: {"
-           << "APDU = " << ara->getApdu() << ", "
-           << "DATA_OUT = " << ara->getDataOut() << ", "
-           << "STATUS_WORD = " << ara->getStatusWord() << "}";
+        if (ara == nullptr) {
+            os << "APDU_RESPONSE_API: null";
+        } else {
+            os << "APDU_RESPONSE_API: {"
+               << "APDU = " << HexFormat(ara->getApduView()) << ", "
+               << "DATA_OUT = " << HexFormat(ara->getDataOutView()) << ", "
+               << "STATUS_WORD = " << HexFormat(ara->getApduView().last(2)) << "}";
+        }
 
         return os;
     }
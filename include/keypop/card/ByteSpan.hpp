@@ -0,0 +1,235 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace keypop {
+namespace card {
+
+/**
+ * Non-owning read-only view over a contiguous sequence of bytes.
+ *
+ * <p>This is a C++11 compatible equivalent of <b>std::span&lt;const uint8_t&gt;</b>. It allows
+ * APDU data (command bytes, response data, status word) to be read in place without copying it
+ * into a new <b>std::vector</b>.
+ *
+ * <p>A view never owns the bytes it refers to: it is only valid as long as the underlying storage
+ * is alive and not modified in size.
+ *
+ * @since 2.1.0
+ */
+class ByteSpan final {
+public:
+    /**
+     * Builds an empty view.
+     *
+     * @since 2.1.0
+     */
+    constexpr ByteSpan() noexcept
+    : mData(nullptr)
+    , mSize(0) {
+    }
+
+    /**
+     * Builds a view over a raw byte array.
+     *
+     * @param data The first byte (may be null if size is 0).
+     * @param size The number of bytes.
+     * @since 2.1.0
+     */
+    constexpr ByteSpan(const uint8_t* data, const std::size_t size) noexcept
+    : mData(data)
+    , mSize(size) {
+    }
+
+    /**
+     * Builds a view over the whole content of a byte vector.
+     *
+     * @param bytes The referenced vector.
+     * @since 2.1.0
+     */
+    ByteSpan(const std::vector<uint8_t>& bytes) noexcept  // NOLINT(runtime/explicit)
+    : mData(bytes.data())
+    , mSize(bytes.size()) {
+    }
+
+    /**
+     * Gets a pointer to the first byte.
+     *
+     * @return Null if the view is empty and was not built from a storage.
+     * @since 2.1.0
+     */
+    constexpr const uint8_t*
+    data() const noexcept {
+        return mData;
+    }
+
+    /**
+     * Gets the number of bytes in the view.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    constexpr std::size_t
+    size() const noexcept {
+        return mSize;
+    }
+
+    /**
+     * Indicates if the view is empty.
+     *
+     * @return True if the view contains no bytes.
+     * @since 2.1.0
+     */
+    constexpr bool
+    empty() const noexcept {
+        return mSize == 0;
+    }
+
+    /**
+     * Gets the byte at the provided index (not checked).
+     *
+     * @param index The index, lower than size().
+     * @return The byte value.
+     * @since 2.1.0
+     */
+    constexpr uint8_t
+    operator[](const std::size_t index) const noexcept {
+        return mData[index];
+    }
+
+    /**
+     * @return An iterator to the first byte.
+     * @since 2.1.0
+     */
+    constexpr const uint8_t*
+    begin() const noexcept {
+        return mData;
+    }
+
+    /**
+     * @return An iterator past the last byte.
+     * @since 2.1.0
+     */
+    constexpr const uint8_t*
+    end() const noexcept {
+        return mData + mSize;
+    }
+
+    /**
+     * Gets a view over the first bytes.
+     *
+     * @param count The number of bytes, clamped to size().
+     * @return A view sharing the same storage.
+     * @since 2.1.0
+     */
+    constexpr ByteSpan
+    first(const std::size_t count) const noexcept {
+        return ByteSpan(mData, count < mSize ? count : mSize);
+    }
+
+    /**
+     * Gets a view over the last bytes.
+     *
+     * @param count The number of bytes, clamped to size().
+     * @return A view sharing the same storage.
+     * @since 2.1.0
+     */
+    constexpr ByteSpan
+    last(const std::size_t count) const noexcept {
+        return count < mSize ? ByteSpan(mData + (mSize - count), count) : *this;
+    }
+
+    /**
+     * Gets a view over a range of bytes.
+     *
+     * @param offset The index of the first byte, clamped to size().
+     * @param count The number of bytes, clamped to the remaining size.
+     * @return A view sharing the same storage.
+     * @since 2.1.0
+     */
+    constexpr ByteSpan
+    subspan(const std::size_t offset, const std::size_t count) const noexcept {
+        return offset < mSize ? ByteSpan(mData + offset, mSize - offset).first(count)
+                              : ByteSpan(end(), 0);
+    }
+
+    /**
+     * Copies the viewed bytes into a new vector.
+     *
+     * @return A new vector (allocation).
+     * @since 2.1.0
+     */
+    std::vector<uint8_t>
+    toVector() const {
+        return std::vector<uint8_t>(begin(), end());
+    }
+
+    /**
+     * Compares the content of two views.
+     *
+     * @since 2.1.0
+     */
+    friend bool
+    operator==(const ByteSpan& lhs, const ByteSpan& rhs) noexcept {
+        if (lhs.mSize != rhs.mSize) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < lhs.mSize; i++) {
+            if (lhs.mData[i] != rhs.mData[i]) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     *
+     */
+    friend bool
+    operator!=(const ByteSpan& lhs, const ByteSpan& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * Writes the viewed bytes as an uppercase hexadecimal string.
+     *
+     * @since 2.1.0
+     */
+    friend std::ostream&
+    operator<<(std::ostream& os, const ByteSpan& bytes) {
+        static const char digits[] = "0123456789ABCDEF";
+        for (const uint8_t b : bytes) {
+            os.put(digits[b >> 4]).put(digits[b & 0x0F]);
+        }
+
+        return os;
+    }
+
+private:
+    /**
+     *
+     */
+    const uint8_t* mData;
+
+    /**
+     *
+     */
+    std::size_t mSize;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -36,7 +36,7 @@ namespace card {
 // };
 
 // const std::string CardApiProperties::VERSION = "1.0";
-static const std::string& CardApiProperties_VERSION = "2.0";
+static const std::string& CardApiProperties_VERSION = "2.1";
 
 } /* namespace card */
 } /* namespace keypop */
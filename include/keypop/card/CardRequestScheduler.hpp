@@ -0,0 +1,480 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardTransmitResult.hpp"
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Dispatcher of card requests over a pool of keypop::card::ProxyReaderApi instances (e.g. a SAM
+ * farm), each reader being driven by its own worker thread.
+ *
+ * <p>A card request is submitted either for a given reader (affinity) or for any reader. Each
+ * worker has its own queue: a request for any reader is queued to an idle reader if there is one,
+ * and a worker running out of requests steals the requests for any reader queued to the others.
+ *
+ * <p>The channel control policy is honored across requests: once a request has been transmitted
+ * with keypop::card::ChannelControl::KEEP_OPEN, the reader is reserved to the requests submitted
+ * for it, so that a multi-request transaction is not interleaved with other ones. The reservation
+ * ends when the card response reports the logical channel closed (see
+ * keypop::card::CardResponseApi::isLogicalChannelOpen()): after a request transmitted with
+ * keypop::card::ChannelControl::CLOSE_AFTER, a communication failure or a timeout, or with
+ * releaseChannel(). The index of the reader which processed a request is provided in its
+ * keypop::card::CardRequestScheduler::Completion, so that a transaction may start on any reader
+ * and continue on the same one.
+ *
+ * <p>The requests are transmitted with keypop::card::ProxyReaderApi::tryTransmitCardRequest():
+ * the expected failures are reported in the result, other exceptions through the future.
+ *
+ * <p>This class is thread safe.
+ *
+ * @since 2.1.0
+ */
+class CardRequestScheduler final {
+public:
+    /**
+     * Outcome of a scheduled card request.
+     *
+     * @since 2.1.0
+     */
+    struct Completion {
+        /**
+         * Index of the reader which transmitted the request.
+         *
+         * @since 2.1.0
+         */
+        std::size_t readerIndex;
+
+        /**
+         * Result of the transmission.
+         *
+         * @since 2.1.0
+         */
+        CardTransmitResult result;
+    };
+
+    /**
+     * Builds a scheduler and starts one worker per reader.
+     *
+     * <p>The readers must not be used by other components while the scheduler is alive.
+     *
+     * @param readers The readers, identified by their index in the list (not empty).
+     * @throw std::invalid_argument If the list is empty or contains a null reader.
+     * @since 2.1.0
+     */
+    explicit CardRequestScheduler(const std::vector<std::shared_ptr<ProxyReaderApi>>& readers)
+    : mIsStopping(false)
+    , mNextWorkerIndex(0)
+    , mStolenCount(0) {
+        if (readers.empty()) {
+            throw std::invalid_argument("No reader to schedule");
+        }
+        for (const auto& reader : readers) {
+            if (reader == nullptr) {
+                throw std::invalid_argument("Null reader");
+            }
+            mWorkers.emplace_back(new Worker(mWorkers.size(), reader));
+        }
+        for (const auto& worker : mWorkers) {
+            worker->thread = std::thread(&CardRequestScheduler::run, this, std::ref(*worker));
+        }
+    }
+
+    /**
+     *
+     */
+    CardRequestScheduler(const CardRequestScheduler&) = delete;
+
+    /**
+     *
+     */
+    CardRequestScheduler& operator=(const CardRequestScheduler&) = delete;
+
+    /**
+     * Shuts down the scheduler (see shutdown()).
+     *
+     * @since 2.1.0
+     */
+    ~CardRequestScheduler() {
+        shutdown();
+    }
+
+    /**
+     * Submits a card request to be transmitted by any reader not reserved by a transaction.
+     *
+     * @param cardRequest The card request (not null).
+     * @param channelControl The channel control policy to apply.
+     * @return A future completed once the request has been processed.
+     * @throw std::logic_error If the scheduler is shut down.
+     * @since 2.1.0
+     */
+    std::future<Completion>
+    submit(
+        const std::shared_ptr<spi::CardRequestSpi>& cardRequest,
+        const ChannelControl channelControl) {
+        Job job(cardRequest, channelControl, false);
+        std::future<Completion> future = job.completion.get_future();
+
+        Worker& target = selectWorker();
+        push(target, std::move(job));
+
+        /* The target may be busy: poke an idle worker so that it steals the request */
+        for (const auto& worker : mWorkers) {
+            if (worker.get() != &target && worker->isIdle.load() && !worker->isChannelOpen.load()) {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                worker->isPoked = true;
+                worker->condition.notify_one();
+                break;
+            }
+        }
+
+        return future;
+    }
+
+    /**
+     * Submits a card request to be transmitted by a given reader.
+     *
+     * @param readerIndex The index of the reader.
+     * @param cardRequest The card request (not null).
+     * @param channelControl The channel control policy to apply.
+     * @return A future completed once the request has been processed.
+     * @throw std::invalid_argument If the reader does not exist.
+     * @throw std::logic_error If the scheduler is shut down.
+     * @since 2.1.0
+     */
+    std::future<Completion>
+    submit(
+        const std::size_t readerIndex,
+        const std::shared_ptr<spi::CardRequestSpi>& cardRequest,
+        const ChannelControl channelControl) {
+        Job job(cardRequest, channelControl, true);
+        std::future<Completion> future = job.completion.get_future();
+        push(getWorker(readerIndex), std::move(job));
+
+        return future;
+    }
+
+    /**
+     * Releases the channel of a given reader after the requests already submitted for it, ending
+     * its reservation.
+     *
+     * @param readerIndex The index of the reader.
+     * @return A future completed once the channel has been released, holding the exception thrown
+     *         by keypop::card::ProxyReaderApi::releaseChannel(), if any.
+     * @throw std::invalid_argument If the reader does not exist.
+     * @throw std::logic_error If the scheduler is shut down.
+     * @since 2.1.0
+     */
+    std::future<void>
+    releaseChannel(const std::size_t readerIndex) {
+        Job job(nullptr, ChannelControl::CLOSE_AFTER, true);
+        std::future<void> future = job.release.get_future();
+        push(getWorker(readerIndex), std::move(job));
+
+        return future;
+    }
+
+    /**
+     * Gets the number of readers.
+     *
+     * @return A strictly positive value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getReaderCount() const {
+        return mWorkers.size();
+    }
+
+    /**
+     * Gets the number of requests processed by another worker than the one they were queued to.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getStolenCount() const {
+        return mStolenCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Stops accepting requests, processes the requests already submitted (ignoring the
+     * reservations) and stops the workers.
+     *
+     * <p>This method blocks until the workers are stopped. It must not be called from a worker
+     * (e.g. from an observer of a card request).
+     *
+     * @since 2.1.0
+     */
+    void
+    shutdown() {
+        for (const auto& worker : mWorkers) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            mIsStopping.store(true);
+            worker->condition.notify_one();
+        }
+        for (const auto& worker : mWorkers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+    }
+
+private:
+    /**
+     * Card request, or channel release if the card request is null.
+     */
+    struct Job {
+        Job(const std::shared_ptr<spi::CardRequestSpi>& cardRequest,
+            const ChannelControl channelControl,
+            const bool isPinned)
+        : cardRequest(cardRequest)
+        , channelControl(channelControl)
+        , isPinned(isPinned) {
+        }
+
+        std::shared_ptr<spi::CardRequestSpi> cardRequest;
+        ChannelControl channelControl;
+        bool isPinned;
+        std::promise<Completion> completion;
+        std::promise<void> release;
+    };
+
+    /**
+     * Reader, its thread and its queue.
+     */
+    struct Worker {
+        Worker(const std::size_t index, const std::shared_ptr<ProxyReaderApi>& reader)
+        : index(index)
+        , reader(reader)
+        , isPoked(false)
+        , isIdle(false)
+        , isChannelOpen(false) {
+        }
+
+        const std::size_t index;
+        const std::shared_ptr<ProxyReaderApi> reader;
+        std::thread thread;
+
+        /* Guards the queue and the poke flag */
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<Job> jobs;
+        bool isPoked;
+
+        /* Written by the worker thread only */
+        std::atomic<bool> isIdle;
+        std::atomic<bool> isChannelOpen;
+    };
+
+    /**
+     *
+     */
+    Worker&
+    getWorker(const std::size_t readerIndex) {
+        if (readerIndex >= mWorkers.size()) {
+            throw std::invalid_argument("Unknown reader index");
+        }
+
+        return *mWorkers[readerIndex];
+    }
+
+    /**
+     * Selects the worker of a request for any reader: an idle one if possible, otherwise the next
+     * one not reserved by a transaction, in turn.
+     */
+    Worker&
+    selectWorker() {
+        const std::size_t start = mNextWorkerIndex.fetch_add(1) % mWorkers.size();
+        Worker* available = nullptr;
+        for (std::size_t i = 0; i < mWorkers.size(); i++) {
+            Worker& worker = *mWorkers[(start + i) % mWorkers.size()];
+            if (worker.isChannelOpen.load()) {
+                continue;
+            }
+            if (worker.isIdle.load()) {
+                return worker;
+            }
+            if (available == nullptr) {
+                available = &worker;
+            }
+        }
+
+        /* All the readers are reserved: the first one released will process the request */
+        return available != nullptr ? *available : *mWorkers[start];
+    }
+
+    /**
+     *
+     */
+    void
+    push(Worker& worker, Job&& job) {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (mIsStopping.load()) {
+            throw std::logic_error("Scheduler shut down");
+        }
+        worker.jobs.push_back(std::move(job));
+        worker.condition.notify_one();
+    }
+
+    /**
+     * Takes the first job of the worker's queue it may process, holding its lock.
+     */
+    static bool
+    takeOwnJob(Worker& worker, const bool isStopping, Job*& job) {
+        for (auto& queuedJob : worker.jobs) {
+            if (queuedJob.isPinned || !worker.isChannelOpen.load() || isStopping) {
+                job = &queuedJob;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Takes the last job for any reader queued to another worker.
+     */
+    bool
+    stealJob(Worker& thief, std::unique_ptr<Job>& job) {
+        for (std::size_t i = 1; i < mWorkers.size(); i++) {
+            Worker& victim = *mWorkers[(thief.index + i) % mWorkers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            for (auto it = victim.jobs.rbegin(); it != victim.jobs.rend(); ++it) {
+                if (!it->isPinned) {
+                    job.reset(new Job(std::move(*it)));
+                    victim.jobs.erase(std::next(it).base());
+                    mStolenCount.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Takes the next job of a worker, waiting if needed.
+     *
+     * @return False if the worker must stop.
+     */
+    bool
+    nextJob(Worker& worker, std::unique_ptr<Job>& job) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                Job* ownJob = nullptr;
+                if (takeOwnJob(worker, mIsStopping.load(), ownJob)) {
+                    job.reset(new Job(std::move(*ownJob)));
+                    for (auto it = worker.jobs.begin(); it != worker.jobs.end(); ++it) {
+                        if (&*it == ownJob) {
+                            worker.jobs.erase(it);
+                            break;
+                        }
+                    }
+                    return true;
+                }
+                if (mIsStopping.load()) {
+                    return false;
+                }
+            }
+
+            /* Declared idle before looking for jobs to steal, so that a request queued to
+             * another worker in the meantime is followed by a poke */
+            worker.isIdle.store(true);
+            if (!worker.isChannelOpen.load() && stealJob(worker, job)) {
+                worker.isIdle.store(false);
+                return true;
+            }
+
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            Job* ownJob = nullptr;
+            worker.condition.wait(lock, [this, &worker, &ownJob]() {
+                return worker.isPoked || mIsStopping.load()
+                       || takeOwnJob(worker, false, ownJob);
+            });
+            worker.isPoked = false;
+            worker.isIdle.store(false);
+        }
+    }
+
+    /**
+     *
+     */
+    void
+    run(Worker& worker) {
+        std::unique_ptr<Job> job;
+        while (nextJob(worker, job)) {
+            if (job->cardRequest == nullptr) {
+                try {
+                    worker.reader->releaseChannel();
+                    worker.isChannelOpen.store(false);
+                    job->release.set_value();
+                } catch (...) {
+                    worker.isChannelOpen.store(false);
+                    job->release.set_exception(std::current_exception());
+                }
+                continue;
+            }
+            try {
+                const CardTransmitResult result
+                    = worker.reader->tryTransmitCardRequest(job->cardRequest, job->channelControl);
+                /* The reader stays reserved as long as it reports its channel open */
+                const std::shared_ptr<CardResponseApi>& cardResponse = result.getCardResponse();
+                worker.isChannelOpen.store(
+                    cardResponse != nullptr && cardResponse->isLogicalChannelOpen());
+                job->completion.set_value(Completion{worker.index, result});
+            } catch (...) {
+                job->completion.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    /**
+     *
+     */
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+
+    /**
+     *
+     */
+    std::atomic<bool> mIsStopping;
+
+    /**
+     *
+     */
+    std::atomic<std::size_t> mNextWorkerIndex;
+
+    /**
+     *
+     */
+    std::atomic<std::size_t> mStolenCount;
+};
+
+} /* namespace card */
+} /* namespace keypop */
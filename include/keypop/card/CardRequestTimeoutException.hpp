@@ -0,0 +1,69 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "keypop/card/AbstractApduException.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Exception carrying response data received from the card until the deadline of the card request
+ * or the timeout of an APDU expired (see keypop::card::spi::CardRequestSpi::getDeadline() and
+ * keypop::card::spi::CardRequestSpi::getApduTimeout()).
+ *
+ * <p>The remaining APDUs were not sent.
+ *
+ * @since 2.1.0
+ */
+class CardRequestTimeoutException final : public AbstractApduException {
+public:
+    /**
+     * Builds a new exception embedding card response data.
+     *
+     * @param cardResponseApi The card responses received so far.
+     * @param isCardResponseComplete True if the number responses equals the number of requests
+     *        present in the original keypop::card::spi::CardRequestSpi.
+     * @param message Message to identify the exception context.
+     * @since 2.1.0
+     */
+    CardRequestTimeoutException(
+        const std::shared_ptr<CardResponseApi> cardResponseApi,
+        const bool isCardResponseComplete,
+        const std::string& message)
+    : AbstractApduException(cardResponseApi, isCardResponseComplete, message) {
+    }
+
+    /**
+     * Builds a new exception embedding card response data with the originating exception.
+     *
+     * @param cardResponseApi The card responses received so far.
+     * @param isCardResponseComplete True if the number responses equals the number of requests
+     *        present in the original keypop::card::spi::CardRequestSpi.
+     * @param message Message to identify the exception context.
+     * @param cause The cause
+     * @since 2.1.0
+     */
+    CardRequestTimeoutException(
+        const std::shared_ptr<CardResponseApi> cardResponseApi,
+        const bool isCardResponseComplete,
+        const std::string& message,
+        const std::shared_ptr<std::exception> cause)
+    : AbstractApduException(cardResponseApi, isCardResponseComplete, message, cause) {
+    }
+};
+
+} /* namespace card */
+} /* namespace keypop */
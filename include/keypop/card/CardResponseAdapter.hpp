@@ -0,0 +1,255 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Default implementation of keypop::card::CardResponseApi, filled incrementally by the reader.
+ *
+ * <p>The summary of the responses (see getSummary()) is updated as the reader adds them, and the
+ * classification and request index reported by the reader for each response are kept.
+ *
+ * <p>It complies with the reset contract of keypop::card::SharedObjectPool so that instances can
+ * be recycled from one transmission to the next (see keypop::card::SimulatedProxyReader).
+ *
+ * @since 2.1.0
+ */
+class CardResponseAdapter final : public CardResponseApi {
+public:
+    /**
+     * Builds an empty card response.
+     *
+     * @param expectedApduResponseCount The number of APDU responses to reserve room for.
+     * @since 2.1.0
+     */
+    explicit CardResponseAdapter(const std::size_t expectedApduResponseCount = 0)
+    : mIsLogicalChannelOpen(false) {
+        mApduResponses.reserve(expectedApduResponseCount);
+        mApduResponseInfos.reserve(expectedApduResponseCount);
+    }
+
+    /**
+     * Adds an APDU response at the end of the list.
+     *
+     * @param apduResponse The APDU response (not null).
+     * @since 2.1.0
+     */
+    void
+    addApduResponse(const std::shared_ptr<ApduResponseApi>& apduResponse) {
+        mApduResponses.push_back(apduResponse);
+    }
+
+    /**
+     * Adds an APDU response at the end of the list, indicating if its status word is successful
+     * for its request, the request having the index of the response.
+     *
+     * @param apduResponse The APDU response (not null).
+     * @param isSuccessful True if the status word belongs to the successful status words of the
+     *        request.
+     * @since 2.1.0
+     */
+    void
+    addApduResponse(const std::shared_ptr<ApduResponseApi>& apduResponse, const bool isSuccessful) {
+        addApduResponse(apduResponse, isSuccessful, mApduResponses.size());
+    }
+
+    /**
+     * Adds an APDU response at the end of the list, indicating if its status word is successful
+     * for its request and the index of this request.
+     *
+     * @param apduResponse The APDU response (not null).
+     * @param isSuccessful True if the status word belongs to the successful status words of the
+     *        request (or if the response is handled by a keypop::card::spi::ApduChainingSpi).
+     * @param apduRequestIndex The index of the request in the card request, the one starting the
+     *        chain for a chained request (see getApduRequestIndex()).
+     * @since 2.1.0
+     */
+    void
+    addApduResponse(
+        const std::shared_ptr<ApduResponseApi>& apduResponse,
+        const bool isSuccessful,
+        const std::size_t apduRequestIndex) {
+        summarize(mSummary, mApduResponses.size());
+        for (std::size_t i = mApduResponseInfos.size(); i < mApduResponses.size(); i++) {
+            mApduResponseInfos.push_back({i, mApduResponses[i]->getStatusWord() == 0x9000});
+        }
+        mApduResponses.push_back(apduResponse);
+        mApduResponseInfos.push_back({apduRequestIndex, isSuccessful});
+        mSummary.add(
+            apduResponse->getStatusWord(), apduResponse->getApduView().size(), isSuccessful);
+    }
+
+    /**
+     * Sets the state of the logical channel following the execution of the request.
+     *
+     * @param isLogicalChannelOpen True if the logical channel is open.
+     * @since 2.1.0
+     */
+    void
+    setLogicalChannelOpen(const bool isLogicalChannelOpen) {
+        mIsLogicalChannelOpen = isLogicalChannelOpen;
+    }
+
+    /**
+     * Restores the empty state, keeping the capacity of the list and releasing the references to
+     * the APDU responses (which may then return to their own pool).
+     *
+     * @since 2.1.0
+     */
+    void
+    reset() {
+        mApduResponses.clear();
+        mApduResponseInfos.clear();
+        mIsLogicalChannelOpen = false;
+        mSummary.reset();
+    }
+
+    /**
+     * Reserves room for the provided number of APDU responses, e.g. when a recycled instance is
+     * reused for a larger request.
+     *
+     * @param expectedApduResponseCount The number of APDU responses to reserve room for.
+     * @since 2.1.0
+     */
+    void
+    reserve(const std::size_t expectedApduResponseCount) {
+        mApduResponses.reserve(expectedApduResponseCount);
+        mApduResponseInfos.reserve(expectedApduResponseCount);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<ApduResponseApi>>&
+    getApduResponses() const override {
+        return mApduResponses;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool
+    isLogicalChannelOpen() const override {
+        return mIsLogicalChannelOpen;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>Returns the classification provided to addApduResponse(), 9000h being the only
+     * successful status word of the responses added without it.
+     *
+     * @since 2.1.0
+     */
+    bool
+    isApduResponseSuccessful(const std::size_t index) const override {
+        const ApduResponseInfo* const info = getApduResponseInfo(index);
+
+        return info != nullptr ? info->isSuccessful
+                               : mApduResponses[index]->getStatusWord() == 0x9000;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>Returns the index provided to addApduResponse(), or the index of the response if it was
+     * added without it.
+     *
+     * @since 2.1.0
+     */
+    std::size_t
+    getApduRequestIndex(const std::size_t index) const override {
+        const ApduResponseInfo* const info = getApduResponseInfo(index);
+
+        return info != nullptr ? info->apduRequestIndex : index;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The summary is maintained as the responses are added with their successful flag: these
+     * responses are not accessed again. The responses added without it are classified on demand,
+     * 9000h being their only successful status word.
+     *
+     * @since 2.1.0
+     */
+    CardResponseSummary
+    getSummary() const override {
+        CardResponseSummary summary(mSummary);
+        summarize(summary, mApduResponses.size());
+
+        return summary;
+    }
+
+private:
+    /**
+     * Classification of a response provided by the reader.
+     */
+    struct ApduResponseInfo {
+        std::size_t apduRequestIndex;
+        bool isSuccessful;
+    };
+
+    /**
+     * Gets the classification of a response, null if it was added without it (the classification
+     * of the responses added before a classified one being filled in at that time).
+     */
+    const ApduResponseInfo*
+    getApduResponseInfo(const std::size_t index) const {
+        return index < mApduResponseInfos.size() ? &mApduResponseInfos[index] : nullptr;
+    }
+
+    /**
+     * Accounts in a summary the responses it does not cover yet, up to the provided count.
+     */
+    void
+    summarize(CardResponseSummary& summary, const std::size_t responseCount) const {
+        for (std::size_t i = summary.getResponseCount(); i < responseCount; i++) {
+            const int statusWord = mApduResponses[i]->getStatusWord();
+            summary.add(statusWord, mApduResponses[i]->getApduView().size(), statusWord == 0x9000);
+        }
+    }
+
+    /**
+     *
+     */
+    std::vector<std::shared_ptr<ApduResponseApi>> mApduResponses;
+
+    /**
+     * Classification of the responses, up to the last one added with it.
+     */
+    std::vector<ApduResponseInfo> mApduResponseInfos;
+
+    /**
+     *
+     */
+    bool mIsLogicalChannelOpen;
+
+    /**
+     *
+     */
+    CardResponseSummary mSummary;
+};
+
+} /* namespace card */
+} /* namespace keypop */
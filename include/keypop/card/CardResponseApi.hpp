@@ -9,11 +9,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <ostream>
 #include <vector>
 
 #include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/CardResponseSummary.hpp"
 
 namespace keypop {
 namespace card {
@@ -59,6 +61,64 @@ public:
      */
     virtual bool isLogicalChannelOpen() const = 0;
 
+    /**
+     * Indicates whether an APDU response is successful for its request, as classified by the
+     * reader.
+     *
+     * <p>The default implementation checks that the status word is 9000h. Implementations filled by
+     * a reader should keep the classification of the reader (see
+     * keypop::card::CardResponseAdapter).
+     *
+     * @param index The index of the response in getApduResponses().
+     * @return True if the status word is successful for the request.
+     * @since 2.1.0
+     */
+    virtual bool
+    isApduResponseSuccessful(const std::size_t index) const {
+        return getApduResponses()[index]->getStatusWord() == 0x9000;
+    }
+
+    /**
+     * Gets the index of the APDU request answered by an APDU response.
+     *
+     * <p>The responses to the requests generated by a keypop::card::spi::ApduChainingSpi have the
+     * index of the request starting the chain, the one notified to the
+     * keypop::card::spi::ApduResponseObserverSpi. The default implementation assumes one response
+     * per request and returns the index of the response.
+     *
+     * @param index The index of the response in getApduResponses().
+     * @return An index in keypop::card::spi::CardRequestSpi::getApduRequests().
+     * @since 2.1.0
+     */
+    virtual std::size_t
+    getApduRequestIndex(const std::size_t index) const {
+        return index;
+    }
+
+    /**
+     * Gets the classification of the status words of the responses.
+     *
+     * <p>The default implementation scans the responses at each call, using
+     * isApduResponseSuccessful(). Implementations filled by a reader should maintain it as the
+     * responses are added (see keypop::card::CardResponseAdapter).
+     *
+     * @return A summary of getApduResponses().
+     * @since 2.1.0
+     */
+    virtual CardResponseSummary
+    getSummary() const {
+        const std::vector<std::shared_ptr<ApduResponseApi>>& apduResponses = getApduResponses();
+        CardResponseSummary summary;
+        for (std::size_t i = 0; i < apduResponses.size(); i++) {
+            summary.add(
+                apduResponses[i]->getStatusWord(),
+                apduResponses[i]->getApduView().size(),
+                isApduResponseSuccessful(i));
+        }
+
+        return summary;
+    }
+
     /**
      *
      */
@@ -69,8 +129,7 @@ public:
         if (cra == nullptr) {
             os << "null";
         } else {
-            os << "CARD_RESPONSE_API: {"
-               << "IS_LOGICAL_CHANNEL_OPEN = " << cra->isLogicalChannelOpen() << ", "
+            os << "IS_LOGICAL_CHANNEL_OPEN = " << cra->isLogicalChannelOpen() << ", "
                << "APDU_RESPONSES = {" << cra->getApduResponses() << "}";
         }
 
@@ -0,0 +1,265 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+namespace keypop {
+namespace card {
+
+/**
+ * Classification of the status words of the responses of a keypop::card::CardResponseApi,
+ * computed once as the responses are received.
+ *
+ * <p>Post-processing then consists in reading a few fields, instead of calling
+ * keypop::card::ApduResponseApi::getStatusWord() on each response (see
+ * keypop::card::CardResponseApi::getSummary()).
+ *
+ * <p>A response is successful if its status word belongs to the successful status words of its
+ * request, when the reader provides this information (see
+ * keypop::card::CardResponseAdapter::addApduResponse()), otherwise if it is 9000h.
+ *
+ * @since 2.1.0
+ */
+class CardResponseSummary final {
+public:
+    /**
+     * Index returned when no response matches.
+     *
+     * @since 2.1.0
+     */
+    enum : std::size_t { NO_INDEX = static_cast<std::size_t>(-1) };
+
+    /**
+     * Classes of status words defined by ISO 7816-4.
+     *
+     * @since 2.1.0
+     */
+    enum class StatusWordClass {
+        /**
+         * Normal processing: 9000h and 61XXh.
+         *
+         * @since 2.1.0
+         */
+        NORMAL,
+
+        /**
+         * Warning processing: 62XXh and 63XXh.
+         *
+         * @since 2.1.0
+         */
+        WARNING,
+
+        /**
+         * Execution error: 64XXh to 66XXh.
+         *
+         * @since 2.1.0
+         */
+        EXECUTION_ERROR,
+
+        /**
+         * Checking error: 67XXh to 6FXXh.
+         *
+         * @since 2.1.0
+         */
+        CHECKING_ERROR,
+
+        /**
+         * Any other value (e.g. proprietary 9XXXh).
+         *
+         * @since 2.1.0
+         */
+        PROPRIETARY
+    };
+
+    /**
+     * Builds the summary of an empty response.
+     *
+     * @since 2.1.0
+     */
+    CardResponseSummary() {
+        reset();
+    }
+
+    /**
+     * Gets the class of a status word.
+     *
+     * @param statusWord The status word.
+     * @return The class.
+     * @since 2.1.0
+     */
+    static StatusWordClass
+    classify(const int statusWord) {
+        const int sw1 = statusWord >> 8;
+        if (statusWord == 0x9000 || sw1 == 0x61) {
+            return StatusWordClass::NORMAL;
+        }
+        if (sw1 == 0x62 || sw1 == 0x63) {
+            return StatusWordClass::WARNING;
+        }
+        if (sw1 >= 0x64 && sw1 <= 0x66) {
+            return StatusWordClass::EXECUTION_ERROR;
+        }
+        if (sw1 >= 0x67 && sw1 <= 0x6F) {
+            return StatusWordClass::CHECKING_ERROR;
+        }
+
+        return StatusWordClass::PROPRIETARY;
+    }
+
+    /**
+     * Accounts a response appended to the card response.
+     *
+     * @param statusWord The status word of the response.
+     * @param length The number of bytes of the response, status word included.
+     * @param isSuccessful True if the status word is successful for its request.
+     * @since 2.1.0
+     */
+    void
+    add(const int statusWord, const std::size_t length, const bool isSuccessful) {
+        const std::size_t statusWordClass = static_cast<std::size_t>(classify(statusWord));
+        if (mFirstIndexes[statusWordClass] == NO_INDEX) {
+            mFirstIndexes[statusWordClass] = mResponseCount;
+        }
+        mCounts[statusWordClass]++;
+        if (isSuccessful) {
+            mSuccessfulCount++;
+        } else if (mFirstUnsuccessfulIndex == NO_INDEX) {
+            mFirstUnsuccessfulIndex = mResponseCount;
+        }
+        mTotalLength += length;
+        mResponseCount++;
+    }
+
+    /**
+     * Restores the summary of an empty response.
+     *
+     * @since 2.1.0
+     */
+    void
+    reset() {
+        mResponseCount = 0;
+        mSuccessfulCount = 0;
+        mFirstUnsuccessfulIndex = NO_INDEX;
+        mTotalLength = 0;
+        for (std::size_t i = 0; i < CLASS_COUNT; i++) {
+            mCounts[i] = 0;
+            mFirstIndexes[i] = NO_INDEX;
+        }
+    }
+
+    /**
+     * Gets the number of responses.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getResponseCount() const {
+        return mResponseCount;
+    }
+
+    /**
+     * Indicates if all the responses are successful.
+     *
+     * @return True if all the responses are successful (including if there is none).
+     * @since 2.1.0
+     */
+    bool
+    isAllSuccessful() const {
+        return mSuccessfulCount == mResponseCount;
+    }
+
+    /**
+     * Gets the index of the first unsuccessful response.
+     *
+     * @return NO_INDEX if all the responses are successful.
+     * @since 2.1.0
+     */
+    std::size_t
+    getFirstUnsuccessfulIndex() const {
+        return mFirstUnsuccessfulIndex;
+    }
+
+    /**
+     * Gets the number of responses whose status word belongs to a class.
+     *
+     * @param statusWordClass The class.
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getCount(const StatusWordClass statusWordClass) const {
+        return mCounts[static_cast<std::size_t>(statusWordClass)];
+    }
+
+    /**
+     * Gets the index of the first response whose status word belongs to a class (e.g. the first
+     * warning).
+     *
+     * @param statusWordClass The class.
+     * @return NO_INDEX if there is no such response.
+     * @since 2.1.0
+     */
+    std::size_t
+    getFirstIndex(const StatusWordClass statusWordClass) const {
+        return mFirstIndexes[static_cast<std::size_t>(statusWordClass)];
+    }
+
+    /**
+     * Gets the number of bytes of all the responses, status words included.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getTotalLength() const {
+        return mTotalLength;
+    }
+
+private:
+    /**
+     *
+     */
+    enum : std::size_t { CLASS_COUNT = 5 };
+
+    /**
+     *
+     */
+    std::size_t mResponseCount;
+
+    /**
+     *
+     */
+    std::size_t mSuccessfulCount;
+
+    /**
+     *
+     */
+    std::size_t mFirstUnsuccessfulIndex;
+
+    /**
+     *
+     */
+    std::size_t mTotalLength;
+
+    /**
+     * Indexed by StatusWordClass.
+     */
+    std::size_t mCounts[CLASS_COUNT];
+
+    /**
+     * Indexed by StatusWordClass.
+     */
+    std::size_t mFirstIndexes[CLASS_COUNT];
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,260 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardSelectionProcessorApi.hpp"
+#include "keypop/card/CardSelectionResponseAdapter.hpp"
+#include "keypop/card/CardSelectionScenario.hpp"
+#include "keypop/card/CardTransmitResult.hpp"
+#include "keypop/card/CardTransmitStatus.hpp"
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/MultiSelectionProcessing.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+#include "keypop/card/spi/CardSelectionRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Reference implementation of keypop::card::CardSelectionProcessorApi on top of any
+ * keypop::card::ProxyReaderApi.
+ *
+ * <p>For each candidate, the <b>Select Application</b> command built from the selection data of
+ * the keypop::card::spi::CardSelectionRequestSpi (AID, file occurrence, file control information)
+ * is transmitted, the channel being kept open. The candidate matches if the status word belongs to
+ * its successful selection status words; a candidate without AID matches without any exchange.
+ * The card request of a matching candidate, if any, is then transmitted. The channel is released
+ * once, after the last processed candidate or when the processing fails, if the scenario requires
+ * it.
+ *
+ * <p>The power-on data is not available through keypop::card::ProxyReaderApi and is reported as an
+ * empty string.
+ *
+ * @since 2.1.0
+ */
+class CardSelectionProcessor final : public CardSelectionProcessorApi {
+public:
+    /**
+     * Builds a new processor transmitting through the provided reader.
+     *
+     * @param reader The reader.
+     * @throw std::invalid_argument If the reader is null.
+     * @since 2.1.0
+     */
+    explicit CardSelectionProcessor(const std::shared_ptr<ProxyReaderApi>& reader)
+    : mReader(reader) {
+        if (reader == nullptr) {
+            throw std::invalid_argument("Null reader");
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>A card request ending with an unexpected status word is reported with its partial
+     * response; any other transmission failure is thrown as by
+     * keypop::card::ProxyReaderApi::transmitCardRequest(), after the release of the channel if the
+     * scenario requires it.
+     *
+     * @throw std::invalid_argument If the scenario is null or an AID is longer than 16 bytes.
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<CardSelectionResponseApi>>
+    processCardSelectionScenario(
+        const std::shared_ptr<CardSelectionScenario> cardSelectionScenario) override {
+        if (cardSelectionScenario == nullptr) {
+            throw std::invalid_argument("Null card selection scenario");
+        }
+
+        const std::vector<std::shared_ptr<spi::CardSelectionRequestSpi>>& cardSelectionRequests
+            = cardSelectionScenario->getCardSelectionRequests();
+        std::vector<std::shared_ptr<CardSelectionResponseApi>> cardSelectionResponses;
+        cardSelectionResponses.reserve(cardSelectionRequests.size());
+
+        const bool isChannelToRelease
+            = cardSelectionScenario->getChannelControl() == ChannelControl::CLOSE_AFTER;
+        try {
+            for (const std::shared_ptr<spi::CardSelectionRequestSpi>& cardSelectionRequest :
+                 cardSelectionRequests) {
+                const std::shared_ptr<CardSelectionResponseApi> cardSelectionResponse
+                    = processCardSelectionRequest(*cardSelectionRequest);
+                cardSelectionResponses.push_back(cardSelectionResponse);
+
+                if (cardSelectionResponse->hasMatched()
+                    && cardSelectionScenario->getMultiSelectionProcessing()
+                           == MultiSelectionProcessing::FIRST_MATCH) {
+                    break;
+                }
+            }
+        } catch (...) {
+            if (isChannelToRelease) {
+                try {
+                    mReader->releaseChannel();
+                } catch (...) {
+                    /* The failure of the scenario is reported instead */
+                }
+            }
+            throw;
+        }
+
+        if (isChannelToRelease) {
+            mReader->releaseChannel();
+        }
+
+        return cardSelectionResponses;
+    }
+
+private:
+    /**
+     * Maximum length of an AID (ISO 7816-4).
+     */
+    enum : std::size_t { MAX_AID_LENGTH = 16 };
+
+    /**
+     *
+     */
+    const std::shared_ptr<ProxyReaderApi> mReader;
+
+    /**
+     * Processes one candidate, the channel being kept open.
+     */
+    std::shared_ptr<CardSelectionResponseApi>
+    processCardSelectionRequest(const spi::CardSelectionRequestSpi& cardSelectionRequest) {
+        std::shared_ptr<ApduResponseApi> selectApplicationResponse;
+        bool hasMatched = true;
+
+        const ByteSpan aid = cardSelectionRequest.getAid();
+        if (!aid.empty()) {
+            const std::shared_ptr<const StatusWordSet> successfulSelectionStatusWords
+                = cardSelectionRequest.getSuccessfulSelectionStatusWordSet();
+            const std::shared_ptr<spi::CardRequestAdapter> selectCardRequest
+                = std::make_shared<spi::CardRequestAdapter>(false, 1);
+            selectCardRequest->addApduRequest(createSelectApplicationRequest(
+                cardSelectionRequest, successfulSelectionStatusWords));
+
+            const std::shared_ptr<CardResponseApi> selectCardResponse = transmit(selectCardRequest);
+            selectApplicationResponse = selectCardResponse->getApduResponses()[0];
+            /* Not all readers classify the responses with the status words of the request */
+            hasMatched = successfulSelectionStatusWords->contains(
+                selectApplicationResponse->getStatusWord());
+        }
+
+        std::shared_ptr<CardResponseApi> cardResponse;
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest
+            = cardSelectionRequest.getCardRequest();
+        if (hasMatched && cardRequest != nullptr) {
+            cardResponse = transmit(cardRequest);
+        }
+
+        return std::make_shared<CardSelectionResponseAdapter>(
+            "", selectApplicationResponse, hasMatched, cardResponse);
+    }
+
+    /**
+     * Transmits a request, keeping the channel open and reporting an unexpected status word with
+     * the partial response.
+     */
+    std::shared_ptr<CardResponseApi>
+    transmit(const std::shared_ptr<spi::CardRequestSpi>& cardRequest) {
+        const CardTransmitResult result
+            = mReader->tryTransmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+        if (result.getStatus() != CardTransmitStatus::UNEXPECTED_STATUS_WORD) {
+            result.throwIfUnsuccessful();
+        }
+
+        return result.getCardResponse();
+    }
+
+    /**
+     * Builds the <b>Select Application</b> command (ISO 7816-4, INS A4h, P1 04h) of a candidate.
+     */
+    static std::shared_ptr<spi::ApduRequestSpi>
+    createSelectApplicationRequest(
+        const spi::CardSelectionRequestSpi& cardSelectionRequest,
+        const std::shared_ptr<const StatusWordSet>& successfulSelectionStatusWords) {
+        const ByteSpan aid = cardSelectionRequest.getAid();
+        if (aid.size() > MAX_AID_LENGTH) {
+            throw std::invalid_argument("AID too long");
+        }
+
+        const uint8_t p2 = getP2(cardSelectionRequest);
+        uint8_t apdu[5 + MAX_AID_LENGTH + 1]
+            = {0x00, 0xA4, 0x04, p2, static_cast<uint8_t>(aid.size())};
+        for (std::size_t i = 0; i < aid.size(); ++i) {
+            apdu[5 + i] = aid[i];
+        }
+        std::size_t apduLength = 5 + aid.size();
+        if ((p2 & 0x0C) != 0x0C) {
+            /* Le = 00h, any data available is expected. Without response data, the command is a
+             * case 3 command, having no Le. */
+            apdu[apduLength++] = 0x00;
+        }
+
+        const std::shared_ptr<spi::ApduRequestAdapter> apduRequest
+            = std::make_shared<spi::ApduRequestAdapter>(ByteSpan(apdu, apduLength));
+        apduRequest->setSuccessfulStatusWords(successfulSelectionStatusWords)
+            .setInfo("Select Application");
+
+        return apduRequest;
+    }
+
+    /**
+     * Encodes the file occurrence (b2-b1) and the file control information (b4-b3) in P2.
+     */
+    static uint8_t
+    getP2(const spi::CardSelectionRequestSpi& cardSelectionRequest) {
+        uint8_t p2 = 0x00;
+
+        switch (cardSelectionRequest.getFileOccurrence()) {
+        case spi::CardSelectionRequestSpi::FileOccurrence::FIRST:
+            break;
+        case spi::CardSelectionRequestSpi::FileOccurrence::LAST:
+            p2 |= 0x01;
+            break;
+        case spi::CardSelectionRequestSpi::FileOccurrence::NEXT:
+            p2 |= 0x02;
+            break;
+        case spi::CardSelectionRequestSpi::FileOccurrence::PREVIOUS:
+            p2 |= 0x03;
+            break;
+        }
+
+        switch (cardSelectionRequest.getFileControlInformation()) {
+        case spi::CardSelectionRequestSpi::FileControlInformation::FCI:
+            break;
+        case spi::CardSelectionRequestSpi::FileControlInformation::FCP:
+            p2 |= 0x04;
+            break;
+        case spi::CardSelectionRequestSpi::FileControlInformation::FMD:
+            p2 |= 0x08;
+            break;
+        case spi::CardSelectionRequestSpi::FileControlInformation::NO_RESPONSE:
+            p2 |= 0x0C;
+            break;
+        }
+
+        return p2;
+    }
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,63 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "keypop/card/CardSelectionResponse.hpp"
+#include "keypop/card/CardSelectionScenario.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Reader able to process a whole card selection scenario in a single call.
+ *
+ * <p>An adapter of keypop::card::ProxyReaderApi may also implement this interface. To use it,
+ * simply cast a <b>ProxyReaderApi</b> as a <b>CardSelectionProcessorApi</b>.
+ *
+ * @since 2.1.0
+ */
+class CardSelectionProcessorApi {
+public:
+    /**
+     * Virtual destructor.
+     */
+    virtual ~CardSelectionProcessorApi() = default;
+
+    /**
+     * Processes the selection requests of the provided scenario and returns the aggregated
+     * results.
+     *
+     * <p>The list contains one keypop::card::CardSelectionResponseApi per processed request, in
+     * the order of the scenario. With keypop::card::MultiSelectionProcessing::FIRST_MATCH, the
+     * processing stops at the first matching request, which is then the last element of the list.
+     *
+     * <p>The reader is free to optimize the processing as long as the results are the same, for
+     * example by pipelining the selection commands, or by reporting as not matching, without any
+     * exchange, a candidate that already failed for the card currently present.
+     *
+     * <p>The channel control policy of the scenario is applied once, after the last processed
+     * request.
+     *
+     * @param cardSelectionScenario The scenario to process.
+     * @return A not null list, empty if no request was processed.
+     * @throw ReaderBrokenCommunicationException If the communication with the reader has failed.
+     * @throw CardBrokenCommunicationException If the communication with the card has failed.
+     * @since 2.1.0
+     */
+    virtual const std::vector<std::shared_ptr<CardSelectionResponseApi>>
+    processCardSelectionScenario(const std::shared_ptr<CardSelectionScenario> cardSelectionScenario)
+        = 0;
+};
+
+} /* namespace card */
+} /* namespace keypop */
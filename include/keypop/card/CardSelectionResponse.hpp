@@ -87,9 +87,16 @@ public:
      */
     friend std::ostream&
     operator<<(std::ostream& os, const std::shared_ptr<CardSelectionResponseApi> csr) {
+        if (csr == nullptr) {
+            os << "CARD_SELECTION_RESPONSE_API: null";
+            return os;
+        }
+
         os << "CARD_SELECTION_RESPONSE_API: {"
-           << "HAS_MATCHED: " << csr->hasMatched() << "<TODO>"
-           << "}";
+           << "POWER_ON_DATA: " << csr->getPowerOnData() << ", "
+           << "SELECT_APPLICATION_RESPONSE: " << csr->getSelectApplicationResponse() << ", "
+           << "HAS_MATCHED: " << csr->hasMatched() << ", "
+           << "CARD_RESPONSE: " << csr->getCardResponse() << "}";
 
         return os;
     }
@@ -0,0 +1,116 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardSelectionResponse.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Default implementation of keypop::card::CardSelectionResponseApi.
+ *
+ * @see keypop::card::CardSelectionProcessor
+ * @since 2.1.0
+ */
+class CardSelectionResponseAdapter final : public CardSelectionResponseApi {
+public:
+    /**
+     * Builds a new selection response.
+     *
+     * @param powerOnData The power-on data of the card.
+     * @param selectApplicationResponse The response to the <b>Select Application</b> command (null
+     *        if none was sent).
+     * @param hasMatched True if the card matches the selection request.
+     * @param cardResponse The responses to the card request of the selection request (null if
+     *        none was executed).
+     * @since 2.1.0
+     */
+    CardSelectionResponseAdapter(
+        const std::string& powerOnData,
+        const std::shared_ptr<ApduResponseApi>& selectApplicationResponse,
+        const bool hasMatched,
+        const std::shared_ptr<CardResponseApi>& cardResponse)
+    : mPowerOnData(powerOnData)
+    , mSelectApplicationResponse(selectApplicationResponse)
+    , mHasMatched(hasMatched)
+    , mCardResponse(cardResponse) {
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string&
+    getPowerOnData() const override {
+        return mPowerOnData;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::shared_ptr<ApduResponseApi>
+    getSelectApplicationResponse() const override {
+        return mSelectApplicationResponse;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool
+    hasMatched() const override {
+        return mHasMatched;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::shared_ptr<CardResponseApi>
+    getCardResponse() const override {
+        return mCardResponse;
+    }
+
+private:
+    /**
+     *
+     */
+    const std::string mPowerOnData;
+
+    /**
+     *
+     */
+    const std::shared_ptr<ApduResponseApi> mSelectApplicationResponse;
+
+    /**
+     *
+     */
+    const bool mHasMatched;
+
+    /**
+     *
+     */
+    const std::shared_ptr<CardResponseApi> mCardResponse;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,113 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/MultiSelectionProcessing.hpp"
+#include "keypop/card/spi/CardSelectionRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Immutable group of card selection requests to be processed by the reader in a single pass.
+ *
+ * <p>The candidates (e.g. one per AID) are tried in order. With
+ * keypop::card::MultiSelectionProcessing::FIRST_MATCH, the processing stops at the first matching
+ * candidate, which avoids going back to the application between two attempts.
+ *
+ * @see keypop::card::CardSelectionProcessorApi
+ * @since 2.1.0
+ */
+class CardSelectionScenario final {
+public:
+    /**
+     * Builds a new scenario.
+     *
+     * @param cardSelectionRequests The candidate selection requests, in processing order.
+     * @param multiSelectionProcessing The processing policy.
+     * @param channelControl The channel control policy applied after the last processed request.
+     * @throw std::invalid_argument If the list is empty or contains a null request.
+     * @since 2.1.0
+     */
+    CardSelectionScenario(
+        const std::vector<std::shared_ptr<spi::CardSelectionRequestSpi>>& cardSelectionRequests,
+        const MultiSelectionProcessing multiSelectionProcessing,
+        const ChannelControl channelControl)
+    : mCardSelectionRequests(cardSelectionRequests)
+    , mMultiSelectionProcessing(multiSelectionProcessing)
+    , mChannelControl(channelControl) {
+        if (cardSelectionRequests.empty()) {
+            throw std::invalid_argument("Empty card selection request list");
+        }
+        for (const std::shared_ptr<spi::CardSelectionRequestSpi>& cardSelectionRequest :
+             cardSelectionRequests) {
+            if (cardSelectionRequest == nullptr) {
+                throw std::invalid_argument("Null card selection request");
+            }
+        }
+    }
+
+    /**
+     * Gets the candidate selection requests.
+     *
+     * @return A not empty list.
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<spi::CardSelectionRequestSpi>>&
+    getCardSelectionRequests() const {
+        return mCardSelectionRequests;
+    }
+
+    /**
+     * Gets the processing policy.
+     *
+     * @return A keypop::card::MultiSelectionProcessing value.
+     * @since 2.1.0
+     */
+    MultiSelectionProcessing
+    getMultiSelectionProcessing() const {
+        return mMultiSelectionProcessing;
+    }
+
+    /**
+     * Gets the channel control policy applied after the last processed request.
+     *
+     * @return A keypop::card::ChannelControl value.
+     * @since 2.1.0
+     */
+    ChannelControl
+    getChannelControl() const {
+        return mChannelControl;
+    }
+
+private:
+    /**
+     *
+     */
+    const std::vector<std::shared_ptr<spi::CardSelectionRequestSpi>> mCardSelectionRequests;
+
+    /**
+     *
+     */
+    const MultiSelectionProcessing mMultiSelectionProcessing;
+
+    /**
+     *
+     */
+    const ChannelControl mChannelControl;
+};
+
+} /* namespace card */
+} /* namespace keypop */
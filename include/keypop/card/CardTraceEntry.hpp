@@ -0,0 +1,319 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/CardTransmitStatus.hpp"
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Card request and card response pair exchanged through a keypop::card::ProxyReaderApi, as stored
+ * in a keypop::card::CardTraceRing.
+ *
+ * <p>The binary encoding is compact and independent of the platform:
+ * <ul>
+ * <li>timestamp: 8 bytes, little-endian,
+ * <li>duration, then each count and length: unsigned LEB128 (one byte below 128),
+ * <li>channel control, status and flags: 1 byte each,
+ * <li>the APDU commands, then the APDU responses: count, then length and bytes of each,
+ * <li>the success flags of the APDU responses: one bit per response, least significant bit
+ * first,
+ * <li>the index of the APDU request answered by each APDU response.
+ * </ul>
+ *
+ * @since 2.1.0
+ */
+struct CardTraceEntry {
+    /**
+     * Time of the transmission, in nanoseconds since the epoch of the system clock.
+     *
+     * @since 2.1.0
+     */
+    uint64_t timestamp = 0;
+
+    /**
+     * Duration of the transmission, in nanoseconds.
+     *
+     * @since 2.1.0
+     */
+    uint64_t duration = 0;
+
+    /**
+     * Channel control policy applied.
+     *
+     * @since 2.1.0
+     */
+    ChannelControl channelControl = ChannelControl::KEEP_OPEN;
+
+    /**
+     * Outcome of the transmission.
+     *
+     * @since 2.1.0
+     */
+    CardTransmitStatus status = CardTransmitStatus::SUCCESSFUL;
+
+    /**
+     * See keypop::card::spi::CardRequestSpi::stopOnUnsuccessfulStatusWord().
+     *
+     * @since 2.1.0
+     */
+    bool stopOnUnsuccessfulStatusWord = true;
+
+    /**
+     * See keypop::card::CardResponseApi::isLogicalChannelOpen().
+     *
+     * @since 2.1.0
+     */
+    bool isLogicalChannelOpen = false;
+
+    /**
+     * See keypop::card::CardTransmitResult::isCardResponseComplete().
+     *
+     * @since 2.1.0
+     */
+    bool isCardResponseComplete = true;
+
+    /**
+     * Bytes of the APDU commands of the card request (see getApduRequestBytes()).
+     *
+     * @since 2.1.0
+     */
+    std::vector<std::vector<uint8_t>> apduRequests;
+
+    /**
+     * Bytes of the APDU responses received, status words included.
+     *
+     * @since 2.1.0
+     */
+    std::vector<std::vector<uint8_t>> apduResponses;
+
+    /**
+     * Success of each APDU response, as classified by the reader (see
+     * keypop::card::CardResponseApi::isApduResponseSuccessful()); a missing flag is stored as
+     * false.
+     *
+     * @since 2.1.0
+     */
+    std::vector<bool> apduResponseSuccesses;
+
+    /**
+     * Index of the APDU request answered by each APDU response, as reported by the reader (see
+     * keypop::card::CardResponseApi::getApduRequestIndex()); a missing index is stored as the index
+     * of the response.
+     *
+     * @since 2.1.0
+     */
+    std::vector<std::size_t> apduRequestIndexes;
+
+    /**
+     * Encodes the entry.
+     *
+     * @param output The buffer receiving the record, cleared first (its capacity is reused).
+     * @since 2.1.0
+     */
+    void
+    encode(std::vector<uint8_t>& output) const {
+        output.clear();
+        for (int shift = 0; shift < 64; shift += 8) {
+            output.push_back(static_cast<uint8_t>(timestamp >> shift));
+        }
+        writeVarint(output, duration);
+        output.push_back(static_cast<uint8_t>(channelControl));
+        output.push_back(static_cast<uint8_t>(status));
+        output.push_back(static_cast<uint8_t>(
+            (stopOnUnsuccessfulStatusWord ? FLAG_STOP_ON_UNSUCCESSFUL_STATUS_WORD : 0)
+            | (isLogicalChannelOpen ? FLAG_LOGICAL_CHANNEL_OPEN : 0)
+            | (isCardResponseComplete ? FLAG_CARD_RESPONSE_COMPLETE : 0)));
+        writeApdus(output, apduRequests);
+        writeApdus(output, apduResponses);
+        for (std::size_t i = 0; i < apduResponses.size(); i += 8) {
+            uint8_t successes = 0;
+            for (std::size_t j = i; j < i + 8 && j < apduResponseSuccesses.size(); j++) {
+                successes |= static_cast<uint8_t>(apduResponseSuccesses[j] ? 1 << (j - i) : 0);
+            }
+            output.push_back(successes);
+        }
+        for (std::size_t i = 0; i < apduResponses.size(); i++) {
+            writeVarint(output, i < apduRequestIndexes.size() ? apduRequestIndexes[i] : i);
+        }
+    }
+
+    /**
+     * Decodes an entry.
+     *
+     * @param record The record produced by encode().
+     * @return A new entry.
+     * @throw std::invalid_argument If the record is malformed.
+     * @since 2.1.0
+     */
+    static CardTraceEntry
+    decode(const ByteSpan record) {
+        std::size_t position = 0;
+        CardTraceEntry entry;
+
+        checkAvailable(record, position, 8);
+        for (int shift = 0; shift < 64; shift += 8) {
+            entry.timestamp |= static_cast<uint64_t>(record[position++]) << shift;
+        }
+        entry.duration = readVarint(record, position);
+        checkAvailable(record, position, 3);
+        if (record[position] > static_cast<uint8_t>(ChannelControl::CLOSE_AFTER)
+            || record[position + 1]
+                   > static_cast<uint8_t>(CardTransmitStatus::TIMEOUT)) {
+            throw std::invalid_argument("Malformed card trace record");
+        }
+        entry.channelControl = static_cast<ChannelControl>(record[position++]);
+        entry.status = static_cast<CardTransmitStatus>(record[position++]);
+        const uint8_t flags = record[position++];
+        entry.stopOnUnsuccessfulStatusWord = (flags & FLAG_STOP_ON_UNSUCCESSFUL_STATUS_WORD) != 0;
+        entry.isLogicalChannelOpen = (flags & FLAG_LOGICAL_CHANNEL_OPEN) != 0;
+        entry.isCardResponseComplete = (flags & FLAG_CARD_RESPONSE_COMPLETE) != 0;
+        readApdus(record, position, entry.apduRequests);
+        readApdus(record, position, entry.apduResponses);
+        const std::size_t apduResponseCount = entry.apduResponses.size();
+        checkAvailable(record, position, (apduResponseCount + 7) / 8);
+        entry.apduResponseSuccesses.resize(apduResponseCount);
+        for (std::size_t i = 0; i < apduResponseCount; i++) {
+            entry.apduResponseSuccesses[i] = (record[position + i / 8] >> (i % 8) & 1) != 0;
+        }
+        position += (apduResponseCount + 7) / 8;
+        entry.apduRequestIndexes.resize(apduResponseCount);
+        for (std::size_t i = 0; i < apduResponseCount; i++) {
+            const uint64_t apduRequestIndex = readVarint(record, position);
+            if (apduRequestIndex >= entry.apduRequests.size()) {
+                throw std::invalid_argument("Malformed card trace record");
+            }
+            entry.apduRequestIndexes[i] = static_cast<std::size_t>(apduRequestIndex);
+        }
+        if (position != record.size()) {
+            throw std::invalid_argument("Malformed card trace record");
+        }
+
+        return entry;
+    }
+
+    /**
+     * Gets the bytes stored for an APDU command: the APDU itself, or, for a segmented command
+     * (see keypop::card::spi::ApduRequestSpi::getSegmentedCommand()), which may not fit in a
+     * single APDU, its header followed by its data field.
+     *
+     * @param apduRequest The APDU request.
+     * @param output The buffer receiving the bytes, cleared first (its capacity is reused).
+     * @since 2.1.0
+     */
+    static void
+    getApduRequestBytes(spi::ApduRequestSpi& apduRequest, std::vector<uint8_t>& output) {
+        const spi::ApduCommand* const command = apduRequest.getSegmentedCommand();
+        if (command == nullptr) {
+            const ByteSpan apdu = apduRequest.getApduView();
+            output.assign(apdu.begin(), apdu.end());
+            return;
+        }
+        const ByteSpan header = command->getHeader();
+        output.assign(header.begin(), header.end());
+        output.resize(header.size() + command->getDataLength());
+        command->copyData(0, command->getDataLength(), output.data() + header.size());
+    }
+
+private:
+    /**
+     *
+     */
+    enum : uint8_t {
+        FLAG_STOP_ON_UNSUCCESSFUL_STATUS_WORD = 0x01,
+        FLAG_LOGICAL_CHANNEL_OPEN = 0x02,
+        FLAG_CARD_RESPONSE_COMPLETE = 0x04
+    };
+
+    /**
+     *
+     */
+    static void
+    writeVarint(std::vector<uint8_t>& output, uint64_t value) {
+        while (value >= 0x80) {
+            output.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        output.push_back(static_cast<uint8_t>(value));
+    }
+
+    /**
+     *
+     */
+    static void
+    writeApdus(std::vector<uint8_t>& output, const std::vector<std::vector<uint8_t>>& apdus) {
+        writeVarint(output, apdus.size());
+        for (const auto& apdu : apdus) {
+            writeVarint(output, apdu.size());
+            output.insert(output.end(), apdu.begin(), apdu.end());
+        }
+    }
+
+    /**
+     *
+     */
+    static void
+    checkAvailable(const ByteSpan record, const std::size_t position, const uint64_t length) {
+        if (length > record.size() - position) {
+            throw std::invalid_argument("Truncated card trace record");
+        }
+    }
+
+    /**
+     *
+     */
+    static uint64_t
+    readVarint(const ByteSpan record, std::size_t& position) {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            checkAvailable(record, position, 1);
+            const uint8_t b = record[position++];
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::invalid_argument("Malformed card trace record");
+    }
+
+    /**
+     *
+     */
+    static void
+    readApdus(
+        const ByteSpan record,
+        std::size_t& position,
+        std::vector<std::vector<uint8_t>>& apdus) {
+        const uint64_t count = readVarint(record, position);
+        /* Each APDU takes at least one byte: bounds the allocation on malformed records */
+        checkAvailable(record, position, count);
+        apdus.reserve(static_cast<std::size_t>(count));
+        for (uint64_t i = 0; i < count; i++) {
+            const uint64_t length = readVarint(record, position);
+            checkAvailable(record, position, length);
+            const ByteSpan apdu = record.subspan(position, static_cast<std::size_t>(length));
+            apdus.emplace_back(apdu.begin(), apdu.end());
+            position += static_cast<std::size_t>(length);
+        }
+    }
+};
+
+} /* namespace card */
+} /* namespace keypop */
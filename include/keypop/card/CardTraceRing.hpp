@@ -0,0 +1,386 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Append-only ring of variable length records (typically encoded keypop::card::CardTraceEntry)
+ * stored in a memory block provided by the caller.
+ *
+ * <p>The block typically is a memory-mapped file, so that the last exchanges survive a crash of
+ * the application and can be collected from the field: the ring keeps all its state (a header
+ * followed by the records) inside the block, in a platform independent format, and resumes the
+ * records already present when it is built on a block previously used with the same size.
+ * Mapping the file is left to the application.
+ *
+ * <p>The first 80 bytes of the block hold the header. When the block is full, the oldest records
+ * are overwritten. The positions of the records are kept in two checksummed copies, written
+ * alternately with a sequence number, and the ring resumes from the latest valid copy: an append
+ * interrupted by a crash at any point only loses the record being appended (and the records it
+ * evicts). The records are also checked when the ring is resumed, and the ring is truncated before
+ * the first invalid one.
+ *
+ * <p>This class is not thread safe.
+ *
+ * @since 2.1.0
+ */
+class CardTraceRing final {
+public:
+    /**
+     * Builds a ring on a memory block, resuming its records if it holds a valid ring.
+     *
+     * @param block The memory block, which must outlive the ring.
+     * @param size The size of the block, header included.
+     * @throw std::invalid_argument If the block is null or too small.
+     * @since 2.1.0
+     */
+    CardTraceRing(uint8_t* const block, const std::size_t size)
+    : mBlock(block)
+    , mCapacity(size > HEADER_SIZE ? size - HEADER_SIZE : 0) {
+        if (block == nullptr || mCapacity < 8) {
+            throw std::invalid_argument("Card trace block too small");
+        }
+        if (readUint32(MAGIC_OFFSET) != MAGIC || readUint32(VERSION_OFFSET) != VERSION
+            || readUint64(CAPACITY_OFFSET) != mCapacity) {
+            clear();
+            return;
+        }
+        const bool isFirstValid = readPositions(FIRST_POSITIONS_OFFSET);
+        const uint64_t firstSequence = mSequence;
+        const uint64_t firstHead = mHead;
+        const uint64_t firstTail = mTail;
+        const bool isSecondValid = readPositions(SECOND_POSITIONS_OFFSET);
+        if (!isSecondValid && !isFirstValid) {
+            clear();
+            return;
+        }
+        if (!isSecondValid || (isFirstValid && firstSequence > mSequence)) {
+            mSequence = firstSequence;
+            mHead = firstHead;
+            mTail = firstTail;
+        }
+        for (uint64_t position = mTail; position < mHead;) {
+            const uint64_t available = mHead - position;
+            const uint64_t recordSize
+                = available >= 4 ? 4 + static_cast<uint64_t>(readRecordLength(position)) : 0;
+            if (recordSize == 0 || recordSize > available) {
+                mHead = position;
+                writePositions();
+                break;
+            }
+            position += recordSize;
+        }
+    }
+
+    /**
+     *
+     */
+    CardTraceRing(const CardTraceRing&) = delete;
+
+    /**
+     *
+     */
+    CardTraceRing& operator=(const CardTraceRing&) = delete;
+
+    /**
+     * Appends a record, overwriting the oldest ones if needed.
+     *
+     * @param record The record.
+     * @return False if the record is too large for the block, which is then left unchanged.
+     * @since 2.1.0
+     */
+    bool
+    append(const ByteSpan record) {
+        const uint64_t requiredSize = 4 + static_cast<uint64_t>(record.size());
+        if (requiredSize > mCapacity || record.size() > 0xFFFFFFFF) {
+            return false;
+        }
+        const uint64_t tail = mTail;
+        while (mCapacity - (mHead - mTail) < requiredSize) {
+            mTail += 4 + readRecordLength(mTail);
+        }
+        /* The evicted records are dropped before being overwritten, the new one is only added
+         * once written */
+        if (mTail != tail) {
+            writePositions();
+        }
+
+        uint8_t length[4];
+        for (int i = 0; i < 4; i++) {
+            length[i] = static_cast<uint8_t>(record.size() >> (8 * i));
+        }
+        writeData(mHead, ByteSpan(length, 4));
+        writeData(mHead + 4, record);
+        mHead += requiredSize;
+
+        writePositions();
+
+        return true;
+    }
+
+    /**
+     * Iterates over the records, from the oldest to the newest.
+     *
+     * @param consumer The function receiving each record, which is only valid during the call.
+     * @throw std::logic_error If the block has been modified behind the ring.
+     * @since 2.1.0
+     */
+    void
+    forEachRecord(const std::function<void(const ByteSpan)>& consumer) const {
+        std::vector<uint8_t> record;
+        for (uint64_t position = mTail; position < mHead;) {
+            const uint32_t length = readRecordLength(position);
+            if (length > mCapacity) {
+                throw std::logic_error("Corrupted card trace");
+            }
+            record.resize(length);
+            readData(position + 4, record.data(), length);
+            consumer(ByteSpan(record));
+            position += 4 + static_cast<uint64_t>(length);
+        }
+    }
+
+    /**
+     * Gets the number of records.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getRecordCount() const {
+        std::size_t count = 0;
+        for (uint64_t position = mTail; position < mHead; count++) {
+            position += 4 + static_cast<uint64_t>(readRecordLength(position));
+        }
+
+        return count;
+    }
+
+    /**
+     * Removes all the records.
+     *
+     * @since 2.1.0
+     */
+    void
+    clear() {
+        mSequence = 0;
+        mHead = 0;
+        mTail = 0;
+        writeUint32(MAGIC_OFFSET, MAGIC);
+        writeUint32(VERSION_OFFSET, VERSION);
+        writeUint64(CAPACITY_OFFSET, mCapacity);
+        writePositions(FIRST_POSITIONS_OFFSET);
+        writePositions(SECOND_POSITIONS_OFFSET);
+    }
+
+private:
+    /**
+     * Identification of the format: "KPCT" read as a little-endian integer, and version.
+     */
+    enum : uint32_t { MAGIC = 0x5443504B, VERSION = 2 };
+
+    /**
+     * Header layout: magic, version, capacity and two copies of the positions, all little-endian.
+     * A copy of the positions holds a sequence number, the logical positions of the end and of
+     * the oldest record, and a checksum of these three fields.
+     */
+    enum : std::size_t {
+        MAGIC_OFFSET = 0,
+        VERSION_OFFSET = 4,
+        CAPACITY_OFFSET = 8,
+        FIRST_POSITIONS_OFFSET = 16,
+        SECOND_POSITIONS_OFFSET = 48,
+        SEQUENCE_OFFSET = 0,
+        HEAD_OFFSET = 8,
+        TAIL_OFFSET = 16,
+        CHECKSUM_OFFSET = 24,
+        POSITIONS_SIZE = 32,
+        HEADER_SIZE = 80
+    };
+
+    /**
+     * Reads a copy of the positions into the sequence, head and tail.
+     *
+     * @return False if the copy is invalid (torn or corrupted).
+     */
+    bool
+    readPositions(const std::size_t offset) {
+        mSequence = readUint64(offset + SEQUENCE_OFFSET);
+        mHead = readUint64(offset + HEAD_OFFSET);
+        mTail = readUint64(offset + TAIL_OFFSET);
+
+        return readUint32(offset + CHECKSUM_OFFSET) == getChecksum(offset) && mHead >= mTail
+               && mHead - mTail <= mCapacity;
+    }
+
+    /**
+     * Writes the head and tail to the copy of the positions not holding the latest ones, so that
+     * the other copy stays valid if the write is interrupted.
+     */
+    void
+    writePositions() {
+        mSequence++;
+        writePositions(mSequence % 2 == 0 ? FIRST_POSITIONS_OFFSET : SECOND_POSITIONS_OFFSET);
+    }
+
+    /**
+     *
+     */
+    void
+    writePositions(const std::size_t offset) {
+        writeUint64(offset + SEQUENCE_OFFSET, mSequence);
+        writeUint64(offset + HEAD_OFFSET, mHead);
+        writeUint64(offset + TAIL_OFFSET, mTail);
+        writeUint32(offset + CHECKSUM_OFFSET, getChecksum(offset));
+        writeUint32(offset + CHECKSUM_OFFSET + 4, 0);
+    }
+
+    /**
+     * Computes the FNV-1a hash of the sequence, head and tail of a copy of the positions, which
+     * detects any change of a single byte.
+     */
+    uint32_t
+    getChecksum(const std::size_t offset) const {
+        uint32_t checksum = 0x811C9DC5;
+        for (std::size_t i = 0; i < CHECKSUM_OFFSET; i++) {
+            checksum = (checksum ^ mBlock[offset + i]) * 0x01000193;
+        }
+
+        return checksum;
+    }
+
+    /**
+     *
+     */
+    uint32_t
+    readRecordLength(const uint64_t position) const {
+        uint8_t length[4];
+        readData(position, length, 4);
+
+        return static_cast<uint32_t>(length[0]) | static_cast<uint32_t>(length[1]) << 8
+               | static_cast<uint32_t>(length[2]) << 16 | static_cast<uint32_t>(length[3]) << 24;
+    }
+
+    /**
+     * Copies bytes to a logical position, wrapping around the end of the data area.
+     */
+    void
+    writeData(const uint64_t position, const ByteSpan bytes) {
+        uint8_t* const data = mBlock + HEADER_SIZE;
+        const std::size_t offset = static_cast<std::size_t>(position % mCapacity);
+        const std::size_t firstPart = std::min(bytes.size(), mCapacity - offset);
+        std::memcpy(data + offset, bytes.data(), firstPart);
+        std::memcpy(data, bytes.data() + firstPart, bytes.size() - firstPart);
+    }
+
+    /**
+     * Copies bytes from a logical position, wrapping around the end of the data area.
+     *
+     * @throw std::logic_error If the length exceeds the data area (the block has been modified
+     *        behind the ring).
+     */
+    void
+    readData(const uint64_t position, uint8_t* const bytes, const std::size_t length) const {
+        if (length > mCapacity) {
+            throw std::logic_error("Corrupted card trace");
+        }
+        const uint8_t* const data = mBlock + HEADER_SIZE;
+        const std::size_t offset = static_cast<std::size_t>(position % mCapacity);
+        const std::size_t firstPart = std::min(length, mCapacity - offset);
+        std::memcpy(bytes, data + offset, firstPart);
+        std::memcpy(bytes + firstPart, data, length - firstPart);
+    }
+
+    /**
+     *
+     */
+    uint32_t
+    readUint32(const std::size_t offset) const {
+        uint32_t value = 0;
+        for (std::size_t i = 0; i < 4; i++) {
+            value |= static_cast<uint32_t>(mBlock[offset + i]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    /**
+     *
+     */
+    uint64_t
+    readUint64(const std::size_t offset) const {
+        uint64_t value = 0;
+        for (std::size_t i = 0; i < 8; i++) {
+            value |= static_cast<uint64_t>(mBlock[offset + i]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    /**
+     *
+     */
+    void
+    writeUint32(const std::size_t offset, const uint32_t value) {
+        for (std::size_t i = 0; i < 4; i++) {
+            mBlock[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    /**
+     *
+     */
+    void
+    writeUint64(const std::size_t offset, const uint64_t value) {
+        for (std::size_t i = 0; i < 8; i++) {
+            mBlock[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    /**
+     *
+     */
+    uint8_t* const mBlock;
+
+    /**
+     * Size of the data area following the header.
+     */
+    const std::size_t mCapacity;
+
+    /**
+     * Sequence number of the latest copy of the positions.
+     */
+    uint64_t mSequence;
+
+    /**
+     * Logical position (number of bytes ever appended) of the end of the newest record.
+     */
+    uint64_t mHead;
+
+    /**
+     * Logical position of the oldest record.
+     */
+    uint64_t mTail;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,156 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+
+/* Keypop Card */
+#include "keypop/card/CardBrokenCommunicationException.hpp"
+#include "keypop/card/CardRequestTimeoutException.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardTransmitStatus.hpp"
+#include "keypop/card/UnexpectedStatusWordException.hpp"
+#include "keypop/card/spi/ReaderBrokenCommunicationException.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Result of a card request transmitted without exceptions (see
+ * keypop::card::ProxyReaderApi::tryTransmitCardRequest()).
+ *
+ * <p>It carries the same information as a successful return or a
+ * keypop::card::AbstractApduException of keypop::card::ProxyReaderApi::transmitCardRequest(): the
+ * outcome, the (possibly partial) card response and whether this response is complete. It has no
+ * message nor cause, so building it does not allocate.
+ *
+ * <p>Instances are small immutable values, meant to be returned and copied freely.
+ *
+ * @since 2.1.0
+ */
+class CardTransmitResult final {
+public:
+    /**
+     * Builds a new result.
+     *
+     * @param status The outcome of the transmission.
+     * @param cardResponse The card responses received so far (not null).
+     * @param isCardResponseComplete True if the number of responses equals the number of requests
+     *        present in the original keypop::card::spi::CardRequestSpi.
+     * @since 2.1.0
+     */
+    CardTransmitResult(
+        const CardTransmitStatus status,
+        const std::shared_ptr<CardResponseApi>& cardResponse,
+        const bool isCardResponseComplete)
+    : mCardResponse(cardResponse)
+    , mStatus(status)
+    , mIsCardResponseComplete(isCardResponseComplete) {
+    }
+
+    /**
+     * Gets the outcome of the transmission.
+     *
+     * @return The status.
+     * @since 2.1.0
+     */
+    CardTransmitStatus
+    getStatus() const {
+        return mStatus;
+    }
+
+    /**
+     * Indicates if the transmission was successful.
+     *
+     * @return True if the status is keypop::card::CardTransmitStatus::SUCCESSFUL.
+     * @since 2.1.0
+     */
+    bool
+    isSuccessful() const {
+        return mStatus == CardTransmitStatus::SUCCESSFUL;
+    }
+
+    /**
+     * Gets the response data received, complete or not.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    const std::shared_ptr<CardResponseApi>&
+    getCardResponse() const {
+        return mCardResponse;
+    }
+
+    /**
+     * Indicates if all the responses expected from the corresponding
+     * keypop::card::spi::CardRequestSpi have been received.
+     *
+     * @return True if all expected responses have been received.
+     * @since 2.1.0
+     */
+    bool
+    isCardResponseComplete() const {
+        return mIsCardResponseComplete;
+    }
+
+    /**
+     * Throws the exception keypop::card::ProxyReaderApi::transmitCardRequest() would have thrown
+     * for this result, if any.
+     *
+     * <p>This allows a reader implementing the non-throwing transmission to implement the
+     * throwing one on top of it.
+     *
+     * @throw UnexpectedStatusWordException If the status is UNEXPECTED_STATUS_WORD.
+     * @throw CardBrokenCommunicationException If the status is CARD_BROKEN_COMMUNICATION.
+     * @throw ReaderBrokenCommunicationException If the status is READER_BROKEN_COMMUNICATION.
+     * @throw CardRequestTimeoutException If the status is TIMEOUT.
+     * @since 2.1.0
+     */
+    void
+    throwIfUnsuccessful() const {
+        switch (mStatus) {
+        case CardTransmitStatus::UNEXPECTED_STATUS_WORD:
+            throw UnexpectedStatusWordException(
+                mCardResponse, mIsCardResponseComplete, "Unexpected status word");
+        case CardTransmitStatus::CARD_BROKEN_COMMUNICATION:
+            throw CardBrokenCommunicationException(
+                mCardResponse, mIsCardResponseComplete, "Card communication failure");
+        case CardTransmitStatus::READER_BROKEN_COMMUNICATION:
+            throw ReaderBrokenCommunicationException(
+                mCardResponse, mIsCardResponseComplete, "Reader communication failure");
+        case CardTransmitStatus::TIMEOUT:
+            throw CardRequestTimeoutException(
+                mCardResponse, mIsCardResponseComplete, "Card request timeout");
+        case CardTransmitStatus::SUCCESSFUL:
+        default:
+            break;
+        }
+    }
+
+private:
+    /**
+     *
+     */
+    std::shared_ptr<CardResponseApi> mCardResponse;
+
+    /**
+     *
+     */
+    CardTransmitStatus mStatus;
+
+    /**
+     *
+     */
+    bool mIsCardResponseComplete;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,67 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#pragma once
+
+namespace keypop {
+namespace card {
+
+/**
+ * Outcome of the transmission of a card request.
+ *
+ * <p>Each unsuccessful value corresponds to one of the exceptions thrown by
+ * keypop::card::ProxyReaderApi::transmitCardRequest().
+ *
+ * @see keypop::card::CardTransmitResult
+ * @since 2.1.0
+ */
+enum class CardTransmitStatus {
+    /**
+     * All the APDUs have been exchanged and, if required, all the status words were successful.
+     *
+     * @since 2.1.0
+     */
+    SUCCESSFUL,
+
+    /**
+     * An APDU returned an unexpected status word and the card request specified the need to check
+     * them (see keypop::card::UnexpectedStatusWordException).
+     *
+     * @since 2.1.0
+     */
+    UNEXPECTED_STATUS_WORD,
+
+    /**
+     * The communication with the card has failed (see
+     * keypop::card::CardBrokenCommunicationException).
+     *
+     * @since 2.1.0
+     */
+    CARD_BROKEN_COMMUNICATION,
+
+    /**
+     * The communication with the reader has failed (see
+     * keypop::card::ReaderBrokenCommunicationException).
+     *
+     * @since 2.1.0
+     */
+    READER_BROKEN_COMMUNICATION,
+
+    /**
+     * The deadline of the card request or the timeout of an APDU expired (see
+     * keypop::card::CardRequestTimeoutException).
+     *
+     * @since 2.1.0
+     */
+    TIMEOUT
+};
+
+} /* namespace card */
+} /* namespace keypop */
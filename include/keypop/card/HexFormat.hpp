@@ -0,0 +1,94 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "keypop/card/ByteSpan.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Hexadecimal representation of a sequence of bytes, rendered only when written to a stream.
+ *
+ * <p>Building an instance only captures a view on the bytes: nothing is formatted nor allocated
+ * until the instance is written with <b>operator&lt;&lt;</b>, so it can be passed to a log
+ * statement whose level may discard it. The bytes must remain valid until then.
+ *
+ * <p>The output is bounded: beyond the maximum number of bytes, the representation is truncated
+ * and followed by the total length, e.g. <code>00A40400...(261)</code>.
+ *
+ * <p>The <b>operator&lt;&lt;</b> overloads of this API use it with the default maximum length.
+ *
+ * @since 2.1.0
+ */
+class HexFormat final {
+public:
+    /**
+     * Builds a formatter of the provided bytes.
+     *
+     * @param bytes The bytes, which must remain valid until the formatter is written.
+     * @param maxLength The maximum number of bytes to write, the following ones being elided.
+     * @since 2.1.0
+     */
+    explicit HexFormat(const ByteSpan bytes, const std::size_t maxLength = 256) noexcept
+    : mBytes(bytes)
+    , mMaxLength(maxLength) {
+    }
+
+    /**
+     * Writes the bytes as an uppercase hexadecimal string, truncated if needed.
+     *
+     * <p>The characters are written by chunks from a buffer on the stack.
+     *
+     * @since 2.1.0
+     */
+    friend std::ostream&
+    operator<<(std::ostream& os, const HexFormat& hex) {
+        static const char digits[] = "0123456789ABCDEF";
+
+        const bool isTruncated = hex.mBytes.size() > hex.mMaxLength;
+        const ByteSpan bytes = isTruncated ? hex.mBytes.first(hex.mMaxLength) : hex.mBytes;
+
+        char buffer[128];
+        std::size_t length = 0;
+        for (const uint8_t b : bytes) {
+            buffer[length++] = digits[b >> 4];
+            buffer[length++] = digits[b & 0x0F];
+            if (length == sizeof(buffer)) {
+                os.write(buffer, static_cast<std::streamsize>(length));
+                length = 0;
+            }
+        }
+        os.write(buffer, static_cast<std::streamsize>(length));
+        if (isTruncated) {
+            os << "...(" << hex.mBytes.size() << ")";
+        }
+
+        return os;
+    }
+
+private:
+    /**
+     *
+     */
+    const ByteSpan mBytes;
+
+    /**
+     *
+     */
+    const std::size_t mMaxLength;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,515 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "keypop/card/AbstractApduException.hpp"
+#include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/CardBrokenCommunicationException.hpp"
+#include "keypop/card/CardRequestTimeoutException.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardTransmitResult.hpp"
+#include "keypop/card/CardTransmitStatus.hpp"
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+#include "keypop/card/UnexpectedStatusWordException.hpp"
+#include "keypop/card/spi/ApduChainingSpi.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+#include "keypop/card/spi/ApduResponseObserverSpi.hpp"
+#include "keypop/card/spi/ApduSequenceView.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+#include "keypop/card/spi/CardResponseCallbackSpi.hpp"
+#include "keypop/card/spi/ReaderBrokenCommunicationException.hpp"
+#include "keypop/card/spi/TransmissionInstrumentationSpi.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Decorator of any keypop::card::ProxyReaderApi reporting its transmissions to a
+ * keypop::card::spi::TransmissionInstrumentationSpi.
+ *
+ * <p>Each transmitted card request is wrapped in a probe whose
+ * keypop::card::spi::ApduResponseObserverSpi times the APDU responses as the decorated reader
+ * notifies them, then forwards them to the observer of the original request, if any. The APDU
+ * records, then the outcome of the request (responses, channel control, exception type, total
+ * duration), are reported once the decorated reader returns or throws: the success of each
+ * response is then the one reported by the reader in the card response (see
+ * keypop::card::CardResponseApi::isApduResponseSuccessful()). If the decorated reader does not
+ * notify the responses as they are received, the APDU records have a null duration.
+ *
+ * <p>When the instrumentation is disabled, each call is forwarded to the decorated reader after a
+ * single relaxed atomic load: no probe is allocated and the clock is not read.
+ *
+ * <p>This class is as thread safe as the decorated reader.
+ *
+ * @since 2.1.0
+ */
+class InstrumentedProxyReader final : public ProxyReaderApi {
+public:
+    /**
+     * Builds a new decorator, enabled if an instrumentation is provided.
+     *
+     * @param reader The decorated reader (not null).
+     * @param instrumentation The instrumentation to report to (null to disable the
+     *        instrumentation).
+     * @since 2.1.0
+     */
+    InstrumentedProxyReader(
+        const std::shared_ptr<ProxyReaderApi>& reader,
+        const std::shared_ptr<spi::TransmissionInstrumentationSpi>& instrumentation)
+    : mReader(reader)
+    , mInstrumentation(instrumentation)
+    , mIsEnabled(instrumentation != nullptr) {
+    }
+
+    /**
+     * Enables or disables the instrumentation, taking effect for the next transmissions.
+     *
+     * <p>The instrumentation cannot be enabled if none was provided.
+     *
+     * @param isEnabled True to report the transmissions.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    InstrumentedProxyReader&
+    setEnabled(const bool isEnabled) {
+        mIsEnabled.store(isEnabled && mInstrumentation != nullptr, std::memory_order_relaxed);
+
+        return *this;
+    }
+
+    /**
+     * Indicates if the transmissions are reported.
+     *
+     * @return True if the instrumentation is enabled.
+     * @since 2.1.0
+     */
+    bool
+    isEnabled() const {
+        return mIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the decorated reader.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    const std::shared_ptr<ProxyReaderApi>&
+    getReader() const {
+        return mReader;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::shared_ptr<CardResponseApi>
+    transmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        if (!isEnabled()) {
+            return mReader->transmitCardRequest(cardRequest, channelControl);
+        }
+
+        const std::shared_ptr<Probe> probe = std::make_shared<Probe>(cardRequest, mInstrumentation);
+        std::shared_ptr<CardResponseApi> cardResponse;
+        try {
+            cardResponse = mReader->transmitCardRequest(probe, channelControl);
+        } catch (AbstractApduException& e) {
+            probe->complete(channelControl, e.getCardResponse().get(), &typeid(e));
+            throw;
+        } catch (const std::exception& e) {
+            probe->complete(channelControl, nullptr, &typeid(e));
+            throw;
+        }
+        probe->complete(channelControl, cardResponse.get(), nullptr);
+
+        return cardResponse;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The probe is forwarded to the same overload of the decorated reader.
+     *
+     * @since 2.1.0
+     */
+    std::unique_ptr<CardResponseApi>
+    transmitCardRequest(
+        const spi::CardRequestSpi& cardRequest, const ChannelControl channelControl) override {
+        if (!isEnabled()) {
+            return mReader->transmitCardRequest(cardRequest, channelControl);
+        }
+
+        const std::shared_ptr<Probe> probe
+            = std::make_shared<Probe>(borrowCardRequest(cardRequest), mInstrumentation);
+        std::unique_ptr<CardResponseApi> cardResponse;
+        try {
+            cardResponse = mReader->transmitCardRequest(*probe, channelControl);
+        } catch (AbstractApduException& e) {
+            probe->complete(channelControl, e.getCardResponse().get(), &typeid(e));
+            throw;
+        } catch (const std::exception& e) {
+            probe->complete(channelControl, nullptr, &typeid(e));
+            throw;
+        }
+        probe->complete(channelControl, cardResponse.get(), nullptr);
+
+        return cardResponse;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The failures reported in the result are recorded with the type of the exception that
+     * transmitCardRequest() would have thrown.
+     *
+     * @since 2.1.0
+     */
+    CardTransmitResult
+    tryTransmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        if (!isEnabled()) {
+            return mReader->tryTransmitCardRequest(cardRequest, channelControl);
+        }
+
+        const std::shared_ptr<Probe> probe = std::make_shared<Probe>(cardRequest, mInstrumentation);
+        try {
+            const CardTransmitResult result
+                = mReader->tryTransmitCardRequest(probe, channelControl);
+            probe->complete(
+                channelControl, result.getCardResponse().get(), getExceptionType(result));
+
+            return result;
+        } catch (const std::exception& e) {
+            probe->complete(channelControl, nullptr, &typeid(e));
+            throw;
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The transmission is reported before the callback is invoked.
+     *
+     * @since 2.1.0
+     */
+    void
+    transmitCardRequestAsync(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl,
+        const std::shared_ptr<spi::CardResponseCallbackSpi> callback) override {
+        if (!isEnabled()) {
+            mReader->transmitCardRequestAsync(cardRequest, channelControl, callback);
+            return;
+        }
+
+        const std::shared_ptr<Probe> probe = std::make_shared<Probe>(cardRequest, mInstrumentation);
+        mReader->transmitCardRequestAsync(
+            probe,
+            channelControl,
+            std::make_shared<ProbeCallback>(probe, channelControl, callback));
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void
+    releaseChannel() override {
+        mReader->releaseChannel();
+    }
+
+private:
+    /**
+     * Clock used to time the exchanges.
+     */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Card request transmitted in place of the original one, timing its APDU responses.
+     */
+    class Probe final : public spi::CardRequestSpi,
+                        public spi::ApduResponseObserverSpi,
+                        public std::enable_shared_from_this<Probe> {
+    public:
+        Probe(
+            const std::shared_ptr<spi::CardRequestSpi>& cardRequest,
+            const std::shared_ptr<spi::TransmissionInstrumentationSpi>& instrumentation)
+        : mCardRequest(cardRequest)
+        , mApduSequence(cardRequest->getApduSequence())
+        , mApduCount(
+              !mApduSequence.empty() ? mApduSequence.size()
+                                     : cardRequest->getApduRequests().size())
+        , mObserver(cardRequest->getApduResponseObserver())
+        , mInstrumentation(instrumentation)
+        , mStartTime(Clock::now())
+        , mLastTime(mStartTime)
+        , mCommandLength(0)
+        , mResponseLength(0) {
+            mNotifications.reserve(mApduCount);
+        }
+
+        const std::vector<std::shared_ptr<spi::ApduRequestSpi>>&
+        getApduRequests() const override {
+            return mCardRequest->getApduRequests();
+        }
+
+        bool
+        stopOnUnsuccessfulStatusWord() const override {
+            return mCardRequest->stopOnUnsuccessfulStatusWord();
+        }
+
+        std::shared_ptr<spi::ApduResponseObserverSpi>
+        getApduResponseObserver() const override {
+            return std::const_pointer_cast<Probe>(shared_from_this());
+        }
+
+        std::shared_ptr<spi::ApduChainingSpi>
+        getApduChaining() const override {
+            return mCardRequest->getApduChaining();
+        }
+
+        spi::ApduSequenceView
+        getApduSequence() const override {
+            return mCardRequest->getApduSequence();
+        }
+
+        std::chrono::steady_clock::time_point
+        getDeadline() const override {
+            return mCardRequest->getDeadline();
+        }
+
+        std::chrono::microseconds
+        getApduTimeout() const override {
+            return mCardRequest->getApduTimeout();
+        }
+
+        void
+        onApduResponse(
+            const std::size_t index, const std::shared_ptr<ApduResponseApi> apduResponse) override {
+            const Clock::time_point now = Clock::now();
+            mNotifications.push_back({index, apduResponse, now - mLastTime});
+            if (mObserver != nullptr) {
+                mObserver->onApduResponse(index, apduResponse);
+                /* The processing time of the observer is not charged to the next APDU */
+                mLastTime = Clock::now();
+            } else {
+                mLastTime = now;
+            }
+        }
+
+        /**
+         * Reports the APDU exchanges and the outcome of the transmission, once.
+         */
+        void
+        complete(
+            const ChannelControl channelControl,
+            const CardResponseApi* const cardResponse,
+            const std::type_info* const exceptionType) {
+            const Clock::time_point now = Clock::now();
+            const std::size_t apduResponseCount
+                = cardResponse != nullptr ? cardResponse->getApduResponses().size() : 0;
+            if (!mNotifications.empty()) {
+                /* The notified responses are those of the card response, in the same order */
+                for (std::size_t i = 0; i < mNotifications.size(); i++) {
+                    const Notification& notification = mNotifications[i];
+                    report(
+                        notification.index,
+                        *notification.apduResponse,
+                        i < apduResponseCount
+                            ? cardResponse->isApduResponseSuccessful(i)
+                            : notification.apduResponse->getStatusWord() == 0x9000,
+                        notification.duration);
+                }
+            } else {
+                /* The decorated reader does not notify the responses as they are received */
+                for (std::size_t i = 0; i < apduResponseCount; i++) {
+                    report(
+                        cardResponse->getApduRequestIndex(i),
+                        *cardResponse->getApduResponses()[i],
+                        cardResponse->isApduResponseSuccessful(i),
+                        Clock::duration::zero());
+                }
+            }
+
+            spi::TransmissionInstrumentationSpi::CardRequestRecord record;
+            record.channelControl = channelControl;
+            record.apduCount = mApduCount;
+            record.apduResponseCount = apduResponseCount;
+            record.commandLength = mCommandLength;
+            record.responseLength = mResponseLength;
+            record.exceptionType = exceptionType;
+            record.duration
+                = std::chrono::duration_cast<std::chrono::nanoseconds>(now - mStartTime);
+            mInstrumentation->onCardRequestTransmitted(record);
+        }
+
+    private:
+        /**
+         * APDU response notified by the decorated reader, with its timing.
+         */
+        struct Notification {
+            std::size_t index;
+            std::shared_ptr<ApduResponseApi> apduResponse;
+            Clock::duration duration;
+        };
+
+        void
+        report(
+            const std::size_t index,
+            const ApduResponseApi& apduResponse,
+            const bool isSuccessful,
+            const Clock::duration duration) {
+            static const std::string noInfo;
+
+            const std::string* info = &noInfo;
+            std::size_t commandLength = 0;
+            if (index < mApduCount) {
+                /* The bulk view, when provided, avoids building the legacy APDU requests */
+                if (!mApduSequence.empty()) {
+                    info = &mApduSequence.getInfo(index);
+                    commandLength = mApduSequence.getApdu(index).size();
+                } else {
+                    spi::ApduRequestSpi& apduRequest = *mCardRequest->getApduRequests()[index];
+                    info = &apduRequest.getInfo();
+                    commandLength = getCommandLength(apduRequest);
+                }
+            }
+
+            const spi::TransmissionInstrumentationSpi::ApduRecord record
+                = {*info,
+                   index,
+                   commandLength,
+                   apduResponse.getApduView().size(),
+                   apduResponse.getStatusWord(),
+                   isSuccessful,
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(duration)};
+            mCommandLength += record.commandLength;
+            mResponseLength += record.responseLength;
+            mInstrumentation->onApduExchanged(record);
+        }
+
+        /**
+         * Gets the length of a command, without encoding it if it is segmented: it may not fit in
+         * a single APDU.
+         */
+        static std::size_t
+        getCommandLength(spi::ApduRequestSpi& apduRequest) {
+            const spi::ApduCommand* const command = apduRequest.getSegmentedCommand();
+
+            return command != nullptr ? command->getHeader().size() + command->getDataLength()
+                                      : apduRequest.getApduView().size();
+        }
+
+        const std::shared_ptr<spi::CardRequestSpi> mCardRequest;
+        const spi::ApduSequenceView mApduSequence;
+        const std::size_t mApduCount;
+        const std::shared_ptr<spi::ApduResponseObserverSpi> mObserver;
+        const std::shared_ptr<spi::TransmissionInstrumentationSpi> mInstrumentation;
+        const Clock::time_point mStartTime;
+        Clock::time_point mLastTime;
+        std::vector<Notification> mNotifications;
+        std::size_t mCommandLength;
+        std::size_t mResponseLength;
+    };
+
+    /**
+     * Callback reporting an asynchronous transmission before notifying the original callback.
+     */
+    class ProbeCallback final : public spi::CardResponseCallbackSpi {
+    public:
+        ProbeCallback(
+            const std::shared_ptr<Probe>& probe,
+            const ChannelControl channelControl,
+            const std::shared_ptr<spi::CardResponseCallbackSpi>& callback)
+        : mProbe(probe)
+        , mChannelControl(channelControl)
+        , mCallback(callback) {
+        }
+
+        void
+        onCardResponse(const std::shared_ptr<CardResponseApi> cardResponse) override {
+            mProbe->complete(mChannelControl, cardResponse.get(), nullptr);
+            mCallback->onCardResponse(cardResponse);
+        }
+
+        void
+        onCardRequestFailure(const std::exception_ptr exception) override {
+            try {
+                std::rethrow_exception(exception);
+            } catch (AbstractApduException& e) {
+                mProbe->complete(mChannelControl, e.getCardResponse().get(), &typeid(e));
+            } catch (const std::exception& e) {
+                mProbe->complete(mChannelControl, nullptr, &typeid(e));
+            } catch (...) {
+                /* Not an exception of this API, not reported */
+            }
+            mCallback->onCardRequestFailure(exception);
+        }
+
+    private:
+        const std::shared_ptr<Probe> mProbe;
+        const ChannelControl mChannelControl;
+        const std::shared_ptr<spi::CardResponseCallbackSpi> mCallback;
+    };
+
+    /**
+     * Gets the type of the exception corresponding to the status of a result.
+     */
+    static const std::type_info*
+    getExceptionType(const CardTransmitResult& result) {
+        switch (result.getStatus()) {
+        case CardTransmitStatus::UNEXPECTED_STATUS_WORD:
+            return &typeid(UnexpectedStatusWordException);
+        case CardTransmitStatus::CARD_BROKEN_COMMUNICATION:
+            return &typeid(CardBrokenCommunicationException);
+        case CardTransmitStatus::READER_BROKEN_COMMUNICATION:
+            return &typeid(ReaderBrokenCommunicationException);
+        case CardTransmitStatus::TIMEOUT:
+            return &typeid(CardRequestTimeoutException);
+        case CardTransmitStatus::SUCCESSFUL:
+        default:
+            return nullptr;
+        }
+    }
+
+    /**
+     *
+     */
+    const std::shared_ptr<ProxyReaderApi> mReader;
+
+    /**
+     *
+     */
+    const std::shared_ptr<spi::TransmissionInstrumentationSpi> mInstrumentation;
+
+    /**
+     *
+     */
+    std::atomic<bool> mIsEnabled;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,717 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "keypop/card/AbstractApduException.hpp"
+#include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/CardBrokenCommunicationException.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardResponseSummary.hpp"
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+#include "keypop/card/UnexpectedStatusWordException.hpp"
+#include "keypop/card/spi/ApduChainingSpi.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+#include "keypop/card/spi/ApduResponseObserverSpi.hpp"
+#include "keypop/card/spi/ApduSequenceView.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+#include "keypop/card/spi/ReaderBrokenCommunicationException.hpp"
+#include "keypop/card/spi/SegmentedApduRequest.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Multiplexer of the ISO 7816-4 logical channels of a card over a single
+ * keypop::card::ProxyReaderApi.
+ *
+ * <p>Each call to openChannel() opens a logical channel with a <b>MANAGE CHANNEL</b> command sent
+ * on the basic channel, the number being assigned by the card (1 to 19). The returned
+ * keypop::card::LogicalChannelMultiplexer::Channel is a keypop::card::ProxyReaderApi addressing
+ * this logical channel only: the class byte of each APDU it transmits is rewritten to carry the
+ * channel number (see encodeClassByte()). Several applications of a card (e.g. ticketing and
+ * loyalty) can thus be selected once, each on its own channel, and used by independent threads
+ * without reselecting.
+ *
+ * <p>The card requests of all the channels are serialized onto the reader: each card request is
+ * transmitted as a whole, its APDUs being sent back-to-back, and the requests of the other
+ * channels wait for its completion. This granularity is deliberate: the reader processes a card
+ * request as a unit (response retrieval, command chaining, stop on an unsuccessful status word,
+ * deadline), and many cards lose a pending response or chain when a command of another channel is
+ * interleaved. Applications needing a finer sharing of the card send shorter card requests. The
+ * physical channel is always kept open by the channels.
+ *
+ * <p>The reader must not be used by other components while channels are open. This class and the
+ * channels are thread safe, a channel being typically owned by one thread.
+ *
+ * @since 2.1.0
+ */
+class LogicalChannelMultiplexer final {
+public:
+    /**
+     * Number of the last logical channel that can be addressed.
+     *
+     * @since 2.1.0
+     */
+    enum : int { MAX_CHANNEL_NUMBER = 19 };
+
+private:
+    /**
+     * State shared by the multiplexer and its channels, guarded by its mutex.
+     */
+    struct Link {
+        explicit Link(const std::shared_ptr<ProxyReaderApi>& proxyReader)
+        : reader(proxyReader)
+        , isOpen() {
+        }
+
+        /**
+         * Transmits a single APDU on the basic channel, keeping the physical channel open.
+         */
+        std::shared_ptr<CardResponseApi>
+        transmit(const ByteSpan apdu) {
+            const std::shared_ptr<spi::CardRequestAdapter> cardRequest
+                = std::make_shared<spi::CardRequestAdapter>(true);
+            cardRequest->addApduRequest(std::make_shared<spi::ApduRequestAdapter>(apdu));
+            try {
+                return reader->transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+            } catch (const CardBrokenCommunicationException&) {
+                closeAll();
+                throw;
+            } catch (const ReaderBrokenCommunicationException&) {
+                closeAll();
+                throw;
+            }
+        }
+
+        /**
+         * Closes a logical channel opened by the card. It is considered closed even if the card
+         * refuses. The number may be beyond MAX_CHANNEL_NUMBER, the command being sent on the
+         * basic channel.
+         */
+        void
+        close(const int channelNumber) {
+            const uint8_t manageChannelClose[]
+                = {0x00, 0x70, 0x80, static_cast<uint8_t>(channelNumber)};
+            if (channelNumber <= MAX_CHANNEL_NUMBER) {
+                isOpen[channelNumber] = false;
+            }
+            try {
+                transmit(ByteSpan(manageChannelClose, sizeof(manageChannelClose)));
+            } catch (const UnexpectedStatusWordException&) {
+                /* Nothing more can be done with this channel number */
+            }
+        }
+
+        /**
+         * Marks all the logical channels as closed, the physical channel being lost.
+         */
+        void
+        closeAll() {
+            for (int i = 0; i <= MAX_CHANNEL_NUMBER; i++) {
+                isOpen[i] = false;
+            }
+        }
+
+        const std::shared_ptr<ProxyReaderApi> reader;
+        std::mutex mutex;
+        bool isOpen[MAX_CHANNEL_NUMBER + 1];
+    };
+
+public:
+    /**
+     * keypop::card::ProxyReaderApi addressing one logical channel of the card.
+     *
+     * <p>A card response reports the state of this logical channel: it is closed by
+     * keypop::card::ChannelControl::CLOSE_AFTER or releaseChannel(), the physical channel being
+     * kept open. The card responses carried by the exceptions are those of the reader. Once closed,
+     * the channel cannot transmit anymore.
+     *
+     * @since 2.1.0
+     */
+    class Channel final : public ProxyReaderApi {
+    public:
+        using ProxyReaderApi::transmitCardRequest;
+
+        /**
+         * Gets the number of the logical channel, assigned by the card.
+         *
+         * @return A value from 1 to MAX_CHANNEL_NUMBER.
+         * @since 2.1.0
+         */
+        int
+        getChannelNumber() const {
+            return mChannelNumber;
+        }
+
+        /**
+         * Indicates if the logical channel is open.
+         *
+         * @return False once closed by the application or lost with the physical channel.
+         * @since 2.1.0
+         */
+        bool
+        isOpen() const {
+            std::lock_guard<std::mutex> lock(mLink->mutex);
+
+            return mLink->isOpen[mChannelNumber];
+        }
+
+        /**
+         * {@inheritDoc}
+         *
+         * <p>The class bytes of the APDUs, including those generated by the
+         * keypop::card::spi::ApduChainingSpi of the request, are rewritten for this channel. The
+         * request is transmitted with keypop::card::ChannelControl::KEEP_OPEN; with
+         * keypop::card::ChannelControl::CLOSE_AFTER, the logical channel is then closed, even if
+         * the request failed with an unexpected status word or a timeout.
+         *
+         * @throw std::logic_error If the channel is closed.
+         * @throw std::invalid_argument If a class byte cannot address the channel.
+         * @since 2.1.0
+         */
+        const std::shared_ptr<CardResponseApi>
+        transmitCardRequest(
+            const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+            const ChannelControl channelControl) override {
+            bool isLogicalChannelOpen = false;
+            std::shared_ptr<CardResponseApi> cardResponse
+                = transmit<std::shared_ptr<CardResponseApi>>(
+                    std::make_shared<ChannelCardRequest>(cardRequest, mChannelNumber),
+                    channelControl,
+                    isLogicalChannelOpen);
+
+            return std::make_shared<ChannelCardResponse<std::shared_ptr<CardResponseApi>>>(
+                std::move(cardResponse), isLogicalChannelOpen);
+        }
+
+        /**
+         * {@inheritDoc}
+         *
+         * <p>The request for this channel is forwarded to the same overload of the reader.
+         *
+         * @throw std::logic_error If the channel is closed.
+         * @throw std::invalid_argument If a class byte cannot address the channel.
+         * @since 2.1.0
+         */
+        std::unique_ptr<CardResponseApi>
+        transmitCardRequest(
+            const spi::CardRequestSpi& cardRequest, const ChannelControl channelControl) override {
+            bool isLogicalChannelOpen = false;
+            std::unique_ptr<CardResponseApi> cardResponse
+                = transmit<std::unique_ptr<CardResponseApi>>(
+                    std::make_shared<ChannelCardRequest>(
+                        borrowCardRequest(cardRequest), mChannelNumber),
+                    channelControl,
+                    isLogicalChannelOpen);
+
+            return std::unique_ptr<CardResponseApi>(
+                new ChannelCardResponse<std::unique_ptr<CardResponseApi>>(
+                    std::move(cardResponse), isLogicalChannelOpen));
+        }
+
+        /**
+         * {@inheritDoc}
+         *
+         * <p>The logical channel is closed with a <b>MANAGE CHANNEL</b> command, the physical
+         * channel being kept open. Nothing is sent if it is already closed.
+         *
+         * @since 2.1.0
+         */
+        void
+        releaseChannel() override {
+            std::lock_guard<std::mutex> lock(mLink->mutex);
+            if (mLink->isOpen[mChannelNumber]) {
+                mLink->close(mChannelNumber);
+            }
+        }
+
+    private:
+        friend class LogicalChannelMultiplexer;
+
+        /**
+         *
+         */
+        Channel(const std::shared_ptr<Link>& link, const int channelNumber)
+        : mLink(link)
+        , mChannelNumber(channelNumber) {
+        }
+
+        /**
+         * Transmits the request for this channel with the overload of the reader returning the
+         * provided response type, then applies the channel control.
+         */
+        template <typename CardResponsePointer>
+        CardResponsePointer
+        transmit(
+            const std::shared_ptr<spi::CardRequestSpi>& channelCardRequest,
+            const ChannelControl channelControl,
+            bool& isLogicalChannelOpen) {
+            std::lock_guard<std::mutex> lock(mLink->mutex);
+            if (!mLink->isOpen[mChannelNumber]) {
+                throw std::logic_error("Logical channel closed");
+            }
+
+            CardResponsePointer cardResponse;
+            try {
+                transmitKeepOpen(*mLink->reader, channelCardRequest, cardResponse);
+            } catch (const CardBrokenCommunicationException&) {
+                mLink->closeAll();
+                throw;
+            } catch (const ReaderBrokenCommunicationException&) {
+                mLink->closeAll();
+                throw;
+            } catch (const AbstractApduException&) {
+                if (channelControl == ChannelControl::CLOSE_AFTER) {
+                    closeAfterFailure();
+                }
+                throw;
+            }
+            if (channelControl == ChannelControl::CLOSE_AFTER) {
+                mLink->close(mChannelNumber);
+            }
+            isLogicalChannelOpen = mLink->isOpen[mChannelNumber];
+
+            return cardResponse;
+        }
+
+        /**
+         *
+         */
+        static void
+        transmitKeepOpen(
+            ProxyReaderApi& reader,
+            const std::shared_ptr<spi::CardRequestSpi>& channelCardRequest,
+            std::shared_ptr<CardResponseApi>& cardResponse) {
+            cardResponse
+                = reader.transmitCardRequest(channelCardRequest, ChannelControl::KEEP_OPEN);
+        }
+
+        /**
+         *
+         */
+        static void
+        transmitKeepOpen(
+            ProxyReaderApi& reader,
+            const std::shared_ptr<spi::CardRequestSpi>& channelCardRequest,
+            std::unique_ptr<CardResponseApi>& cardResponse) {
+            cardResponse
+                = reader.transmitCardRequest(*channelCardRequest, ChannelControl::KEEP_OPEN);
+        }
+
+        /**
+         * Closes the logical channel after a failed request, the exception of the request being
+         * the one reported.
+         */
+        void
+        closeAfterFailure() {
+            try {
+                mLink->close(mChannelNumber);
+            } catch (const CardBrokenCommunicationException&) {
+                /* All the channels have been marked as closed */
+            } catch (const ReaderBrokenCommunicationException&) {
+                /* All the channels have been marked as closed */
+            }
+        }
+
+        /**
+         *
+         */
+        const std::shared_ptr<Link> mLink;
+
+        /**
+         *
+         */
+        const int mChannelNumber;
+    };
+
+    /**
+     * Builds a multiplexer, no logical channel being opened.
+     *
+     * @param reader The reader (not null).
+     * @throw std::invalid_argument If the reader is null.
+     * @since 2.1.0
+     */
+    explicit LogicalChannelMultiplexer(const std::shared_ptr<ProxyReaderApi>& reader)
+    : mLink(std::make_shared<Link>(reader)) {
+        if (reader == nullptr) {
+            throw std::invalid_argument("Null reader");
+        }
+    }
+
+    /**
+     * Opens a new logical channel, the card choosing its number.
+     *
+     * <p>The physical channel is opened if needed and kept open.
+     *
+     * <p>If the card returns a channel number that cannot be used, because it is beyond
+     * MAX_CHANNEL_NUMBER or already open on this side, the channel it opened is closed before
+     * throwing. An already open channel is then considered closed, the card having reassigned its
+     * number.
+     *
+     * @return A not null reference.
+     * @throw UnexpectedStatusWordException If the card refused to open a channel (e.g. all its
+     *        channels are in use).
+     * @throw std::runtime_error If the card returned an invalid or already open channel number.
+     * @throw ReaderBrokenCommunicationException If the communication with the reader has failed.
+     * @throw CardBrokenCommunicationException If the communication with the card has failed.
+     * @since 2.1.0
+     */
+    std::shared_ptr<Channel>
+    openChannel() {
+        static const uint8_t manageChannelOpen[] = {0x00, 0x70, 0x00, 0x00, 0x01};
+
+        std::lock_guard<std::mutex> lock(mLink->mutex);
+        const std::shared_ptr<CardResponseApi> cardResponse
+            = mLink->transmit(ByteSpan(manageChannelOpen, sizeof(manageChannelOpen)));
+
+        const ByteSpan dataOut = cardResponse->getApduResponses()[0]->getDataOutView();
+        const int channelNumber = dataOut.size() == 1 ? dataOut[0] : 0;
+        if (channelNumber < 1 || channelNumber > MAX_CHANNEL_NUMBER
+            || mLink->isOpen[channelNumber]) {
+            /* No channel to close if the number is missing or designates the basic channel */
+            if (channelNumber != 0) {
+                mLink->close(channelNumber);
+            }
+            throw std::runtime_error("Invalid logical channel number");
+        }
+        mLink->isOpen[channelNumber] = true;
+
+        return std::shared_ptr<Channel>(new Channel(mLink, channelNumber));
+    }
+
+    /**
+     * Gets the number of open logical channels.
+     *
+     * @return A value from 0 to MAX_CHANNEL_NUMBER.
+     * @since 2.1.0
+     */
+    std::size_t
+    getOpenChannelCount() const {
+        std::lock_guard<std::mutex> lock(mLink->mutex);
+
+        std::size_t count = 0;
+        for (int i = 1; i <= MAX_CHANNEL_NUMBER; i++) {
+            if (mLink->isOpen[i]) {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * Closes all the logical channels, then releases the physical channel of the reader.
+     *
+     * <p>The channels can no longer be used afterwards, but new ones may be opened.
+     *
+     * @since 2.1.0
+     */
+    void
+    releaseChannels() {
+        std::lock_guard<std::mutex> lock(mLink->mutex);
+        for (int i = 1; i <= MAX_CHANNEL_NUMBER; i++) {
+            if (mLink->isOpen[i]) {
+                mLink->close(i);
+            }
+        }
+        mLink->reader->releaseChannel();
+    }
+
+    /**
+     * Encodes a logical channel number in a class byte, as specified by ISO 7816-4.
+     *
+     * <p>Channels 0 to 3 use the first interindustry class (000X XXYY, YY being the channel
+     * number), channels 4 to 19 the further interindustry class (01XX ZZZZ, ZZZZ being the
+     * channel number minus 4). The command chaining and secure messaging indications of the
+     * provided class byte are kept, whichever of the two classes it uses, so that encoding is
+     * idempotent. A proprietary class byte (1XXX XXXXh) can only address the basic channel. The
+     * further interindustry class only indicates secure messaging as specified by ISO 7816-4,
+     * without header authentication: a proprietary or authenticated secure messaging can only
+     * address channels 0 to 3.
+     *
+     * @param cla The class byte, using the first or further interindustry class.
+     * @param channelNumber The channel number, from 0 to MAX_CHANNEL_NUMBER.
+     * @return The class byte addressing the channel.
+     * @throw std::invalid_argument If the channel number is out of range, or if the class byte
+     *        cannot address it (proprietary class, or proprietary secure messaging or header
+     *        authentication beyond channel 3).
+     * @since 2.1.0
+     */
+    static uint8_t
+    encodeClassByte(const uint8_t cla, const int channelNumber) {
+        if (channelNumber < 0 || channelNumber > MAX_CHANNEL_NUMBER) {
+            throw std::invalid_argument("Logical channel number out of range");
+        }
+        if ((cla & 0x80) != 0) {
+            if (channelNumber != 0) {
+                throw std::invalid_argument("Proprietary class byte on a logical channel");
+            }
+            return cla;
+        }
+
+        const uint8_t chaining = cla & 0x10;
+        /* Secure messaging bits of the first interindustry class (b4-b3) */
+        const uint8_t secureMessaging = (cla & 0x40) != 0 ? ((cla & 0x20) != 0 ? 0x08 : 0x00)
+                                                          : static_cast<uint8_t>(cla & 0x0C);
+        if (channelNumber <= 3) {
+            return static_cast<uint8_t>(chaining | secureMessaging | channelNumber);
+        }
+        if (secureMessaging == 0x04) {
+            throw std::invalid_argument("Proprietary secure messaging beyond logical channel 3");
+        }
+        if (secureMessaging == 0x0C) {
+            throw std::invalid_argument("Authenticated header beyond logical channel 3");
+        }
+
+        return static_cast<uint8_t>(
+            0x40 | (secureMessaging != 0 ? 0x20 : 0x00) | chaining | (channelNumber - 4));
+    }
+
+private:
+    /**
+     * Card request transmitted in place of the original one, addressing a logical channel.
+     *
+     * <p>When the original request provides a bulk access, its block is copied once with the
+     * class bytes rewritten, and the APDU requests are only built if the reader asks for them.
+     */
+    class ChannelCardRequest final : public spi::CardRequestSpi,
+                                     public spi::ApduChainingSpi,
+                                     public std::enable_shared_from_this<ChannelCardRequest> {
+    public:
+        ChannelCardRequest(
+            const std::shared_ptr<spi::CardRequestSpi>& cardRequest, const int channelNumber)
+        : mCardRequest(cardRequest)
+        , mChaining(cardRequest->getApduChaining())
+        , mChannelNumber(channelNumber)
+        , mIsApduRequestsBuilt(false) {
+            const spi::ApduSequenceView apduSequence = cardRequest->getApduSequence();
+            if (!apduSequence.empty()) {
+                const ByteSpan block = apduSequence.getBlock();
+                mBlock.assign(block.begin(), block.end());
+                for (std::size_t i = 0; i < apduSequence.size(); i++) {
+                    const std::size_t offset
+                        = static_cast<std::size_t>(apduSequence.getApdu(i).data() - block.data());
+                    mBlock[offset] = encodeClassByte(mBlock[offset], mChannelNumber);
+                }
+                mApduSequence = apduSequence.withBlock(mBlock.data());
+            }
+            /* The chaining compares the requests it receives with those of the list */
+            if (apduSequence.empty() || mChaining != nullptr) {
+                buildApduRequests();
+            }
+        }
+
+        /**
+         * {@inheritDoc}
+         *
+         * <p>The APDU requests are built on the first call, which must not be concurrent with
+         * another one.
+         */
+        const std::vector<std::shared_ptr<spi::ApduRequestSpi>>&
+        getApduRequests() const override {
+            if (!mIsApduRequestsBuilt) {
+                buildApduRequests();
+            }
+            return mApduRequests;
+        }
+
+        bool
+        stopOnUnsuccessfulStatusWord() const override {
+            return mCardRequest->stopOnUnsuccessfulStatusWord();
+        }
+
+        std::shared_ptr<spi::ApduResponseObserverSpi>
+        getApduResponseObserver() const override {
+            return mCardRequest->getApduResponseObserver();
+        }
+
+        std::shared_ptr<spi::ApduChainingSpi>
+        getApduChaining() const override {
+            if (mChaining == nullptr) {
+                return nullptr;
+            }
+            return std::const_pointer_cast<ChannelCardRequest>(shared_from_this());
+        }
+
+        spi::ApduSequenceView
+        getApduSequence() const override {
+            return mApduSequence;
+        }
+
+        std::chrono::steady_clock::time_point
+        getDeadline() const override {
+            return mCardRequest->getDeadline();
+        }
+
+        std::chrono::microseconds
+        getApduTimeout() const override {
+            return mCardRequest->getApduTimeout();
+        }
+
+        /**
+         * Calls the original chaining with the original requests, which it may compare with
+         * those it generated, then rewrites the next request for the channel.
+         */
+        std::shared_ptr<spi::ApduRequestSpi>
+        getNextApduRequest(
+            const std::shared_ptr<spi::ApduRequestSpi> previousApduRequest,
+            const std::shared_ptr<ApduResponseApi> previousApduResponse) override {
+            std::shared_ptr<spi::ApduRequestSpi> originalApduRequest = previousApduRequest;
+            if (previousApduRequest == mLastGeneratedApduRequest.second) {
+                originalApduRequest = mLastGeneratedApduRequest.first;
+            } else {
+                for (std::size_t i = 0; i < mApduRequests.size(); i++) {
+                    if (mApduRequests[i] == previousApduRequest) {
+                        originalApduRequest = mCardRequest->getApduRequests()[i];
+                        break;
+                    }
+                }
+            }
+
+            const std::shared_ptr<spi::ApduRequestSpi> nextApduRequest
+                = mChaining->getNextApduRequest(originalApduRequest, previousApduResponse);
+            mLastGeneratedApduRequest.first = nextApduRequest;
+            mLastGeneratedApduRequest.second
+                = nextApduRequest != nullptr ? toChannel(nextApduRequest) : nullptr;
+
+            return mLastGeneratedApduRequest.second;
+        }
+
+    private:
+        /**
+         * Copies the APDU requests of the original request for the channel.
+         */
+        void
+        buildApduRequests() const {
+            const std::vector<std::shared_ptr<spi::ApduRequestSpi>>& apduRequests
+                = mCardRequest->getApduRequests();
+            mApduRequests.reserve(apduRequests.size());
+            for (const auto& apduRequest : apduRequests) {
+                mApduRequests.push_back(toChannel(apduRequest));
+            }
+            mIsApduRequestsBuilt = true;
+        }
+
+        /**
+         * Copies an APDU request with the class byte of the channel.
+         */
+        std::shared_ptr<spi::ApduRequestSpi>
+        toChannel(const std::shared_ptr<spi::ApduRequestSpi>& apduRequest) const {
+            const spi::ApduCommand* const command = apduRequest->getSegmentedCommand();
+            if (command != nullptr) {
+                /* The data segments remain views on those of the original request */
+                const ByteSpan header = command->getHeader();
+                spi::ApduCommand channelCommand(
+                    encodeClassByte(header[0], mChannelNumber), header[1], header[2], header[3]);
+                for (const ByteSpan& segment : command->getDataSegments()) {
+                    channelCommand.addData(segment);
+                }
+                channelCommand.setLe(command->getLe());
+
+                auto channelApduRequest
+                    = std::make_shared<spi::SegmentedApduRequest>(std::move(channelCommand));
+                channelApduRequest
+                    ->setSuccessfulStatusWords(apduRequest->getSuccessfulStatusWordSet())
+                    .setInfo(apduRequest->getInfo());
+
+                return channelApduRequest;
+            }
+
+            const ByteSpan apdu = apduRequest->getApduView();
+            if (apdu.empty()) {
+                throw std::invalid_argument("Empty APDU");
+            }
+            auto channelApduRequest = std::make_shared<spi::ApduRequestAdapter>(apdu);
+            channelApduRequest->setSuccessfulStatusWords(apduRequest->getSuccessfulStatusWordSet())
+                .setInfo(apduRequest->getInfo());
+            std::vector<uint8_t>& channelApdu = channelApduRequest->getApdu();
+            channelApdu[0] = encodeClassByte(channelApdu[0], mChannelNumber);
+
+            return channelApduRequest;
+        }
+
+        const std::shared_ptr<spi::CardRequestSpi> mCardRequest;
+        const std::shared_ptr<spi::ApduChainingSpi> mChaining;
+        const int mChannelNumber;
+        std::vector<uint8_t> mBlock;
+        spi::ApduSequenceView mApduSequence;
+        mutable std::vector<std::shared_ptr<spi::ApduRequestSpi>> mApduRequests;
+        mutable bool mIsApduRequestsBuilt;
+
+        /**
+         * Last request generated by the original chaining, and its rewritten copy.
+         */
+        std::pair<std::shared_ptr<spi::ApduRequestSpi>, std::shared_ptr<spi::ApduRequestSpi>>
+            mLastGeneratedApduRequest;
+    };
+
+    /**
+     * Card response of the reader, shared or owned, reporting the state of the logical channel.
+     */
+    template <typename CardResponsePointer>
+    class ChannelCardResponse final : public CardResponseApi {
+    public:
+        ChannelCardResponse(CardResponsePointer cardResponse, const bool isLogicalChannelOpen)
+        : mCardResponse(std::move(cardResponse))
+        , mIsLogicalChannelOpen(isLogicalChannelOpen) {
+        }
+
+        const std::vector<std::shared_ptr<ApduResponseApi>>&
+        getApduResponses() const override {
+            return mCardResponse->getApduResponses();
+        }
+
+        bool
+        isLogicalChannelOpen() const override {
+            return mIsLogicalChannelOpen;
+        }
+
+        bool
+        isApduResponseSuccessful(const std::size_t index) const override {
+            return mCardResponse->isApduResponseSuccessful(index);
+        }
+
+        std::size_t
+        getApduRequestIndex(const std::size_t index) const override {
+            return mCardResponse->getApduRequestIndex(index);
+        }
+
+        CardResponseSummary
+        getSummary() const override {
+            return mCardResponse->getSummary();
+        }
+
+    private:
+        const CardResponsePointer mCardResponse;
+        const bool mIsLogicalChannelOpen;
+    };
+
+    /**
+     *
+     */
+    const std::shared_ptr<Link> mLink;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,38 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+namespace keypop {
+namespace card {
+
+/**
+ * Policy for processing a card selection scenario made of several selection cases.
+ *
+ * @see keypop::card::CardSelectionScenario
+ * @since 2.1.0
+ */
+enum class MultiSelectionProcessing {
+    /**
+     * Stops the processing after the first matching card selection case.
+     *
+     * @since 2.1.0
+     */
+    FIRST_MATCH,
+
+    /**
+     * Processes all the card selection cases, whatever their result.
+     *
+     * @since 2.1.0
+     */
+    PROCESS_ALL
+};
+
+} /* namespace card */
+} /* namespace keypop */
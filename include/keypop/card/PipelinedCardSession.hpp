@@ -0,0 +1,327 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "keypop/card/CardRequestAbortedException.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Pipeline of card requests transmitted back-to-back by a keypop::card::ProxyReaderApi.
+ *
+ * <p>Card requests are enqueued ahead and transmitted in order by a worker thread, so that the
+ * reader keeps exchanging APDUs while the application parses the previous responses and builds
+ * the next requests. Each request gets a future holding its card response, or the exception
+ * thrown by keypop::card::ProxyReaderApi::transmitCardRequest().
+ *
+ * <p>A request is usually built assuming the previous ones succeeded: once a request fails (e.g.
+ * with keypop::card::UnexpectedStatusWordException), the requests queued after it are not
+ * transmitted and their futures fail with keypop::card::CardRequestAbortedException. If one of
+ * them requested keypop::card::ChannelControl::CLOSE_AFTER, the channel is released before their
+ * futures fail. The session is then aborted: the requests enqueued afterwards fail the same way,
+ * without any exchange with the reader, until resume() is called, typically once the application
+ * has handled the failure. An aborted request requesting keypop::card::ChannelControl::CLOSE_AFTER
+ * (e.g. the closing request of a transaction, built while the failing one was in flight) is still
+ * handed to the worker, which releases the channel in order before failing its future.
+ *
+ * <p>The reader must not be used by other components while the session is alive. This class is
+ * thread safe.
+ *
+ * @since 2.1.0
+ */
+class PipelinedCardSession final {
+public:
+    /**
+     * Builds a session and starts its worker.
+     *
+     * @param reader The reader (not null).
+     * @throw std::invalid_argument If the reader is null.
+     * @since 2.1.0
+     */
+    explicit PipelinedCardSession(const std::shared_ptr<ProxyReaderApi>& reader)
+    : mReader(reader)
+    , mIsClosing(false)
+    , mIsAborted(false) {
+        if (reader == nullptr) {
+            throw std::invalid_argument("Null reader");
+        }
+        mThread = std::thread(&PipelinedCardSession::run, this);
+    }
+
+    /**
+     *
+     */
+    PipelinedCardSession(const PipelinedCardSession&) = delete;
+
+    /**
+     *
+     */
+    PipelinedCardSession& operator=(const PipelinedCardSession&) = delete;
+
+    /**
+     * Closes the session (see close()).
+     *
+     * @since 2.1.0
+     */
+    ~PipelinedCardSession() {
+        close();
+    }
+
+    /**
+     * Enqueues a card request, to be transmitted after the ones already enqueued.
+     *
+     * @param cardRequest The card request (not null).
+     * @param channelControl The channel control policy to apply.
+     * @return A future holding the card response, or the exception thrown by the reader, or a
+     *         keypop::card::CardRequestAbortedException if a previous request failed.
+     * @throw std::logic_error If the session is closed.
+     * @since 2.1.0
+     */
+    std::future<std::shared_ptr<CardResponseApi>>
+    enqueue(
+        const std::shared_ptr<spi::CardRequestSpi>& cardRequest,
+        const ChannelControl channelControl) {
+        Job job(cardRequest, channelControl);
+        std::future<std::shared_ptr<CardResponseApi>> future = job.promise.get_future();
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (mIsClosing) {
+            throw std::logic_error("Session closed");
+        }
+        if (mIsAborted) {
+            if (channelControl != ChannelControl::CLOSE_AFTER) {
+                lock.unlock();
+                abort(job);
+                return future;
+            }
+            /* Only the worker uses the reader, the channel is released in order */
+            job.isAborted = true;
+        }
+        mJobs.push_back(std::move(job));
+        mCondition.notify_one();
+
+        return future;
+    }
+
+    /**
+     * Indicates if a request failed since the creation of the session or the last call to
+     * resume().
+     *
+     * @return True if the requests enqueued now are aborted.
+     * @since 2.1.0
+     */
+    bool
+    isAborted() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mIsAborted;
+    }
+
+    /**
+     * Accepts requests again after a failure.
+     *
+     * <p>The requests queued at the time of the failure remain aborted.
+     *
+     * @since 2.1.0
+     */
+    void
+    resume() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsAborted = false;
+    }
+
+    /**
+     * Gets the number of requests enqueued and not yet taken by the worker.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getPendingCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mJobs.size();
+    }
+
+    /**
+     * Stops accepting requests, processes the requests already enqueued and stops the worker.
+     *
+     * <p>This method blocks until the worker is stopped. It must not be called from the worker
+     * (e.g. from an observer of a card request).
+     *
+     * @since 2.1.0
+     */
+    void
+    close() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mIsClosing = true;
+            mCondition.notify_one();
+        }
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+    }
+
+private:
+    /**
+     *
+     */
+    struct Job {
+        Job(const std::shared_ptr<spi::CardRequestSpi>& cardRequest,
+            const ChannelControl channelControl)
+        : cardRequest(cardRequest)
+        , channelControl(channelControl)
+        , isAborted(false) {
+        }
+
+        std::shared_ptr<spi::CardRequestSpi> cardRequest;
+        ChannelControl channelControl;
+        bool isAborted;
+        std::promise<std::shared_ptr<CardResponseApi>> promise;
+    };
+
+    /**
+     *
+     */
+    static void
+    abort(Job& job) {
+        job.promise.set_exception(std::make_exception_ptr(CardRequestAbortedException(
+            std::make_shared<CardResponseAdapter>(),
+            false,
+            "Card request aborted after the failure of a previous one")));
+    }
+
+    /**
+     * Releases the channel if one of the aborted requests was expected to close it.
+     */
+    void
+    releaseChannelIfRequested(const std::deque<Job>& abortedJobs) {
+        for (const auto& abortedJob : abortedJobs) {
+            if (abortedJob.channelControl == ChannelControl::CLOSE_AFTER) {
+                releaseChannel();
+                return;
+            }
+        }
+    }
+
+    /**
+     * Releases the channel on behalf of aborted requests.
+     */
+    void
+    releaseChannel() {
+        try {
+            mReader->releaseChannel();
+        } catch (...) {
+            /* The failure of the session is already reported */
+        }
+    }
+
+    /**
+     * Transmits the queued requests until the session is closed.
+     */
+    void
+    run() {
+        for (;;) {
+            std::unique_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this]() { return !mJobs.empty() || mIsClosing; });
+                if (mJobs.empty()) {
+                    return;
+                }
+                job.reset(new Job(std::move(mJobs.front())));
+                mJobs.pop_front();
+            }
+
+            if (job->isAborted) {
+                releaseChannel();
+                abort(*job);
+                continue;
+            }
+
+            std::shared_ptr<CardResponseApi> cardResponse;
+            try {
+                cardResponse = mReader->transmitCardRequest(job->cardRequest, job->channelControl);
+            } catch (...) {
+                const std::exception_ptr exception = std::current_exception();
+                std::deque<Job> abortedJobs;
+                {
+                    /* Aborted before the failure is visible through the future */
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mIsAborted = true;
+                    abortedJobs.swap(mJobs);
+                }
+                job->promise.set_exception(exception);
+                releaseChannelIfRequested(abortedJobs);
+                for (auto& abortedJob : abortedJobs) {
+                    abort(abortedJob);
+                }
+                continue;
+            }
+            job->promise.set_value(cardResponse);
+        }
+    }
+
+    /**
+     *
+     */
+    const std::shared_ptr<ProxyReaderApi> mReader;
+
+    /**
+     * Guards the queue and the flags.
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     *
+     */
+    std::condition_variable mCondition;
+
+    /**
+     *
+     */
+    std::deque<Job> mJobs;
+
+    /**
+     *
+     */
+    bool mIsClosing;
+
+    /**
+     *
+     */
+    bool mIsAborted;
+
+    /**
+     *
+     */
+    std::thread mThread;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -9,11 +9,18 @@
 
 #pragma once
 
+#include <cstddef>
+#include <exception>
 #include <memory>
+#include <utility>
+#include <vector>
 
-#include "keypop/card/CardRequestSpi.hpp"
 #include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardTransmitResult.hpp"
+#include "keypop/card/CardTransmitStatus.hpp"
 #include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+#include "keypop/card/spi/CardResponseCallbackSpi.hpp"
 
 namespace keypop {
 namespace card {
@@ -45,6 +52,10 @@ public:
      * keypop::card::CardRequestSpi are sent to the card, their responses
      * (keypop::card::ApduResponseApi) are added to a new list (keypop::card::CardResponseApi).
      *
+     * <p>If the request provides an observer (see
+     * keypop::card::spi::CardRequestSpi::getApduResponseObserver()), each response is also
+     * notified to it as soon as it is received.
+     *
      * <p><b>Note:</b> in case of an error when sending an APDU (communication error, unexpected
      * status word), an keypop::card::AbstractApduException exception is thrown. Any responses from
      * previously transmitted APDU commands are attached to this exception.<br>
@@ -61,12 +72,152 @@ public:
      * @throw CardBrokenCommunicationException If the communication with the card has failed.
      * @throw UnexpectedStatusWordException If any of the APDUs returned an unexpected status word
      *        and the card request specified the need to check them.
+     * @throw CardRequestTimeoutException If the deadline of the request or the timeout of an APDU
+     *        expired (since 2.1.0).
      * @since 1.0.0
      */
     virtual const std::shared_ptr<CardResponseApi> transmitCardRequest(
-        const std::shared_ptr<CardRequestSpi> cardRequest, const ChannelControl channelControl)
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl)
         = 0;
 
+    /**
+     * Transmits a keypop::card::CardRequestSpi owned by the caller, applies the provided
+     * keypop::card::ChannelControl policy and returns a keypop::card::CardResponseApi owned by the
+     * caller.
+     *
+     * <p>This overload is intended for single-owner pipelines: the request is passed by reference
+     * and the response is returned as a <b>std::unique_ptr</b>, so no reference counting is
+     * involved across the reader layers. The processing and the exceptions are the same as with
+     * the <b>std::shared_ptr</b> based overload. The reader must not retain the request after the
+     * call.
+     *
+     * <p>The default implementation is only a compatibility shim for the readers written before
+     * this overload: it delegates to the <b>std::shared_ptr</b> based overload through a
+     * non-owning pointer to the request and returns a thin wrapper taking over the shared
+     * response, so the reference counting is not avoided. Readers should override it to build the
+     * response directly, and decorators to forward the request to this overload of the decorated
+     * reader (see borrowCardRequest()).
+     *
+     * <p><b>Note:</b> an adapter overriding only one of the overloads should bring the other one
+     * into scope with a <b>using</b> declaration.
+     *
+     * @param cardRequest The card request.
+     * @param channelControl The channel control policy to apply.
+     * @return A not null reference.
+     * @throw ReaderBrokenCommunicationException If the communication with the reader has failed.
+     * @throw CardBrokenCommunicationException If the communication with the card has failed.
+     * @throw UnexpectedStatusWordException If any of the APDUs returned an unexpected status word
+     *        and the card request specified the need to check them.
+     * @throw CardRequestTimeoutException If the deadline of the request or the timeout of an APDU
+     *        expired.
+     * @since 2.1.0
+     */
+    virtual std::unique_ptr<CardResponseApi>
+    transmitCardRequest(
+        const spi::CardRequestSpi& cardRequest, const ChannelControl channelControl) {
+        return std::unique_ptr<CardResponseApi>(new SharedCardResponse(
+            transmitCardRequest(borrowCardRequest(cardRequest), channelControl)));
+    }
+
+    /**
+     * Transmits a keypop::card::CardRequestSpi and applies the provided
+     * keypop::card::ChannelControl policy without throwing exceptions on the expected failures.
+     *
+     * <p>The processing is the same as with transmitCardRequest(), but an unexpected status word
+     * or a communication failure is reported through the returned
+     * keypop::card::CardTransmitResult, which carries the partial response, instead of a
+     * keypop::card::AbstractApduException. This is intended for callers for which such outcomes
+     * are routine (e.g. a blacklisted card answering with a warning status word), to keep them off
+     * the exception handling path.
+     *
+     * <p>The default implementation calls transmitCardRequest() and converts the
+     * keypop::card::AbstractApduException thrown, if any, into a result. Readers should override
+     * it to avoid throwing at all, and may then implement transmitCardRequest() with
+     * keypop::card::CardTransmitResult::throwIfUnsuccessful().
+     *
+     * @param cardRequest The card request.
+     * @param channelControl The channel control policy to apply.
+     * @return A result holding a not null card response.
+     * @since 2.1.0
+     */
+    virtual CardTransmitResult
+    tryTransmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) {
+        try {
+            return CardTransmitResult(
+                CardTransmitStatus::SUCCESSFUL,
+                transmitCardRequest(cardRequest, channelControl),
+                true);
+        } catch (UnexpectedStatusWordException& e) {
+            return CardTransmitResult(
+                CardTransmitStatus::UNEXPECTED_STATUS_WORD,
+                e.getCardResponse(),
+                e.isCardResponseComplete());
+        } catch (CardBrokenCommunicationException& e) {
+            return CardTransmitResult(
+                CardTransmitStatus::CARD_BROKEN_COMMUNICATION,
+                e.getCardResponse(),
+                e.isCardResponseComplete());
+        } catch (ReaderBrokenCommunicationException& e) {
+            return CardTransmitResult(
+                CardTransmitStatus::READER_BROKEN_COMMUNICATION,
+                e.getCardResponse(),
+                e.isCardResponseComplete());
+        } catch (CardRequestTimeoutException& e) {
+            return CardTransmitResult(
+                CardTransmitStatus::TIMEOUT, e.getCardResponse(), e.isCardResponseComplete());
+        }
+    }
+
+    /**
+     * Transmits a keypop::card::CardRequestSpi asynchronously, applies the provided
+     * keypop::card::ChannelControl policy and notifies the result to the provided callback.
+     *
+     * <p>The processing of the card request is the same as with transmitCardRequest(), but the
+     * calling thread is not blocked during the exchanges with the card: the method returns as soon
+     * as the request is queued, so that a single thread can drive several readers.
+     *
+     * <p>The following rules apply:
+     * <ul>
+     * <li>Exactly one method of the callback is invoked for each call.
+     * <li>In case of failure, the exception that transmitCardRequest() would have thrown is
+     *     provided to keypop::card::spi::CardResponseCallbackSpi::onCardRequestFailure(). The
+     *     partial response carried by a keypop::card::AbstractApduException is therefore
+     *     preserved.
+     * <li>The channel control policy is applied under the same conditions as with
+     *     transmitCardRequest(), before the callback is invoked. In particular, with
+     *     keypop::card::ChannelControl::CLOSE_AFTER the physical channel is closed (or the removal
+     *     sequence is started) when the callback is called, so the callback may immediately
+     *     submit a new request.
+     * <li>Requests submitted to the same reader are processed one at a time, in submission order.
+     * </ul>
+     *
+     * <p>The default implementation is synchronous: it calls transmitCardRequest() and invokes the
+     * callback on the calling thread before returning. Readers able to perform non blocking
+     * exchanges should override it.
+     *
+     * @param cardRequest The card request.
+     * @param channelControl The channel control policy to apply.
+     * @param callback The callback to notify (not null).
+     * @since 2.1.0
+     */
+    virtual void
+    transmitCardRequestAsync(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl,
+        const std::shared_ptr<spi::CardResponseCallbackSpi> callback) {
+        std::shared_ptr<CardResponseApi> cardResponse;
+        try {
+            cardResponse = transmitCardRequest(cardRequest, channelControl);
+        } catch (...) {
+            callback->onCardRequestFailure(std::current_exception());
+            return;
+        }
+        callback->onCardResponse(cardResponse);
+    }
+
     /**
      * Releases the communication channel previously established with the card.
      *
@@ -74,6 +225,88 @@ public:
      * @since 1.0.0
      */
     virtual void releaseChannel() = 0;
+
+protected:
+    /**
+     * Gets a non-owning <b>std::shared_ptr</b> to a card request passed by reference, for the
+     * components expecting one.
+     *
+     * <p>The returned reference has no control block, so copying it involves no reference
+     * counting. It must not be used once the call receiving the request returns.
+     *
+     * @param cardRequest The card request.
+     * @return A not null reference, not owning the request.
+     * @since 2.1.0
+     */
+    static std::shared_ptr<spi::CardRequestSpi>
+    borrowCardRequest(const spi::CardRequestSpi& cardRequest) {
+        /* Aliasing constructor with an empty owner. The const_cast is harmless since
+         * keypop::card::spi::CardRequestSpi only has const methods. */
+        return std::shared_ptr<spi::CardRequestSpi>(
+            std::shared_ptr<spi::CardRequestSpi>(),
+            const_cast<spi::CardRequestSpi*>(&cardRequest));
+    }
+
+private:
+    /**
+     * Card response owned by the caller forwarding to a shared card response, so that the
+     * responses and their summary are returned as built by the reader.
+     */
+    class SharedCardResponse final : public CardResponseApi {
+    public:
+        /**
+         *
+         */
+        explicit SharedCardResponse(std::shared_ptr<CardResponseApi> cardResponse)
+        : mCardResponse(std::move(cardResponse)) {
+        }
+
+        /**
+         *
+         */
+        const std::vector<std::shared_ptr<ApduResponseApi>>&
+        getApduResponses() const override {
+            return mCardResponse->getApduResponses();
+        }
+
+        /**
+         *
+         */
+        bool
+        isLogicalChannelOpen() const override {
+            return mCardResponse->isLogicalChannelOpen();
+        }
+
+        /**
+         *
+         */
+        bool
+        isApduResponseSuccessful(const std::size_t index) const override {
+            return mCardResponse->isApduResponseSuccessful(index);
+        }
+
+        /**
+         *
+         */
+        std::size_t
+        getApduRequestIndex(const std::size_t index) const override {
+            return mCardResponse->getApduRequestIndex(index);
+        }
+
+        /**
+         *
+         */
+        CardResponseSummary
+        getSummary() const override {
+            return mCardResponse->getSummary();
+        }
+
+    private:
+        /**
+         *
+         */
+        const std::shared_ptr<CardResponseApi> mCardResponse;
+    };
 };
 
 } /* namespace card */
@@ -0,0 +1,330 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "keypop/card/AbstractApduException.hpp"
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/CardBrokenCommunicationException.hpp"
+#include "keypop/card/CardRequestTimeoutException.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardTraceEntry.hpp"
+#include "keypop/card/CardTraceRing.hpp"
+#include "keypop/card/CardTransmitResult.hpp"
+#include "keypop/card/CardTransmitStatus.hpp"
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+#include "keypop/card/UnexpectedStatusWordException.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+#include "keypop/card/spi/ReaderBrokenCommunicationException.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Decorator of any keypop::card::ProxyReaderApi recording each card request and card response
+ * pair into a keypop::card::CardTraceRing.
+ *
+ * <p>Each transmission, successful or not, is stored as a keypop::card::CardTraceEntry holding its
+ * timestamp, duration, channel control, outcome, APDU commands and APDU responses (the partial
+ * response in case of failure). Exceptions not belonging to this API are not recorded. The trace
+ * can be replayed with a keypop::card::ReplayProxyReader.
+ *
+ * <p>A record larger than the ring is dropped, the transmission itself being unaffected; the
+ * dropped records are counted (see getDroppedRecordCount()).
+ *
+ * <p>Transmitting asynchronously through this decorator blocks the calling thread (see the default
+ * implementation of keypop::card::ProxyReaderApi::transmitCardRequestAsync()).
+ *
+ * <p>This class is thread safe if the decorated reader is: the records are appended under a lock
+ * owned by the recorder. Hence a ring must not be shared between several recorders, nor written
+ * by the application while a recorder uses it.
+ *
+ * @since 2.1.0
+ */
+class RecordingProxyReader final : public ProxyReaderApi {
+public:
+    using ProxyReaderApi::transmitCardRequest;
+
+    /**
+     * Builds a new recorder.
+     *
+     * @param reader The decorated reader (not null).
+     * @param ring The ring receiving the records (not null), used by this recorder only.
+     * @throw std::invalid_argument If the reader or the ring is null.
+     * @since 2.1.0
+     */
+    RecordingProxyReader(
+        const std::shared_ptr<ProxyReaderApi>& reader, const std::shared_ptr<CardTraceRing>& ring)
+    : mReader(reader)
+    , mRing(ring)
+    , mDroppedRecordCount(0) {
+        if (reader == nullptr) {
+            throw std::invalid_argument("Null reader");
+        }
+        if (ring == nullptr) {
+            throw std::invalid_argument("Null ring");
+        }
+    }
+
+    /**
+     * Gets the number of transmissions not recorded because their record was larger than the
+     * ring.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getDroppedRecordCount() const {
+        return mDroppedRecordCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::shared_ptr<CardResponseApi>
+    transmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        const Start start;
+        std::shared_ptr<CardResponseApi> cardResponse;
+        try {
+            cardResponse = mReader->transmitCardRequest(cardRequest, channelControl);
+        } catch (AbstractApduException& e) {
+            record(start, *cardRequest, channelControl, e);
+            throw;
+        }
+        record(
+            start,
+            *cardRequest,
+            channelControl,
+            CardTransmitStatus::SUCCESSFUL,
+            cardResponse.get(),
+            true);
+
+        return cardResponse;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The card request is forwarded to the same overload of the decorated reader.
+     *
+     * @since 2.1.0
+     */
+    std::unique_ptr<CardResponseApi>
+    transmitCardRequest(
+        const spi::CardRequestSpi& cardRequest, const ChannelControl channelControl) override {
+        const Start start;
+        std::unique_ptr<CardResponseApi> cardResponse;
+        try {
+            cardResponse = mReader->transmitCardRequest(cardRequest, channelControl);
+        } catch (AbstractApduException& e) {
+            record(start, cardRequest, channelControl, e);
+            throw;
+        }
+        record(
+            start,
+            cardRequest,
+            channelControl,
+            CardTransmitStatus::SUCCESSFUL,
+            cardResponse.get(),
+            true);
+
+        return cardResponse;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    CardTransmitResult
+    tryTransmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        const Start start;
+        const CardTransmitResult result
+            = mReader->tryTransmitCardRequest(cardRequest, channelControl);
+        record(
+            start,
+            *cardRequest,
+            channelControl,
+            result.getStatus(),
+            result.getCardResponse().get(),
+            result.isCardResponseComplete());
+
+        return result;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void
+    releaseChannel() override {
+        mReader->releaseChannel();
+    }
+
+private:
+    /**
+     * Start time of a transmission.
+     */
+    struct Start {
+        Start()
+        : timestamp(std::chrono::system_clock::now())
+        , time(std::chrono::steady_clock::now()) {
+        }
+
+        const std::chrono::system_clock::time_point timestamp;
+        const std::chrono::steady_clock::time_point time;
+    };
+
+    /**
+     * Gets the status corresponding to an exception thrown by the decorated reader.
+     */
+    static CardTransmitStatus
+    getStatus(const AbstractApduException& e) {
+        if (dynamic_cast<const UnexpectedStatusWordException*>(&e) != nullptr) {
+            return CardTransmitStatus::UNEXPECTED_STATUS_WORD;
+        }
+        if (dynamic_cast<const CardBrokenCommunicationException*>(&e) != nullptr) {
+            return CardTransmitStatus::CARD_BROKEN_COMMUNICATION;
+        }
+        if (dynamic_cast<const CardRequestTimeoutException*>(&e) != nullptr) {
+            return CardTransmitStatus::TIMEOUT;
+        }
+
+        return CardTransmitStatus::READER_BROKEN_COMMUNICATION;
+    }
+
+    /**
+     * Records a transmission which failed with an exception of the decorated reader.
+     */
+    void
+    record(
+        const Start& start,
+        const spi::CardRequestSpi& cardRequest,
+        const ChannelControl channelControl,
+        AbstractApduException& e) {
+        record(
+            start,
+            cardRequest,
+            channelControl,
+            getStatus(e),
+            e.getCardResponse().get(),
+            e.isCardResponseComplete());
+    }
+
+    /**
+     *
+     */
+    void
+    record(
+        const Start& start,
+        const spi::CardRequestSpi& cardRequest,
+        const ChannelControl channelControl,
+        const CardTransmitStatus status,
+        const CardResponseApi* const cardResponse,
+        const bool isCardResponseComplete) {
+        const std::chrono::steady_clock::duration duration
+            = std::chrono::steady_clock::now() - start.time;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        /* The entry and the encoding buffer are reused to limit the allocations */
+        mEntry.timestamp = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                start.timestamp.time_since_epoch())
+                .count());
+        mEntry.duration = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        mEntry.channelControl = channelControl;
+        mEntry.status = status;
+        mEntry.stopOnUnsuccessfulStatusWord = cardRequest.stopOnUnsuccessfulStatusWord();
+        mEntry.isCardResponseComplete = isCardResponseComplete;
+
+        const std::vector<std::shared_ptr<spi::ApduRequestSpi>>& apduRequests
+            = cardRequest.getApduRequests();
+        mEntry.apduRequests.resize(apduRequests.size());
+        for (std::size_t i = 0; i < apduRequests.size(); i++) {
+            CardTraceEntry::getApduRequestBytes(*apduRequests[i], mEntry.apduRequests[i]);
+        }
+
+        if (cardResponse != nullptr) {
+            const std::vector<std::shared_ptr<ApduResponseApi>>& apduResponses
+                = cardResponse->getApduResponses();
+            mEntry.isLogicalChannelOpen = cardResponse->isLogicalChannelOpen();
+            mEntry.apduResponses.resize(apduResponses.size());
+            mEntry.apduResponseSuccesses.resize(apduResponses.size());
+            mEntry.apduRequestIndexes.resize(apduResponses.size());
+            for (std::size_t i = 0; i < apduResponses.size(); i++) {
+                const ByteSpan apdu = apduResponses[i]->getApduView();
+                mEntry.apduResponses[i].assign(apdu.begin(), apdu.end());
+                mEntry.apduResponseSuccesses[i] = cardResponse->isApduResponseSuccessful(i);
+                mEntry.apduRequestIndexes[i] = cardResponse->getApduRequestIndex(i);
+            }
+        } else {
+            mEntry.isLogicalChannelOpen = false;
+            mEntry.apduResponses.clear();
+            mEntry.apduResponseSuccesses.clear();
+            mEntry.apduRequestIndexes.clear();
+        }
+
+        mEntry.encode(mRecord);
+        if (!mRing->append(ByteSpan(mRecord))) {
+            mDroppedRecordCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     *
+     */
+    const std::shared_ptr<ProxyReaderApi> mReader;
+
+    /**
+     *
+     */
+    const std::shared_ptr<CardTraceRing> mRing;
+
+    /**
+     *
+     */
+    std::atomic<std::size_t> mDroppedRecordCount;
+
+    /**
+     *
+     */
+    std::mutex mMutex;
+
+    /**
+     *
+     */
+    CardTraceEntry mEntry;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mRecord;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,293 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardTraceEntry.hpp"
+#include "keypop/card/CardTraceRing.hpp"
+#include "keypop/card/CardTransmitResult.hpp"
+#include "keypop/card/CardTransmitStatus.hpp"
+#include "keypop/card/ChannelControl.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+#include "keypop/card/spi/ApduResponseObserverSpi.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+#include "keypop/card/spi/ReaderBrokenCommunicationException.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Implementation of keypop::card::ProxyReaderApi feeding back a recorded trace (see
+ * keypop::card::RecordingProxyReader).
+ *
+ * <p>Each transmitted card request consumes the next entry of the trace: the recorded APDU
+ * responses are returned (and notified to the observer of the request, if any, with the recorded
+ * request indexes) and the recorded outcome is reproduced, an unexpected status word or a
+ * communication failure being thrown with the recorded partial response. No time is spent
+ * waiting: the recorded durations are ignored. This allows production sessions to be reproduced
+ * deterministically, and parsers to be tested or benchmarked against real traffic.
+ *
+ * <p>In strict mode (default), the APDU commands of each card request must be those of the
+ * entry.
+ *
+ * <p>This class is thread safe, the entries being consumed in order.
+ *
+ * @since 2.1.0
+ */
+class ReplayProxyReader final : public ProxyReaderApi {
+public:
+    using ProxyReaderApi::transmitCardRequest;
+
+    /**
+     * Builds a reader replaying the provided entries.
+     *
+     * @param entries The entries, in transmission order.
+     * @since 2.1.0
+     */
+    explicit ReplayProxyReader(std::vector<CardTraceEntry> entries)
+    : mEntries(std::move(entries))
+    , mNextIndex(0)
+    , mIsStrict(true) {
+    }
+
+    /**
+     * Builds a reader replaying the records of a ring.
+     *
+     * @param ring The ring holding encoded keypop::card::CardTraceEntry records.
+     * @throw std::invalid_argument If a record is malformed.
+     * @since 2.1.0
+     */
+    explicit ReplayProxyReader(const CardTraceRing& ring)
+    : mNextIndex(0)
+    , mIsStrict(true) {
+        ring.forEachRecord([this](const ByteSpan record) {
+            mEntries.push_back(CardTraceEntry::decode(record));
+        });
+    }
+
+    /**
+     * Enables or disables the check of the APDU commands against the trace.
+     *
+     * @param isStrict True to throw if a card request differs from the trace.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    ReplayProxyReader&
+    setStrict(const bool isStrict) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStrict = isStrict;
+
+        return *this;
+    }
+
+    /**
+     * Gets the number of entries not replayed yet.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getRemainingCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mEntries.size() - mNextIndex;
+    }
+
+    /**
+     * Restarts the replay from the first entry.
+     *
+     * @since 2.1.0
+     */
+    void
+    rewind() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mNextIndex = 0;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @throw std::invalid_argument In strict mode, if the card request differs from the trace.
+     * @since 2.1.0
+     */
+    const std::shared_ptr<CardResponseApi>
+    transmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        const CardTransmitResult result = tryTransmitCardRequest(cardRequest, channelControl);
+        result.throwIfUnsuccessful();
+
+        return result.getCardResponse();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The end of the trace is reported as a reader communication failure.
+     *
+     * @throw std::invalid_argument In strict mode, if the card request differs from the trace.
+     * @since 2.1.0
+     */
+    CardTransmitResult
+    tryTransmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        (void)channelControl;
+
+        const std::shared_ptr<CardResponseAdapter> cardResponse
+            = std::make_shared<CardResponseAdapter>();
+        bool isCardResponseComplete = false;
+        const CardTransmitStatus status
+            = replay(*cardRequest, *cardResponse, isCardResponseComplete);
+
+        return CardTransmitResult(status, cardResponse, isCardResponseComplete);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The card response is built directly for the caller.
+     *
+     * @throw std::invalid_argument In strict mode, if the card request differs from the trace.
+     * @since 2.1.0
+     */
+    std::unique_ptr<CardResponseApi>
+    transmitCardRequest(
+        const spi::CardRequestSpi& cardRequest, const ChannelControl channelControl) override {
+        (void)channelControl;
+
+        std::unique_ptr<CardResponseAdapter> cardResponse(new CardResponseAdapter());
+        bool isCardResponseComplete = false;
+        const CardTransmitStatus status
+            = replay(cardRequest, *cardResponse, isCardResponseComplete);
+        if (status != CardTransmitStatus::SUCCESSFUL) {
+            CardTransmitResult(
+                status,
+                std::shared_ptr<CardResponseApi>(std::move(cardResponse)),
+                isCardResponseComplete)
+                .throwIfUnsuccessful();
+        }
+
+        return std::unique_ptr<CardResponseApi>(std::move(cardResponse));
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>Does nothing.
+     *
+     * @since 2.1.0
+     */
+    void
+    releaseChannel() override {
+    }
+
+private:
+    /**
+     * Replays the next entry for a card request, filling the provided card response.
+     */
+    CardTransmitStatus
+    replay(
+        const spi::CardRequestSpi& cardRequest,
+        CardResponseAdapter& cardResponse,
+        bool& isCardResponseComplete) {
+        const CardTraceEntry* const entry = next(cardRequest);
+        if (entry == nullptr) {
+            return CardTransmitStatus::READER_BROKEN_COMMUNICATION;
+        }
+
+        const std::shared_ptr<spi::ApduResponseObserverSpi> observer
+            = cardRequest.getApduResponseObserver();
+        cardResponse.reserve(entry->apduResponses.size());
+        for (std::size_t i = 0; i < entry->apduResponses.size(); i++) {
+            const std::shared_ptr<ApduResponseApi> apduResponse
+                = std::make_shared<ApduResponseAdapter>(ByteSpan(entry->apduResponses[i]));
+            const std::size_t apduRequestIndex
+                = i < entry->apduRequestIndexes.size() ? entry->apduRequestIndexes[i] : i;
+            cardResponse.addApduResponse(
+                apduResponse,
+                i < entry->apduResponseSuccesses.size() && entry->apduResponseSuccesses[i],
+                apduRequestIndex);
+            if (observer != nullptr) {
+                observer->onApduResponse(apduRequestIndex, apduResponse);
+            }
+        }
+        cardResponse.setLogicalChannelOpen(entry->isLogicalChannelOpen);
+        isCardResponseComplete = entry->isCardResponseComplete;
+
+        return entry->status;
+    }
+
+    /**
+     * Gets the next entry, checking it against the card request in strict mode.
+     */
+    const CardTraceEntry*
+    next(const spi::CardRequestSpi& cardRequest) {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mNextIndex >= mEntries.size()) {
+            return nullptr;
+        }
+        const CardTraceEntry& entry = mEntries[mNextIndex];
+        if (mIsStrict) {
+            const std::vector<std::shared_ptr<spi::ApduRequestSpi>>& apduRequests
+                = cardRequest.getApduRequests();
+            bool isMatching = apduRequests.size() == entry.apduRequests.size();
+            for (std::size_t i = 0; isMatching && i < apduRequests.size(); i++) {
+                CardTraceEntry::getApduRequestBytes(*apduRequests[i], mApduRequestBytes);
+                isMatching = mApduRequestBytes == entry.apduRequests[i];
+            }
+            if (!isMatching) {
+                throw std::invalid_argument("Card request differs from the trace");
+            }
+        }
+        mNextIndex++;
+
+        return &entry;
+    }
+
+    /**
+     *
+     */
+    std::vector<CardTraceEntry> mEntries;
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     *
+     */
+    std::size_t mNextIndex;
+
+    /**
+     *
+     */
+    bool mIsStrict;
+
+    /**
+     * Buffer reused to compare the APDU requests with the trace, protected by mMutex.
+     */
+    std::vector<uint8_t> mApduRequestBytes;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,397 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace keypop {
+namespace card {
+
+/**
+ * Pool of recyclable objects handed out as <b>std::shared_ptr</b>.
+ *
+ * <p>An object returns to the pool as soon as the last <b>std::shared_ptr</b> obtained from
+ * acquire() is dropped: the returned references carry a deleter resetting the object instead of
+ * destroying it, so there is no explicit release call.
+ *
+ * <p>Each pooled object lives in a slot which also provides the storage of the control block of
+ * the references returned by acquire() (through the allocator given to <b>std::shared_ptr</b>).
+ * Acquiring a recycled object therefore involves no heap allocation at all: the object, the
+ * storage it keeps (e.g. response buffers) and the control block are all reused. Acquiring and
+ * releasing an object each take the lock of the pool once.
+ *
+ * <p>A slot returns to the pool only once its control block is released, i.e. when the
+ * <b>std::weak_ptr</b> taken on the object are gone too. These <b>std::weak_ptr</b> expire when
+ * the object is reset, so they never observe it once recycled.
+ *
+ * <p><b>Reset contract:</b> <b>T</b> must provide a <b>void reset()</b> method, which must not
+ * throw, restoring the object to its initial state while keeping its allocated capacity. The pool
+ * calls it as soon as the last reference is dropped, so that the references it holds (e.g. to
+ * pooled sub-objects) are released at once.
+ *
+ * <p>The objects released after the destruction of the pool are destroyed. This class is thread
+ * safe: objects may be released from any thread.
+ *
+ * @tparam T The type of the pooled objects.
+ * @since 2.1.0
+ */
+template <typename T>
+class SharedObjectPool final {
+public:
+    /**
+     * Builds a new pool.
+     *
+     * @param factory The function creating a new object when none is available.
+     * @param maxSize The maximum number of idle objects retained by the pool; objects released
+     *        beyond this limit are destroyed.
+     * @since 2.1.0
+     */
+    explicit SharedObjectPool(
+        const std::function<std::unique_ptr<T>()>& factory, const std::size_t maxSize = 64)
+    : mFactory(factory)
+    , mSlots(new Slots(maxSize)) {
+    }
+
+    /**
+     * Destroys the idle objects; the objects still in use are destroyed once released.
+     *
+     * @since 2.1.0
+     */
+    ~SharedObjectPool() {
+        mSlots->close();
+    }
+
+    /**
+     *
+     */
+    SharedObjectPool(const SharedObjectPool&) = delete;
+
+    /**
+     *
+     */
+    SharedObjectPool&
+    operator=(const SharedObjectPool&) = delete;
+
+    /**
+     * Gets an idle object, creating it if necessary.
+     *
+     * @return A not null reference to an object in its reset state.
+     * @since 2.1.0
+     */
+    std::shared_ptr<T>
+    acquire() {
+        Slot* slot = mSlots->take();
+        if (slot == nullptr) {
+            std::unique_ptr<T> object = mFactory();
+            slot = mSlots->add(std::move(object));
+        }
+
+        try {
+            return std::shared_ptr<T>(
+                slot->mObject.get(), Recycler(), ControlBlockAllocator<T>(slot));
+        } catch (...) {
+            /* Only a control block too large for the slot can fail to be allocated */
+            mSlots->give(slot);
+            throw;
+        }
+    }
+
+    /**
+     * Gets the number of idle objects retained by the pool.
+     *
+     * @return A value lower or equal to the maximum size.
+     * @since 2.1.0
+     */
+    std::size_t
+    size() const {
+        return mSlots->size();
+    }
+
+private:
+    class Slots;
+
+    /**
+     * Pooled object with the storage of the control block of its references.
+     */
+    struct Slot final {
+        /**
+         *
+         */
+        Slot(std::unique_ptr<T> object, Slots* const slots)
+        : mObject(std::move(object))
+        , mSlots(slots) {
+        }
+
+        /**
+         *
+         */
+        const std::unique_ptr<T> mObject;
+
+        /**
+         * The slots of the pool, which outlive the slot.
+         */
+        Slots* const mSlots;
+
+        /**
+         * Storage of the control block; 64 bytes fit the control blocks of the usual standard
+         * libraries (counters, pointer, empty deleter and allocator).
+         */
+        typename std::aligned_storage<64>::type mControlBlock;
+    };
+
+    /**
+     * Slots of the pool, destroyed with the last of them once the pool is closed.
+     */
+    class Slots final {
+    public:
+        /**
+         *
+         */
+        explicit Slots(const std::size_t maxSize)
+        : mMaxSize(maxSize)
+        , mSlotCount(0)
+        , mIsClosed(false) {
+            mIdleSlots.reserve(maxSize);
+        }
+
+        /**
+         * Removes an idle slot, null if there is none.
+         */
+        Slot*
+        take() {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mIdleSlots.empty()) {
+                return nullptr;
+            }
+            Slot* const slot = mIdleSlots.back();
+            mIdleSlots.pop_back();
+
+            return slot;
+        }
+
+        /**
+         * Creates a slot for a new object.
+         */
+        Slot*
+        add(std::unique_ptr<T> object) {
+            Slot* const slot = new Slot(std::move(object), this);
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSlotCount++;
+
+            return slot;
+        }
+
+        /**
+         * Adds a released slot, destroyed (outside the lock) if the pool is full or closed.
+         */
+        void
+        give(Slot* const slot) {
+            bool isLastSlot = false;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (!mIsClosed && mIdleSlots.size() < mMaxSize) {
+                    mIdleSlots.push_back(slot);
+                    return;
+                }
+                mSlotCount--;
+                isLastSlot = mIsClosed && mSlotCount == 0;
+            }
+
+            delete slot;
+            if (isLastSlot) {
+                delete this;
+            }
+        }
+
+        /**
+         * Destroys the idle slots, then the instance if no slot is in use.
+         */
+        void
+        close() {
+            std::vector<Slot*> idleSlots;
+            bool isLastSlot = false;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mIsClosed = true;
+                idleSlots.swap(mIdleSlots);
+                mSlotCount -= idleSlots.size();
+                isLastSlot = mSlotCount == 0;
+            }
+
+            for (Slot* const slot : idleSlots) {
+                delete slot;
+            }
+            if (isLastSlot) {
+                delete this;
+            }
+        }
+
+        /**
+         *
+         */
+        std::size_t
+        size() const {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            return mIdleSlots.size();
+        }
+
+    private:
+        /**
+         *
+         */
+        const std::size_t mMaxSize;
+
+        /**
+         *
+         */
+        std::vector<Slot*> mIdleSlots;
+
+        /**
+         * The number of existing slots, idle or in use.
+         */
+        std::size_t mSlotCount;
+
+        /**
+         *
+         */
+        bool mIsClosed;
+
+        /**
+         *
+         */
+        mutable std::mutex mMutex;
+    };
+
+    /**
+     * Deleter of the acquired references, resetting the object which stays in its slot.
+     */
+    struct Recycler final {
+        /**
+         *
+         */
+        void
+        operator()(T* const object) const {
+            object->reset();
+        }
+    };
+
+    /**
+     * Allocator of the control block of the acquired references, placing it in the slot of the
+     * object and giving the slot back to the pool once the control block is released.
+     *
+     * <p>A control block larger than the slot storage is allocated on the heap.
+     */
+    template <typename U>
+    class ControlBlockAllocator final {
+    public:
+        /**
+         *
+         */
+        using value_type = U;
+
+        /**
+         *
+         */
+        template <typename V>
+        struct rebind {
+            using other = ControlBlockAllocator<V>;
+        };
+
+        /**
+         *
+         */
+        explicit ControlBlockAllocator(Slot* const slot)
+        : mSlot(slot) {
+        }
+
+        /**
+         *
+         */
+        template <typename V>
+        ControlBlockAllocator(const ControlBlockAllocator<V>& other)
+        : mSlot(other.mSlot) {
+        }
+
+        /**
+         *
+         */
+        U*
+        allocate(const std::size_t n) {
+            if (isInSlot(n)) {
+                return reinterpret_cast<U*>(&mSlot->mControlBlock);
+            }
+
+            return static_cast<U*>(::operator new(n * sizeof(U)));
+        }
+
+        /**
+         * Releases the control block, then gives the slot back to the pool.
+         */
+        void
+        deallocate(U* const p, const std::size_t n) {
+            if (!isInSlot(n)) {
+                ::operator delete(p);
+            }
+            mSlot->mSlots->give(mSlot);
+        }
+
+        /**
+         *
+         */
+        bool
+        operator==(const ControlBlockAllocator& other) const {
+            return mSlot == other.mSlot;
+        }
+
+        /**
+         *
+         */
+        bool
+        operator!=(const ControlBlockAllocator& other) const {
+            return mSlot != other.mSlot;
+        }
+
+        /**
+         *
+         */
+        Slot* mSlot;
+
+    private:
+        /**
+         *
+         */
+        static bool
+        isInSlot(const std::size_t n) {
+            return n * sizeof(U) <= sizeof(Slot::mControlBlock)
+                   && alignof(U) <= alignof(decltype(Slot::mControlBlock));
+        }
+    };
+
+    /**
+     *
+     */
+    const std::function<std::unique_ptr<T>()> mFactory;
+
+    /**
+     *
+     */
+    Slots* const mSlots;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,169 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "keypop/card/ApduBuffer.hpp"
+#include "keypop/card/ByteSpan.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Scripted card model answering APDU commands according to a list of rules.
+ *
+ * <p>Each rule associates a command prefix (typically CLA INS P1 P2) with either a fixed response
+ * or a handler computing the response. A command is answered by the first rule, in insertion
+ * order, whose prefix matches the beginning of the command; an empty prefix matches any command.
+ * Commands matching no rule are answered with the default response (6D00h, "instruction not
+ * supported", unless changed).
+ *
+ * <p>Handlers may capture and update their own state, which allows stateful card applications
+ * (counters, files, sessions) to be simulated.
+ *
+ * <p>An instance is not thread-safe and is meant to be driven by a single
+ * keypop::card::SimulatedProxyReader.
+ *
+ * @since 2.1.0
+ */
+class SimulatedCard final {
+public:
+    /**
+     * Computes the response to a command.
+     *
+     * <p>The first argument is the complete command, the second one is the buffer to be filled
+     * with the complete response, including the status word (initially empty).
+     *
+     * @since 2.1.0
+     */
+    using CommandHandler = std::function<void(const ByteSpan, ApduResponseBuffer&)>;
+
+    /**
+     * Builds a card without any rule.
+     *
+     * @since 2.1.0
+     */
+    SimulatedCard() {
+        const uint8_t insNotSupported[] = {0x6D, 0x00};
+        mDefaultResponse.assign(ByteSpan(insNotSupported, sizeof(insNotSupported)));
+    }
+
+    /**
+     * Adds a rule answering the commands starting with the provided prefix with a fixed response.
+     *
+     * @param commandPrefix The command prefix (empty to match any command).
+     * @param response The complete response, including the status word.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    SimulatedCard&
+    addResponse(const ByteSpan commandPrefix, const ByteSpan response) {
+        const ApduResponseBuffer fixedResponse(response);
+
+        return addHandler(
+            commandPrefix, [fixedResponse](const ByteSpan, ApduResponseBuffer& out) {
+                out.assign(fixedResponse.view());
+            });
+    }
+
+    /**
+     * Adds a rule answering the commands starting with the provided prefix with a handler.
+     *
+     * @param commandPrefix The command prefix (empty to match any command).
+     * @param handler The handler computing the response.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    SimulatedCard&
+    addHandler(const ByteSpan commandPrefix, const CommandHandler& handler) {
+        mRules.push_back(Rule{ApduCommandBuffer(commandPrefix), handler});
+
+        return *this;
+    }
+
+    /**
+     * Sets the response to the commands matching no rule.
+     *
+     * @param response The complete response, including the status word.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    SimulatedCard&
+    setDefaultResponse(const ByteSpan response) {
+        mDefaultResponse.assign(response);
+
+        return *this;
+    }
+
+    /**
+     * Computes the response to a command.
+     *
+     * @param command The complete command.
+     * @param response The buffer to fill with the complete response.
+     * @since 2.1.0
+     */
+    void
+    processApdu(const ByteSpan command, ApduResponseBuffer& response) const {
+        response.clear();
+        for (const Rule& rule : mRules) {
+            const ByteSpan prefix = rule.commandPrefix.view();
+            if (command.first(prefix.size()) == prefix) {
+                rule.handler(command, response);
+                return;
+            }
+        }
+        response.assign(mDefaultResponse.view());
+    }
+
+    /**
+     * Gets a handler answering each command with its own data field (if any) followed by the
+     * provided status word.
+     *
+     * @param statusWord The status word to append.
+     * @return A not null handler.
+     * @since 2.1.0
+     */
+    static CommandHandler
+    echo(const int statusWord = 0x9000) {
+        return [statusWord](const ByteSpan command, ApduResponseBuffer& response) {
+            if (command.size() > 5) {
+                response.assign(command.subspan(5, command[4]));
+            }
+            response.push_back(static_cast<uint8_t>(statusWord >> 8));
+            response.push_back(static_cast<uint8_t>(statusWord));
+        };
+    }
+
+private:
+    /**
+     *
+     */
+    struct Rule {
+        ApduCommandBuffer commandPrefix;
+        CommandHandler handler;
+    };
+
+    /**
+     *
+     */
+    std::vector<Rule> mRules;
+
+    /**
+     *
+     */
+    ApduResponseBuffer mDefaultResponse;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,730 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+/* Keypop Card */
+#include "keypop/card/ApduBuffer.hpp"
+#include "keypop/card/ApduCommandEncoder.hpp"
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/CardTransmitResult.hpp"
+#include "keypop/card/CardTransmitStatus.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+#include "keypop/card/SharedObjectPool.hpp"
+#include "keypop/card/SimulatedCard.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+#include "keypop/card/spi/ApduSequenceView.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Implementation of keypop::card::ProxyReaderApi exchanging APDUs with a
+ * keypop::card::SimulatedCard, for testing and load testing without physical readers.
+ *
+ * <p>The processing rules of the API are followed: status word check, APDU response observer,
+ * APDU chaining, channel control and partial responses attached to the exceptions. The bulk
+ * access to the APDUs (see keypop::card::spi::CardRequestSpi::getApduSequence()) is used when
+ * provided by the request and no APDU chaining is involved. Segmented commands (see
+ * keypop::card::spi::ApduRequestSpi::getSegmentedCommand()) are encoded according to the maximum
+ * command length of the reader (see setMaxCommandLength()). The deadline and the APDU timeout of
+ * the requests are enforced against the simulated latency, on the virtual clock when the latency
+ * is not waited for.
+ *
+ * <p>The following behaviours of a real reader can be simulated:
+ * <ul>
+ * <li>A latency per APDU, made of a fixed part and a uniformly distributed jitter. The latency is
+ *     either actually waited for (default) or only accumulated in a virtual clock (see
+ *     setRealTime() and getElapsedLatency()), which allows thousands of exchanges per second to be
+ *     replayed on a single machine.
+ * <li>Faults (see keypop::card::SimulatedProxyReader::Fault), injected either randomly with a
+ *     given probability per APDU or deterministically after a given number of APDUs.
+ * </ul>
+ *
+ * <p>The random generator is seeded explicitly, so that a given scenario is reproducible.
+ *
+ * <p>The card and APDU responses are taken from keypop::card::SharedObjectPool instances owned by
+ * the reader: a response returns to its pool once the caller drops it, so a load test loop reuses
+ * the same response objects, buffers and reference control blocks from one request to the next,
+ * without heap allocation.
+ *
+ * <p>An instance is not thread-safe: load tests should use one instance per thread.
+ *
+ * @since 2.1.0
+ */
+class SimulatedProxyReader final : public ProxyReaderApi {
+public:
+    using ProxyReaderApi::transmitCardRequest;
+
+    /**
+     * Fault injected during an APDU exchange.
+     *
+     * @since 2.1.0
+     */
+    enum class Fault {
+        /**
+         * The card is removed while processing the command: the command is processed by the card
+         * but its response is lost, then keypop::card::CardBrokenCommunicationException is
+         * thrown. The card stays absent until insertCard() is called.
+         *
+         * @since 2.1.0
+         */
+        CARD_TEARING,
+
+        /**
+         * The response of the card is lost, the command being not processed:
+         * keypop::card::CardBrokenCommunicationException is thrown. The card stays present.
+         *
+         * @since 2.1.0
+         */
+        CARD_BROKEN_COMMUNICATION,
+
+        /**
+         * The reader fails before sending the command:
+         * keypop::card::ReaderBrokenCommunicationException is thrown.
+         *
+         * @since 2.1.0
+         */
+        READER_BROKEN_COMMUNICATION
+    };
+
+    /**
+     * Builds a new reader with an inserted card, without latency nor fault.
+     *
+     * @param card The simulated card (not null).
+     * @param seed The seed of the random generator used for the jitter and the random faults.
+     * @since 2.1.0
+     */
+    explicit SimulatedProxyReader(
+        const std::shared_ptr<SimulatedCard> card, const uint32_t seed = 0)
+    : mCard(card)
+    , mRandom(seed)
+    , mUniform(0.0, 1.0)
+    , mLatency(0)
+    , mJitter(0)
+    , mIsRealTime(true)
+    , mElapsedLatency(0)
+    , mFaultProbabilities()
+    , mScheduledFaultCountdown(0)
+    , mScheduledFault(Fault::CARD_TEARING)
+    , mHasScheduledFault(false)
+    , mExchangedApduCount(0)
+    , mIsCardPresent(true)
+    , mIsLogicalChannelOpen(false)
+    , mApduTimeout(0)
+    , mCardResponsePool(createCardResponse, CARD_RESPONSE_POOL_SIZE)
+    , mApduResponsePool(createApduResponse, APDU_RESPONSE_POOL_SIZE) {
+    }
+
+    /**
+     * Sets the latency of each APDU exchange.
+     *
+     * <p>The latency of an exchange is drawn uniformly in [latency - jitter, latency + jitter],
+     * negative values being clamped to zero.
+     *
+     * @param latency The mean latency.
+     * @param jitter The maximum deviation from the mean latency.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    SimulatedProxyReader&
+    setLatency(
+        const std::chrono::microseconds latency,
+        const std::chrono::microseconds jitter = std::chrono::microseconds(0)) {
+        mLatency = latency;
+        mJitter = jitter;
+
+        return *this;
+    }
+
+    /**
+     * Indicates if the latency is actually waited for (true, default) or only accumulated in the
+     * virtual clock returned by getElapsedLatency() (false).
+     *
+     * @param isRealTime True to sleep the calling thread.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    SimulatedProxyReader&
+    setRealTime(const bool isRealTime) {
+        mIsRealTime = isRealTime;
+
+        return *this;
+    }
+
+    /**
+     * Sets the maximum length of a command accepted by the reader, which determines how the
+     * segmented commands are encoded (see keypop::card::ApduCommandEncoder).
+     *
+     * @param maxCommandLength A value from keypop::card::SHORT_APDU_COMMAND_MAX_LENGTH (default)
+     *        to keypop::card::EXTENDED_APDU_COMMAND_MAX_LENGTH.
+     * @return The current instance.
+     * @throw std::invalid_argument If the length is out of range.
+     * @since 2.1.0
+     */
+    SimulatedProxyReader&
+    setMaxCommandLength(const std::size_t maxCommandLength) {
+        mEncoder = ApduCommandEncoder(maxCommandLength);
+
+        return *this;
+    }
+
+    /**
+     * Sets the probability for a fault to occur at each APDU exchange.
+     *
+     * @param fault The fault.
+     * @param probability A value in [0, 1] (0 disables the fault).
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    SimulatedProxyReader&
+    setFaultProbability(const Fault fault, const double probability) {
+        mFaultProbabilities[static_cast<std::size_t>(fault)] = probability;
+
+        return *this;
+    }
+
+    /**
+     * Schedules a fault to occur once, after a given number of APDU exchanges.
+     *
+     * <p>A previously scheduled fault which did not occur yet is replaced.
+     *
+     * @param apduCount The number of APDUs successfully exchanged before the fault (0 for the
+     *        next APDU).
+     * @param fault The fault.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    SimulatedProxyReader&
+    scheduleFault(const std::size_t apduCount, const Fault fault) {
+        mScheduledFaultCountdown = apduCount;
+        mScheduledFault = fault;
+        mHasScheduledFault = true;
+
+        return *this;
+    }
+
+    /**
+     * Inserts the card again after a tearing (see Fault::CARD_TEARING).
+     *
+     * @since 2.1.0
+     */
+    void
+    insertCard() {
+        mIsCardPresent = true;
+    }
+
+    /**
+     * Indicates if the card is present.
+     *
+     * @return False if the card has been torn and not inserted again.
+     * @since 2.1.0
+     */
+    bool
+    isCardPresent() const {
+        return mIsCardPresent;
+    }
+
+    /**
+     * Gets the cumulated latency of all the APDU exchanges, whether it was waited for or not.
+     *
+     * @return A positive or null duration.
+     * @since 2.1.0
+     */
+    std::chrono::microseconds
+    getElapsedLatency() const {
+        return mElapsedLatency;
+    }
+
+    /**
+     * Gets the number of APDUs successfully exchanged with the card.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getExchangedApduCount() const {
+        return mExchangedApduCount;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::shared_ptr<CardResponseApi>
+    transmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        const CardTransmitResult result = tryTransmitCardRequest(cardRequest, channelControl);
+        result.throwIfUnsuccessful();
+
+        return result.getCardResponse();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>No exception is thrown by the simulation itself.
+     *
+     * @since 2.1.0
+     */
+    CardTransmitResult
+    tryTransmitCardRequest(
+        const std::shared_ptr<spi::CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        const std::shared_ptr<CardResponseAdapter> cardResponse = mCardResponsePool.acquire();
+        bool isCardResponseComplete = false;
+        const CardTransmitStatus status
+            = transmit(*cardRequest, channelControl, *cardResponse, isCardResponseComplete);
+
+        return CardTransmitResult(status, cardResponse, isCardResponseComplete);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The card response is built directly for the caller, outside of the pool.
+     *
+     * @since 2.1.0
+     */
+    std::unique_ptr<CardResponseApi>
+    transmitCardRequest(
+        const spi::CardRequestSpi& cardRequest, const ChannelControl channelControl) override {
+        std::unique_ptr<CardResponseAdapter> cardResponse(new CardResponseAdapter());
+        bool isCardResponseComplete = false;
+        const CardTransmitStatus status
+            = transmit(cardRequest, channelControl, *cardResponse, isCardResponseComplete);
+        if (status != CardTransmitStatus::SUCCESSFUL) {
+            CardTransmitResult(
+                status,
+                std::shared_ptr<CardResponseApi>(std::move(cardResponse)),
+                isCardResponseComplete)
+                .throwIfUnsuccessful();
+        }
+
+        return std::unique_ptr<CardResponseApi>(std::move(cardResponse));
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void
+    releaseChannel() override {
+        mIsLogicalChannelOpen = false;
+    }
+
+private:
+    /**
+     * Transmits a card request, filling the provided card response.
+     */
+    CardTransmitStatus
+    transmit(
+        const spi::CardRequestSpi& cardRequest,
+        const ChannelControl channelControl,
+        CardResponseAdapter& cardResponse,
+        bool& isCardResponseComplete) {
+        const std::shared_ptr<spi::ApduResponseObserverSpi> observer
+            = cardRequest.getApduResponseObserver();
+        const std::shared_ptr<spi::ApduChainingSpi> chaining = cardRequest.getApduChaining();
+        /* Bulk access to the APDUs, unless the chaining needs the request objects */
+        const spi::ApduSequenceView apduSequence
+            = chaining == nullptr ? cardRequest.getApduSequence() : spi::ApduSequenceView();
+        const std::size_t apduCount = !apduSequence.empty()
+                                          ? apduSequence.size()
+                                          : cardRequest.getApduRequests().size();
+        cardResponse.reserve(apduCount);
+        const std::chrono::steady_clock::time_point deadline = cardRequest.getDeadline();
+        const std::chrono::steady_clock::time_point startTime
+            = deadline != std::chrono::steady_clock::time_point::max()
+                  ? std::chrono::steady_clock::now()
+                  : deadline;
+        const std::chrono::microseconds startLatency = mElapsedLatency;
+        mApduTimeout = cardRequest.getApduTimeout();
+
+        if (!mIsCardPresent) {
+            return CardTransmitStatus::CARD_BROKEN_COMMUNICATION;
+        }
+        mIsLogicalChannelOpen = true;
+
+        for (std::size_t i = 0; i < apduCount; i++) {
+            if (isDeadlineReached(deadline, startTime, startLatency)) {
+                applyChannelControl(channelControl);
+                cardResponse.setLogicalChannelOpen(mIsLogicalChannelOpen);
+                return CardTransmitStatus::TIMEOUT;
+            }
+            std::shared_ptr<ApduResponseApi> apduResponse;
+            bool isSuccessful = true;
+            const CardTransmitStatus status
+                = !apduSequence.empty()
+                      ? exchange(
+                          apduSequence, i, observer, cardResponse, apduResponse, isSuccessful)
+                      : exchange(
+                          cardRequest.getApduRequests()[i],
+                          i,
+                          observer,
+                          chaining,
+                          cardResponse,
+                          apduResponse,
+                          isSuccessful);
+            if (status != CardTransmitStatus::SUCCESSFUL) {
+                cardResponse.setLogicalChannelOpen(false);
+                return status;
+            }
+
+            if (cardRequest.stopOnUnsuccessfulStatusWord() && !isSuccessful) {
+                applyChannelControl(channelControl);
+                cardResponse.setLogicalChannelOpen(mIsLogicalChannelOpen);
+                isCardResponseComplete = i == apduCount - 1;
+                return CardTransmitStatus::UNEXPECTED_STATUS_WORD;
+            }
+        }
+
+        applyChannelControl(channelControl);
+        cardResponse.setLogicalChannelOpen(mIsLogicalChannelOpen);
+        isCardResponseComplete = true;
+
+        return CardTransmitStatus::SUCCESSFUL;
+    }
+
+    /**
+     * Closes the logical channel if requested, once the card request is completed, successfully
+     * or not.
+     */
+    void
+    applyChannelControl(const ChannelControl channelControl) {
+        if (channelControl == ChannelControl::CLOSE_AFTER) {
+            mIsLogicalChannelOpen = false;
+        }
+    }
+
+    /**
+     * Exchanges an APDU read from a bulk view.
+     */
+    CardTransmitStatus
+    exchange(
+        const spi::ApduSequenceView& apduSequence,
+        const std::size_t index,
+        const std::shared_ptr<spi::ApduResponseObserverSpi>& observer,
+        CardResponseAdapter& cardResponse,
+        std::shared_ptr<ApduResponseApi>& apduResponse,
+        bool& isSuccessful) {
+        const CardTransmitStatus status = exchange(apduSequence.getApdu(index), apduResponse);
+        if (status == CardTransmitStatus::SUCCESSFUL) {
+            isSuccessful = apduSequence.getSuccessfulStatusWords(index).contains(
+                apduResponse->getStatusWord());
+            cardResponse.addApduResponse(apduResponse, isSuccessful, index);
+            if (observer != nullptr) {
+                observer->onApduResponse(index, apduResponse);
+            }
+        }
+
+        return status;
+    }
+
+    /**
+     * Exchanges an APDU request and the requests chained to it.
+     */
+    CardTransmitStatus
+    exchange(
+        std::shared_ptr<spi::ApduRequestSpi> apduRequest,
+        const std::size_t index,
+        const std::shared_ptr<spi::ApduResponseObserverSpi>& observer,
+        const std::shared_ptr<spi::ApduChainingSpi>& chaining,
+        CardResponseAdapter& cardResponse,
+        std::shared_ptr<ApduResponseApi>& apduResponse,
+        bool& isSuccessful) {
+        while (true) {
+            const CardTransmitStatus status = exchange(*apduRequest, apduResponse);
+            if (status != CardTransmitStatus::SUCCESSFUL) {
+                return status;
+            }
+            const std::shared_ptr<spi::ApduRequestSpi> nextApduRequest
+                = chaining != nullptr ? chaining->getNextApduRequest(apduRequest, apduResponse)
+                                      : nullptr;
+            /* A response handled by the chaining is not checked */
+            isSuccessful = nextApduRequest != nullptr
+                           || apduRequest->isSuccessfulStatusWord(apduResponse->getStatusWord());
+            cardResponse.addApduResponse(apduResponse, isSuccessful, index);
+            if (observer != nullptr) {
+                observer->onApduResponse(index, apduResponse);
+            }
+            if (nextApduRequest == nullptr) {
+                return CardTransmitStatus::SUCCESSFUL;
+            }
+            apduRequest = nextApduRequest;
+        }
+    }
+
+    /**
+     * Exchanges the APDU of a request, or the APDUs encoding its segmented command.
+     */
+    CardTransmitStatus
+    exchange(spi::ApduRequestSpi& apduRequest, std::shared_ptr<ApduResponseApi>& apduResponse) {
+        const spi::ApduCommand* const command = apduRequest.getSegmentedCommand();
+        if (command == nullptr) {
+            return exchange(apduRequest.getApduView(), apduResponse);
+        }
+
+        const std::size_t exchangeCount = mEncoder.getExchangeCount(*command);
+        for (std::size_t i = 0; i < exchangeCount; i++) {
+            mEncoder.encode(*command, i, mCommandBuffer);
+            const CardTransmitStatus status = exchange(mCommandBuffer.view(), apduResponse);
+            if (status != CardTransmitStatus::SUCCESSFUL
+                || apduResponse->getStatusWord() != 0x9000) {
+                /* Chain interrupted: the last response is the response to the command */
+                return status;
+            }
+        }
+
+        return CardTransmitStatus::SUCCESSFUL;
+    }
+
+    /**
+     * Exchanges an APDU with the card, applying the latency and the faults.
+     */
+    CardTransmitStatus
+    exchange(const ByteSpan command, std::shared_ptr<ApduResponseApi>& apduResponse) {
+        const std::chrono::microseconds latency = drawLatency();
+        if (mApduTimeout.count() > 0 && latency > mApduTimeout) {
+            /* The reader stops waiting: the state of the card is unknown */
+            waitLatency(mApduTimeout);
+            mIsLogicalChannelOpen = false;
+            return CardTransmitStatus::TIMEOUT;
+        }
+        waitLatency(latency);
+
+        bool isFaulty = false;
+        Fault fault = Fault::CARD_TEARING;
+        if (mHasScheduledFault && mScheduledFaultCountdown-- == 0) {
+            mHasScheduledFault = false;
+            isFaulty = true;
+            fault = mScheduledFault;
+        }
+        for (std::size_t f = 0; !isFaulty && f < FAULT_COUNT; f++) {
+            if (mFaultProbabilities[f] > 0.0 && mUniform(mRandom) < mFaultProbabilities[f]) {
+                isFaulty = true;
+                fault = static_cast<Fault>(f);
+            }
+        }
+
+        if (isFaulty) {
+            mIsLogicalChannelOpen = false;
+            switch (fault) {
+            case Fault::READER_BROKEN_COMMUNICATION:
+                return CardTransmitStatus::READER_BROKEN_COMMUNICATION;
+            case Fault::CARD_TEARING:
+                mCard->processApdu(command, mResponseBuffer);
+                mIsCardPresent = false;
+                return CardTransmitStatus::CARD_BROKEN_COMMUNICATION;
+            case Fault::CARD_BROKEN_COMMUNICATION:
+            default:
+                return CardTransmitStatus::CARD_BROKEN_COMMUNICATION;
+            }
+        }
+
+        mCard->processApdu(command, mResponseBuffer);
+        mExchangedApduCount++;
+
+        const std::shared_ptr<ApduResponseAdapter> apduResponseAdapter
+            = mApduResponsePool.acquire();
+        apduResponseAdapter->setApdu(mResponseBuffer.view());
+        apduResponse = apduResponseAdapter;
+
+        return CardTransmitStatus::SUCCESSFUL;
+    }
+
+    /**
+     * Indicates if the deadline of the current request is reached, on the virtual clock if the
+     * latency is not waited for.
+     */
+    bool
+    isDeadlineReached(
+        const std::chrono::steady_clock::time_point deadline,
+        const std::chrono::steady_clock::time_point startTime,
+        const std::chrono::microseconds startLatency) const {
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            return false;
+        }
+        const std::chrono::steady_clock::time_point now
+            = mIsRealTime ? std::chrono::steady_clock::now()
+                          : startTime + (mElapsedLatency - startLatency);
+
+        return now >= deadline;
+    }
+
+    /**
+     * Draws the latency of an exchange.
+     */
+    std::chrono::microseconds
+    drawLatency() {
+        std::chrono::microseconds latency = mLatency;
+        if (mJitter.count() > 0) {
+            std::uniform_int_distribution<int64_t> jitter(-mJitter.count(), mJitter.count());
+            latency += std::chrono::microseconds(jitter(mRandom));
+        }
+
+        return latency.count() > 0 ? latency : std::chrono::microseconds(0);
+    }
+
+    /**
+     * Waits for or accounts the latency of an exchange.
+     */
+    void
+    waitLatency(const std::chrono::microseconds latency) {
+        if (latency.count() == 0) {
+            return;
+        }
+
+        mElapsedLatency += latency;
+        if (mIsRealTime) {
+            std::this_thread::sleep_for(latency);
+        }
+    }
+
+    /**
+     * Creates the card responses of the pool.
+     */
+    static std::unique_ptr<CardResponseAdapter>
+    createCardResponse() {
+        return std::unique_ptr<CardResponseAdapter>(new CardResponseAdapter());
+    }
+
+    /**
+     * Creates the APDU responses of the pool.
+     */
+    static std::unique_ptr<ApduResponseAdapter>
+    createApduResponse() {
+        return std::unique_ptr<ApduResponseAdapter>(new ApduResponseAdapter());
+    }
+
+    /**
+     *
+     */
+    static const std::size_t FAULT_COUNT = 3;
+
+    /**
+     * Maximum numbers of idle responses kept by the pools.
+     */
+    enum : std::size_t { CARD_RESPONSE_POOL_SIZE = 8, APDU_RESPONSE_POOL_SIZE = 64 };
+
+    /**
+     *
+     */
+    const std::shared_ptr<SimulatedCard> mCard;
+
+    /**
+     *
+     */
+    std::mt19937 mRandom;
+
+    /**
+     *
+     */
+    std::uniform_real_distribution<double> mUniform;
+
+    /**
+     *
+     */
+    std::chrono::microseconds mLatency;
+
+    /**
+     *
+     */
+    std::chrono::microseconds mJitter;
+
+    /**
+     *
+     */
+    bool mIsRealTime;
+
+    /**
+     *
+     */
+    std::chrono::microseconds mElapsedLatency;
+
+    /**
+     * Indexed by Fault.
+     */
+    double mFaultProbabilities[FAULT_COUNT];
+
+    /**
+     *
+     */
+    std::size_t mScheduledFaultCountdown;
+
+    /**
+     *
+     */
+    Fault mScheduledFault;
+
+    /**
+     *
+     */
+    bool mHasScheduledFault;
+
+    /**
+     *
+     */
+    std::size_t mExchangedApduCount;
+
+    /**
+     *
+     */
+    bool mIsCardPresent;
+
+    /**
+     *
+     */
+    bool mIsLogicalChannelOpen;
+
+    /**
+     *
+     */
+    ApduResponseBuffer mResponseBuffer;
+
+    /**
+     *
+     */
+    ApduCommandEncoder mEncoder;
+
+    /**
+     *
+     */
+    ApduCommandBuffer mCommandBuffer;
+
+    /**
+     * APDU timeout of the request being transmitted.
+     */
+    std::chrono::microseconds mApduTimeout;
+
+    /**
+     *
+     */
+    SharedObjectPool<CardResponseAdapter> mCardResponsePool;
+
+    /**
+     *
+     */
+    SharedObjectPool<ApduResponseAdapter> mApduResponsePool;
+};
+
+} /* namespace card */
+} /* namespace keypop */
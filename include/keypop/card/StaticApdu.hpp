@@ -0,0 +1,113 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Short APDU command entirely known at compile time.
+ *
+ * <p>The bytes are encoded by the compiler into static storage: getBytes() returns a view on them
+ * without any runtime construction, to be used for instance with
+ * keypop::card::spi::StaticApduRequest. The fields are checked at compile time: a malformed
+ * command does not compile.
+ *
+ * <p>Example, a Calypso <b>Read Record</b> command expecting 29 bytes:
+ * <pre>
+ * using ReadRecord = StaticApdu<0x94, 0xB2, 0x01, 0x3C, 0x1D>;
+ * </pre>
+ *
+ * @tparam Cla The class byte (not FFh).
+ * @tparam Ins The instruction byte (not 6Xh nor 9Xh).
+ * @tparam P1 The first parameter byte.
+ * @tparam P2 The second parameter byte.
+ * @tparam Le The expected length, from 1 to 256, or keypop::card::spi::ApduCommand::NO_LE.
+ * @tparam Data The bytes of the data field (255 at most), Lc being deduced from their number.
+ * @since 2.1.0
+ */
+template <uint8_t Cla, uint8_t Ins, uint8_t P1, uint8_t P2, int Le, uint8_t... Data>
+class StaticApdu final {
+    static_assert(Cla != 0xFF, "CLA FFh is invalid");
+    static_assert((Ins & 0xF0) != 0x60 && (Ins & 0xF0) != 0x90, "INS 6Xh and 9Xh are invalid");
+    static_assert(
+        Le == spi::ApduCommand::NO_LE || (Le >= 1 && Le <= 256), "Le out of short APDU range");
+    static_assert(sizeof...(Data) <= 255, "Data field too long for a short APDU");
+
+public:
+    /**
+     * Lengths of the command.
+     *
+     * @since 2.1.0
+     */
+    enum : std::size_t {
+        /**
+         * Number of bytes of the data field (Lc, 0 if absent).
+         *
+         * @since 2.1.0
+         */
+        DATA_LENGTH = sizeof...(Data),
+
+        /**
+         * Number of bytes of the command.
+         *
+         * @since 2.1.0
+         */
+        LENGTH = 4 + (sizeof...(Data) > 0 ? 1 + sizeof...(Data) : 0)
+                 + (Le != spi::ApduCommand::NO_LE ? 1 : 0)
+    };
+
+    /**
+     *
+     */
+    StaticApdu() = delete;
+
+    /**
+     * Gets the bytes of the command.
+     *
+     * @return A view on static storage, valid for the whole program lifetime.
+     * @since 2.1.0
+     */
+    static constexpr ByteSpan
+    getBytes() noexcept {
+        return ByteSpan(BYTES, LENGTH);
+    }
+
+private:
+    /**
+     * The header, then Lc and the data if any, then Le if any. Without data, Le takes the place of
+     * Lc; the unused trailing byte(s) are outside of getBytes().
+     */
+    static constexpr uint8_t BYTES[4 + 1 + sizeof...(Data) + 1] = {
+        Cla,
+        Ins,
+        P1,
+        P2,
+        static_cast<uint8_t>(sizeof...(Data) > 0 ? sizeof...(Data) : Le),
+        Data...,
+        static_cast<uint8_t>(Le)};
+};
+
+#if __cplusplus < 201703L
+/**
+ * Out of class definition required before C++17 (the member is odr-used by getBytes()).
+ */
+template <uint8_t Cla, uint8_t Ins, uint8_t P1, uint8_t P2, int Le, uint8_t... Data>
+constexpr uint8_t StaticApdu<Cla, Ins, P1, P2, Le, Data...>::BYTES[];
+#endif
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,117 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "keypop/card/StatusWordSet.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Set of successful status words entirely known at compile time.
+ *
+ * <p>contains() is a constant expression, so that the processing of constant responses can be
+ * checked by the compiler. getSet() provides the equivalent keypop::card::StatusWordSet, built
+ * once for the whole program and shared by all the requests using it.
+ *
+ * <p>Example:
+ * <pre>
+ * using ReadRecordStatusWords = StaticStatusWords<0x9000, 0x6282>;
+ * </pre>
+ *
+ * @tparam StatusWords The status words (at least 9000h; values exceeding FFFFh do not compile).
+ * @since 2.1.0
+ */
+template <uint16_t... StatusWords>
+class StaticStatusWords final {
+    /**
+     *
+     */
+    template <bool...>
+    struct BoolPack {};
+
+    static_assert(
+        !std::is_same<
+            BoolPack<true, (StatusWords != 0x9000)...>,
+            BoolPack<(StatusWords != 0x9000)..., true>>::value,
+        "The successful status words must contain 9000h");
+
+public:
+    /**
+     * Number of status words of the set, as provided.
+     *
+     * @since 2.1.0
+     */
+    enum : std::size_t { SIZE = sizeof...(StatusWords) };
+
+    /**
+     *
+     */
+    StaticStatusWords() = delete;
+
+    /**
+     * Indicates if a status word belongs to the set.
+     *
+     * @param statusWord The status word.
+     * @return True if the status word belongs to the set.
+     * @since 2.1.0
+     */
+    static constexpr bool
+    contains(const int statusWord) noexcept {
+        return containsFrom(statusWord, 0);
+    }
+
+    /**
+     * Gets the equivalent runtime set.
+     *
+     * @return A reference to a set built on the first call (the default set if the set only
+     *         contains 9000h).
+     * @since 2.1.0
+     */
+    static const std::shared_ptr<const StatusWordSet>&
+    getSet() {
+        static const std::shared_ptr<const StatusWordSet> statusWordSet
+            = StatusWordSet::of(std::vector<int>({StatusWords...}));
+
+        return statusWordSet;
+    }
+
+private:
+    /**
+     *
+     */
+    static constexpr bool
+    containsFrom(const int statusWord, const std::size_t index) noexcept {
+        return index < SIZE
+               && (VALUES[index] == statusWord || containsFrom(statusWord, index + 1));
+    }
+
+    /**
+     *
+     */
+    static constexpr uint16_t VALUES[sizeof...(StatusWords)] = {StatusWords...};
+};
+
+#if __cplusplus < 201703L
+/**
+ * Out of class definition required before C++17.
+ */
+template <uint16_t... StatusWords>
+constexpr uint16_t StaticStatusWords<StatusWords...>::VALUES[];
+#endif
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,98 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace keypop {
+namespace card {
+
+/**
+ * Hexadecimal representation of a list of status words, rendered only when written to a stream.
+ *
+ * <p>Building an instance only captures a reference on the list, which must remain valid until
+ * the instance is written with <b>operator&lt;&lt;</b>. The status words are written in the order
+ * of the list, e.g. <code>{6283, 9000}</code>. A run of the 256 status words of a SW1 value in
+ * ascending order (as listed by keypop::card::StatusWordSet) is written as a whole class, e.g.
+ * <code>61xx</code>.
+ *
+ * @since 2.1.0
+ */
+class StatusWordFormat final {
+public:
+    /**
+     * Builds a formatter of the provided status words.
+     *
+     * @param statusWords The status words, which must remain valid until the formatter is written.
+     * @since 2.1.0
+     */
+    explicit StatusWordFormat(const std::vector<int>& statusWords) noexcept
+    : mStatusWords(statusWords) {
+    }
+
+    /**
+     * Writes the status words as uppercase hexadecimal values, without allocation.
+     *
+     * @since 2.1.0
+     */
+    friend std::ostream&
+    operator<<(std::ostream& os, const StatusWordFormat& swf) {
+        static const char digits[] = "0123456789ABCDEF";
+        const std::vector<int>& statusWords = swf.mStatusWords;
+
+        os << "{";
+        for (std::size_t i = 0; i < statusWords.size(); i++) {
+            if (i != 0) {
+                os << ", ";
+            }
+            const int sw1 = (statusWords[i] >> 8) & 0xFF;
+            const int sw2 = statusWords[i] & 0xFF;
+            os.put(digits[sw1 >> 4]).put(digits[sw1 & 0x0F]);
+            if (isWholeClass(statusWords, i)) {
+                os << "xx";
+                i += 255;
+            } else {
+                os.put(digits[sw2 >> 4]).put(digits[sw2 & 0x0F]);
+            }
+        }
+        os << "}";
+
+        return os;
+    }
+
+private:
+    /**
+     * Indicates whether the list holds the 256 status words of a SW1 value in ascending order
+     * from the provided index.
+     */
+    static bool
+    isWholeClass(const std::vector<int>& statusWords, const std::size_t index) {
+        if ((statusWords[index] & 0xFF) != 0 || statusWords.size() - index < 256) {
+            return false;
+        }
+        for (std::size_t i = 1; i < 256; i++) {
+            if (statusWords[index + i] != statusWords[index] + static_cast<int>(i)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     *
+     */
+    const std::vector<int>& mStatusWords;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,282 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "keypop/card/StatusWordFormat.hpp"
+
+namespace keypop {
+namespace card {
+
+/**
+ * Immutable set of APDU status words with constant time membership test.
+ *
+ * <p>Status words are grouped by SW1: a whole SW1 class (e.g. "61xx" or "6Cxx") is stored as a
+ * single bit, while individual status words (e.g. "9000") are stored in a 256 bits row per SW1.
+ *
+ * <p>Instances are built with a StatusWordSet::Builder and are meant to be shared. The set
+ * containing only 9000h, which is by far the most common, is interned and available with
+ * getDefault().
+ *
+ * @since 2.1.0
+ */
+class StatusWordSet final {
+public:
+    /**
+     * Builder of keypop::card::StatusWordSet.
+     *
+     * @since 2.1.0
+     */
+    class Builder final {
+    public:
+        /**
+         * Adds a single status word.
+         *
+         * @param statusWord The status word, between 0000h and FFFFh (ignored otherwise).
+         * @return The current instance.
+         * @since 2.1.0
+         */
+        Builder&
+        add(const int statusWord) {
+            if (statusWord >= 0 && statusWord <= 0xFFFF) {
+                mSw2BySw1[static_cast<uint8_t>(statusWord >> 8)].set(statusWord & 0xFF);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Adds all the status words having the provided SW1 (e.g. 61h for "61xx").
+         *
+         * @param sw1 The SW1 value.
+         * @return The current instance.
+         * @since 2.1.0
+         */
+        Builder&
+        addSw1(const uint8_t sw1) {
+            mAnySw2.set(sw1);
+
+            return *this;
+        }
+
+        /**
+         * Adds all the status words of the provided inclusive range.
+         *
+         * @param from The first status word of the range.
+         * @param to The last status word of the range.
+         * @return The current instance.
+         * @since 2.1.0
+         */
+        Builder&
+        addRange(const int from, const int to) {
+            for (int statusWord = from; statusWord <= to; statusWord++) {
+                add(statusWord);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Adds all the status words of the provided list.
+         *
+         * @param statusWords The status words.
+         * @return The current instance.
+         * @since 2.1.0
+         */
+        Builder&
+        addAll(const std::vector<int>& statusWords) {
+            for (const int statusWord : statusWords) {
+                add(statusWord);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Adds all the status words of the provided set.
+         *
+         * @param statusWordSet The set.
+         * @return The current instance.
+         * @since 2.1.0
+         */
+        Builder&
+        addAll(const StatusWordSet& statusWordSet) {
+            mAnySw2 |= statusWordSet.mAnySw2;
+            for (std::size_t sw1 = 0; sw1 < 256; sw1++) {
+                if (statusWordSet.mRowIndexes[sw1] != 0) {
+                    mSw2BySw1[static_cast<uint8_t>(sw1)]
+                        |= statusWordSet.mRows[statusWordSet.mRowIndexes[sw1] - 1];
+                }
+            }
+
+            return *this;
+        }
+
+        /**
+         * Builds the set.
+         *
+         * @return A not null reference.
+         * @since 2.1.0
+         */
+        std::shared_ptr<const StatusWordSet>
+        build() const {
+            return std::shared_ptr<const StatusWordSet>(new StatusWordSet(mAnySw2, mSw2BySw1));
+        }
+
+    private:
+        /**
+         *
+         */
+        std::bitset<256> mAnySw2;
+
+        /**
+         *
+         */
+        std::map<uint8_t, std::bitset<256>> mSw2BySw1;
+    };
+
+    /**
+     * Gets the interned set containing only 9000h.
+     *
+     * @return A not null reference, always the same.
+     * @since 2.1.0
+     */
+    static const std::shared_ptr<const StatusWordSet>&
+    getDefault() {
+        static const std::shared_ptr<const StatusWordSet> defaultSet
+            = Builder().add(0x9000).build();
+
+        return defaultSet;
+    }
+
+    /**
+     * Gets a set containing the provided status words.
+     *
+     * <p>The interned default set is returned when the list only contains 9000h, without any
+     * allocation. A new set is built for any other list: it is meant to be kept by the caller.
+     *
+     * @param statusWords The status words.
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    static std::shared_ptr<const StatusWordSet>
+    of(const std::vector<int>& statusWords) {
+        if (statusWords.size() == 1 && statusWords[0] == 0x9000) {
+            return getDefault();
+        }
+
+        return Builder().addAll(statusWords).build();
+    }
+
+    /**
+     * Indicates whether the provided status word belongs to the set.
+     *
+     * @param statusWord The status word.
+     * @return True if the status word is in the set.
+     * @since 2.1.0
+     */
+    bool
+    contains(const int statusWord) const noexcept {
+        if (statusWord < 0 || statusWord > 0xFFFF) {
+            return false;
+        }
+
+        const std::size_t sw1 = static_cast<std::size_t>(statusWord >> 8);
+        if (mAnySw2.test(sw1)) {
+            return true;
+        }
+
+        const uint16_t rowIndex = mRowIndexes[sw1];
+
+        return rowIndex != 0
+               && mRows[rowIndex - 1].test(static_cast<std::size_t>(statusWord & 0xFF));
+    }
+
+    /**
+     * Gets all the status words of the set, in ascending order.
+     *
+     * @return A not null list, computed once when the set is built.
+     * @since 2.1.0
+     */
+    const std::vector<int>&
+    getStatusWords() const noexcept {
+        return mStatusWords;
+    }
+
+    /**
+     * Writes the set as a list of hexadecimal status words, whole SW1 classes being written as
+     * "61xx" (see keypop::card::StatusWordFormat).
+     *
+     * @since 2.1.0
+     */
+    friend std::ostream&
+    operator<<(std::ostream& os, const StatusWordSet& sws) {
+        return os << StatusWordFormat(sws.mStatusWords);
+    }
+
+private:
+    /**
+     *
+     */
+    StatusWordSet(
+        const std::bitset<256>& anySw2, const std::map<uint8_t, std::bitset<256>>& sw2BySw1)
+    : mAnySw2(anySw2)
+    , mRowIndexes() {
+        for (const auto& entry : sw2BySw1) {
+            if (entry.second.all()) {
+                mAnySw2.set(entry.first);
+            } else if (entry.second.any() && !mAnySw2.test(entry.first)) {
+                mRows.push_back(entry.second);
+                mRowIndexes[entry.first] = static_cast<uint16_t>(mRows.size());
+            }
+        }
+
+        for (std::size_t sw1 = 0; sw1 < 256; sw1++) {
+            if (!mAnySw2.test(sw1) && mRowIndexes[sw1] == 0) {
+                continue;
+            }
+            for (std::size_t sw2 = 0; sw2 < 256; sw2++) {
+                if (mAnySw2.test(sw1) || mRows[mRowIndexes[sw1] - 1].test(sw2)) {
+                    mStatusWords.push_back(static_cast<int>((sw1 << 8) | sw2));
+                }
+            }
+        }
+    }
+
+    /**
+     * SW1 values for which any SW2 matches.
+     */
+    std::bitset<256> mAnySw2;
+
+    /**
+     * Index + 1 of the SW2 row of each SW1 value in mRows, 0 if none.
+     */
+    uint16_t mRowIndexes[256];
+
+    /**
+     *
+     */
+    std::vector<std::bitset<256>> mRows;
+
+    /**
+     *
+     */
+    std::vector<int> mStatusWords;
+};
+
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,279 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+#include "keypop/card/spi/ApduSequenceView.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Storage of a sequence of APDUs in one contiguous block of bytes with an offset table.
+ *
+ * <p>It backs the card requests providing a bulk access to their APDUs (see
+ * keypop::card::spi::ArenaCardRequest and keypop::card::spi::TemplateCardRequest). The
+ * keypop::card::spi::ApduRequestSpi objects needed by the legacy accessor
+ * keypop::card::spi::CardRequestSpi::getApduRequests() are views on the block, only built on the
+ * first call of getApduRequests(). They share the control block of the storage and remain valid,
+ * even if the arena is destroyed, as long as they are referenced.
+ *
+ * <p>Copying an arena copies the block and the offset table, the status word sets and the
+ * information strings being shared.
+ *
+ * @since 2.1.0
+ */
+class ApduArena final {
+public:
+    /**
+     * Builds an empty arena.
+     *
+     * @param expectedApduCount The number of APDUs to reserve room for.
+     * @param expectedByteCount The number of bytes to reserve room for.
+     * @since 2.1.0
+     */
+    explicit ApduArena(
+        const std::size_t expectedApduCount = 0, const std::size_t expectedByteCount = 0)
+    : mStorage(std::make_shared<Storage>()) {
+        mStorage->bytes.reserve(expectedByteCount);
+        mStorage->entries.reserve(expectedApduCount);
+        mStorage->successfulStatusWords.reserve(expectedApduCount);
+        mStorage->infos.reserve(expectedApduCount);
+    }
+
+    /**
+     * Builds a deep copy of an arena (the APDU request views are not copied).
+     *
+     * @param other The arena to copy.
+     * @since 2.1.0
+     */
+    ApduArena(const ApduArena& other)
+    : mStorage(std::make_shared<Storage>()) {
+        mStorage->bytes = other.mStorage->bytes;
+        mStorage->entries = other.mStorage->entries;
+        mStorage->successfulStatusWords = other.mStorage->successfulStatusWords;
+        mStorage->infos = other.mStorage->infos;
+    }
+
+    /**
+     *
+     */
+    ApduArena& operator=(const ApduArena&) = delete;
+
+    /**
+     * Appends an APDU.
+     *
+     * <p>Previously obtained sequence views are invalidated.
+     *
+     * @param apdu The command bytes.
+     * @param successfulStatusWords The successful status words (null for the default set).
+     * @param info The information about the APDU.
+     * @return The index of the APDU.
+     * @since 2.1.0
+     */
+    std::size_t
+    addApdu(
+        const ByteSpan apdu,
+        const std::shared_ptr<const StatusWordSet>& successfulStatusWords,
+        const std::string& info) {
+        const std::shared_ptr<const StatusWordSet> statusWords
+            = successfulStatusWords != nullptr ? successfulStatusWords
+                                               : StatusWordSet::getDefault();
+
+        ApduSequenceView::Entry entry;
+        entry.offset = mStorage->bytes.size();
+        entry.length = apdu.size();
+        entry.successfulStatusWords = statusWords.get();
+
+        mStorage->bytes.insert(mStorage->bytes.end(), apdu.begin(), apdu.end());
+        mStorage->entries.push_back(entry);
+        mStorage->successfulStatusWords.push_back(statusWords);
+        mStorage->infos.push_back(info);
+
+        return mStorage->entries.size() - 1;
+    }
+
+    /**
+     * Gets the number of APDUs.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    size() const {
+        return mStorage->entries.size();
+    }
+
+    /**
+     * Gets the whole block of bytes.
+     *
+     * @return A view valid until the next addApdu().
+     * @since 2.1.0
+     */
+    ByteSpan
+    getBytes() const {
+        return ByteSpan(mStorage->bytes);
+    }
+
+    /**
+     * Gets a writable pointer to the block of bytes, to patch APDUs in place.
+     *
+     * @return A pointer valid until the next addApdu().
+     * @since 2.1.0
+     */
+    uint8_t*
+    getMutableBytes() {
+        return mStorage->bytes.data();
+    }
+
+    /**
+     * Gets the location of an APDU in the block.
+     *
+     * @param index The index of the APDU, lower than size() (not checked).
+     * @return A reference valid until the next addApdu().
+     * @since 2.1.0
+     */
+    const ApduSequenceView::Entry&
+    getEntry(const std::size_t index) const {
+        return mStorage->entries[index];
+    }
+
+    /**
+     * Gets a bulk view on all the APDUs.
+     *
+     * @return A view valid until the next addApdu().
+     * @since 2.1.0
+     */
+    ApduSequenceView
+    getSequence() const {
+        return ApduSequenceView(
+            mStorage->bytes.data(),
+            mStorage->entries.data(),
+            mStorage->entries.size(),
+            mStorage->infos.data());
+    }
+
+    /**
+     * Gets the APDUs as keypop::card::spi::ApduRequestSpi views, building the missing ones.
+     *
+     * <p>This method must not be called concurrently with itself or with addApdu().
+     *
+     * @return A list having one element per APDU.
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<ApduRequestSpi>>&
+    getApduRequests() const {
+        Storage& storage = *mStorage;
+        for (std::size_t i = mApduRequests.size(); i < storage.entries.size(); i++) {
+            storage.views.emplace_back(storage, i);
+            /* Aliasing constructor: a single control block for all the APDU requests. The list is
+             * kept out of the storage, which it would otherwise keep alive forever. */
+            mApduRequests.push_back(
+                std::shared_ptr<ApduRequestSpi>(mStorage, &storage.views.back()));
+        }
+
+        return mApduRequests;
+    }
+
+private:
+    struct Storage;
+
+    /**
+     * APDU request viewing one APDU of the block.
+     */
+    class ArenaApduRequest final : public ApduRequestSpi {
+    public:
+        ArenaApduRequest(const Storage& storage, const std::size_t index)
+        : mStorage(storage)
+        , mIndex(index) {
+        }
+
+        /**
+         * {@inheritDoc}
+         *
+         * <p>The returned vector is a copy of the current bytes, refreshed at each call: modifying
+         * it has no effect on the request.
+         */
+        std::vector<uint8_t>&
+        getApdu() override {
+            const ByteSpan apdu = getApduView();
+            mLegacyApdu.assign(apdu.begin(), apdu.end());
+
+            return mLegacyApdu;
+        }
+
+        ByteSpan
+        getApduView() override {
+            const ApduSequenceView::Entry& entry = mStorage.entries[mIndex];
+
+            return ByteSpan(mStorage.bytes.data() + entry.offset, entry.length);
+        }
+
+        const std::vector<int>&
+        getSuccessfulStatusWords() const override {
+            return mStorage.successfulStatusWords[mIndex]->getStatusWords();
+        }
+
+        std::shared_ptr<const StatusWordSet>
+        getSuccessfulStatusWordSet() const override {
+            return mStorage.successfulStatusWords[mIndex];
+        }
+
+        bool
+        isSuccessfulStatusWord(const int statusWord) const override {
+            return mStorage.successfulStatusWords[mIndex]->contains(statusWord);
+        }
+
+        const std::string&
+        getInfo() const override {
+            return mStorage.infos[mIndex];
+        }
+
+    private:
+        const Storage& mStorage;
+        const std::size_t mIndex;
+        std::vector<uint8_t> mLegacyApdu;
+    };
+
+    /**
+     * Shared storage of the block, the offset table and the APDU request views.
+     */
+    struct Storage {
+        std::vector<uint8_t> bytes;
+        std::vector<ApduSequenceView::Entry> entries;
+        std::vector<std::shared_ptr<const StatusWordSet>> successfulStatusWords;
+        std::vector<std::string> infos;
+        std::deque<ArenaApduRequest> views;
+    };
+
+    /**
+     *
+     */
+    const std::shared_ptr<Storage> mStorage;
+
+    /**
+     *
+     */
+    mutable std::vector<std::shared_ptr<ApduRequestSpi>> mApduRequests;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,69 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Generator of APDU requests depending on the previous response, evaluated by the reader between
+ * two exchanges of a keypop::card::spi::CardRequestSpi.
+ *
+ * <p>It allows dialogues such as GET RESPONSE on 61xx, Le correction on 6Cxx or read-until-end
+ * loops to be performed within a single transmission, without going back to the application.
+ *
+ * <p>After each exchange, the reader provides the APDU request just sent and its response:
+ * <ul>
+ * <li>If a request is returned, it is sent immediately and its response is added to the card
+ *     response just after the previous one. The generator is then invoked again with this new
+ *     exchange.
+ * <li>If null is returned, the chain ends and the processing continues with the next APDU request
+ *     of keypop::card::spi::CardRequestSpi::getApduRequests().
+ * </ul>
+ *
+ * <p>The successful status words check (see
+ * keypop::card::spi::CardRequestSpi::stopOnUnsuccessfulStatusWord()) is only applied to the
+ * response ending a chain, using the successful status words of the request that produced it.
+ *
+ * <p>The implementation is responsible for the termination of the chains it generates.
+ *
+ * @see keypop::card::spi::CardRequestSpi::getApduChaining()
+ * @since 2.1.0
+ */
+class ApduChainingSpi {
+public:
+    /**
+     * Virtual destructor.
+     */
+    virtual ~ApduChainingSpi() = default;
+
+    /**
+     * Gets the APDU request to send after the provided exchange.
+     *
+     * @param previousApduRequest The APDU request just sent (not null).
+     * @param previousApduResponse The response received to this request (not null).
+     * @return Null if no more APDU has to be sent in the current chain.
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<ApduRequestSpi> getNextApduRequest(
+        const std::shared_ptr<ApduRequestSpi> previousApduRequest,
+        const std::shared_ptr<ApduResponseApi> previousApduResponse)
+        = 0;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,200 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Structured description of an APDU command whose data field is made of several segments
+ * (scatter/gather), independently of its encoding.
+ *
+ * <p>The reader chooses the encoding from its capabilities (see
+ * keypop::card::ApduCommandEncoder): a short APDU, an extended-length APDU, or a chain of APDUs
+ * (ISO 7816-4 command chaining) if the data field does not fit in a single command. The data is
+ * read directly from the segments, so that a large payload never has to be assembled in one
+ * contiguous buffer.
+ *
+ * <p>The segments are views: the viewed bytes must remain valid and unchanged as long as the
+ * command is in use.
+ *
+ * @see keypop::card::spi::ApduRequestSpi::getSegmentedCommand()
+ * @since 2.1.0
+ */
+class ApduCommand final {
+public:
+    /**
+     * Value of the expected length meaning that no response data is expected (no Le field).
+     *
+     * @since 2.1.0
+     */
+    enum : int { NO_LE = -1 };
+
+    /**
+     * Builds a command without data and without Le field.
+     *
+     * @param cla The class byte.
+     * @param ins The instruction byte.
+     * @param p1 The first parameter byte.
+     * @param p2 The second parameter byte.
+     * @since 2.1.0
+     */
+    ApduCommand(const uint8_t cla, const uint8_t ins, const uint8_t p1, const uint8_t p2)
+    : mDataLength(0)
+    , mLe(NO_LE) {
+        mHeader[0] = cla;
+        mHeader[1] = ins;
+        mHeader[2] = p1;
+        mHeader[3] = p2;
+    }
+
+    /**
+     * Appends a segment to the data field.
+     *
+     * @param segment The view on the bytes, which must remain valid as long as the command is in
+     *        use. Empty segments are ignored.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    ApduCommand&
+    addData(const ByteSpan segment) {
+        if (!segment.empty()) {
+            mSegments.push_back(segment);
+            mDataLength += segment.size();
+        }
+
+        return *this;
+    }
+
+    /**
+     * Sets the maximum number of response data bytes expected.
+     *
+     * @param le The expected length, from 1 to 65536, or NO_LE. 256 and 65536 are the maximum
+     *        lengths of the short and extended forms (respectively encoded 00h and 0000h).
+     * @return The current instance.
+     * @throw std::invalid_argument If the value is out of range.
+     * @since 2.1.0
+     */
+    ApduCommand&
+    setLe(const int le) {
+        if (le != NO_LE && (le < 1 || le > 65536)) {
+            throw std::invalid_argument("Le out of range");
+        }
+        mLe = le;
+
+        return *this;
+    }
+
+    /**
+     * Gets the header.
+     *
+     * @return A view on the 4 bytes CLA, INS, P1 and P2, valid as long as the command is alive.
+     * @since 2.1.0
+     */
+    ByteSpan
+    getHeader() const {
+        return ByteSpan(mHeader, sizeof(mHeader));
+    }
+
+    /**
+     * Gets the segments of the data field.
+     *
+     * @return A list of not empty views, empty if the command has no data.
+     * @since 2.1.0
+     */
+    const std::vector<ByteSpan>&
+    getDataSegments() const {
+        return mSegments;
+    }
+
+    /**
+     * Gets the total length of the data field.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getDataLength() const {
+        return mDataLength;
+    }
+
+    /**
+     * Gets the expected length.
+     *
+     * @return A value from 1 to 65536, or NO_LE.
+     * @since 2.1.0
+     */
+    int
+    getLe() const {
+        return mLe;
+    }
+
+    /**
+     * Copies a range of the data field, gathering the bytes from the segments.
+     *
+     * @param offset The offset of the first byte in the data field.
+     * @param length The number of bytes, such that offset + length does not exceed
+     *        getDataLength() (not checked).
+     * @param output The destination, having room for length bytes.
+     * @since 2.1.0
+     */
+    void
+    copyData(std::size_t offset, std::size_t length, uint8_t* output) const {
+        for (const ByteSpan& segment : mSegments) {
+            if (length == 0) {
+                break;
+            }
+            if (offset >= segment.size()) {
+                offset -= segment.size();
+                continue;
+            }
+            const std::size_t count
+                = segment.size() - offset < length ? segment.size() - offset : length;
+            std::memcpy(output, segment.data() + offset, count);
+            output += count;
+            length -= count;
+            offset = 0;
+        }
+    }
+
+private:
+    /**
+     *
+     */
+    uint8_t mHeader[4];
+
+    /**
+     *
+     */
+    std::vector<ByteSpan> mSegments;
+
+    /**
+     *
+     */
+    std::size_t mDataLength;
+
+    /**
+     *
+     */
+    int mLe;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,207 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "keypop/card/ApduBuffer.hpp"
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Default implementation of keypop::card::spi::ApduRequestSpi based on an inline APDU buffer.
+ *
+ * <p>Short APDU commands are stored inside the object, so that building a request does not
+ * allocate on the heap. The successful status words are held in a shared immutable
+ * keypop::card::StatusWordSet, the interned keypop::card::StatusWordSet::getDefault() one being
+ * used unless other status words are added.
+ *
+ * <p>The <b>std::vector</b> returned by getApdu() is only built on the first call of this legacy
+ * accessor; from then on it becomes the storage of the APDU. Callers on the hot path should use
+ * getApduView() instead.
+ *
+ * @since 2.1.0
+ */
+class ApduRequestAdapter final : public ApduRequestSpi {
+public:
+    /**
+     * Builds a new APDU request from the provided command bytes.
+     *
+     * @param apdu The command bytes (at least 4 bytes).
+     * @since 2.1.0
+     */
+    explicit ApduRequestAdapter(const ByteSpan apdu)
+    : mApdu(apdu)
+    , mIsLegacyApduBuilt(false)
+    , mSuccessfulStatusWords(StatusWordSet::getDefault()) {
+    }
+
+    /**
+     * Adds a status word to the list of those considered successful for this APDU.
+     *
+     * @param successfulStatusWord The status word to add.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    ApduRequestAdapter&
+    addSuccessfulStatusWord(const int successfulStatusWord) {
+        mSuccessfulStatusWords = StatusWordSet::Builder()
+                                     .addAll(*mSuccessfulStatusWords)
+                                     .add(successfulStatusWord)
+                                     .build();
+
+        return *this;
+    }
+
+    /**
+     * Replaces the set of status words considered successful for this APDU.
+     *
+     * <p>This allows a single precomputed set to be shared between many requests.
+     *
+     * @param successfulStatusWords The set (must contain 9000h).
+     * @return The current instance.
+     * @throw std::invalid_argument If the set is null or does not contain 9000h.
+     * @since 2.1.0
+     */
+    ApduRequestAdapter&
+    setSuccessfulStatusWords(const std::shared_ptr<const StatusWordSet>& successfulStatusWords) {
+        if (successfulStatusWords == nullptr) {
+            throw std::invalid_argument("Null successful status words");
+        }
+        if (!successfulStatusWords->contains(0x9000)) {
+            throw std::invalid_argument("Successful status words without 9000h");
+        }
+        mSuccessfulStatusWords = successfulStatusWords;
+
+        return *this;
+    }
+
+    /**
+     * Sets the information about this APDU request (e.g. command name).
+     *
+     * @param info The information.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    ApduRequestAdapter&
+    setInfo(const std::string& info) {
+        mInfo = info;
+
+        return *this;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The first call copies the APDU bytes into a new vector which becomes the storage of the
+     * APDU.
+     *
+     * @since 2.1.0
+     */
+    std::vector<uint8_t>&
+    getApdu() override {
+        if (!mIsLegacyApduBuilt) {
+            mLegacyApdu = mApdu.view().toVector();
+            mApdu.clear();
+            mIsLegacyApduBuilt = true;
+        }
+
+        return mLegacyApdu;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ByteSpan
+    getApduView() override {
+        return mIsLegacyApduBuilt ? ByteSpan(mLegacyApdu) : mApdu.view();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<int>&
+    getSuccessfulStatusWords() const override {
+        return mSuccessfulStatusWords->getStatusWords();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<const StatusWordSet>
+    getSuccessfulStatusWordSet() const override {
+        return mSuccessfulStatusWords;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool
+    isSuccessfulStatusWord(const int statusWord) const override {
+        return mSuccessfulStatusWords->contains(statusWord);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string&
+    getInfo() const override {
+        return mInfo;
+    }
+
+private:
+    /**
+     *
+     */
+    ApduCommandBuffer mApdu;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mLegacyApdu;
+
+    /**
+     *
+     */
+    bool mIsLegacyApduBuilt;
+
+    /**
+     *
+     */
+    std::shared_ptr<const StatusWordSet> mSuccessfulStatusWords;
+
+    /**
+     *
+     */
+    std::string mInfo;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
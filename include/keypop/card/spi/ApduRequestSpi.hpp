@@ -15,6 +15,12 @@
 #include <string>
 #include <vector>
 
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/HexFormat.hpp"
+#include "keypop/card/StatusWordFormat.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+
 namespace keypop {
 namespace card {
 namespace spi {
@@ -40,6 +46,43 @@ public:
      */
     virtual std::vector<uint8_t>& getApdu() = 0;
 
+    /**
+     * Gets a view over the APDU bytes to be sent to the card, without copying them.
+     *
+     * <p>The header fields are available in place: CLA, INS, P1 and P2 are respectively the bytes
+     * at index 0, 1, 2 and 3 of the view.
+     *
+     * <p>The default implementation refers to the storage returned by getApdu(). Implementations
+     * keeping the command bytes in another storage should override it.
+     *
+     * @return A view of at least 4 bytes, valid as long as this object is alive and unchanged.
+     * @since 2.1.0
+     */
+    virtual ByteSpan
+    getApduView() {
+        return ByteSpan(getApdu());
+    }
+
+    /**
+     * Gets the structured description of the command, when its data field is provided as
+     * segments to be encoded by the reader.
+     *
+     * <p>When it is not null, readers able to do so encode the command from this description (see
+     * keypop::card::ApduCommandEncoder), using an extended-length APDU or command chaining if
+     * needed, instead of sending getApduView(). The response to the last exchange is the response
+     * to this request. getApdu() and getApduView() still provide the command as a single APDU for
+     * the other readers.
+     *
+     * <p>The default implementation returns null (the command is getApduView()).
+     *
+     * @return Null if the command is only available as raw bytes.
+     * @since 2.1.0
+     */
+    virtual const ApduCommand*
+    getSegmentedCommand() const {
+        return nullptr;
+    }
+
     /**
      * Gets the list of status words that must be considered successful for the APDU.
      *
@@ -48,6 +91,57 @@ public:
      */
     virtual const std::vector<int>& getSuccessfulStatusWords() const = 0;
 
+    /**
+     * Gets the set of status words that must be considered successful for the APDU, allowing a
+     * constant time check of each received status word.
+     *
+     * <p>The default implementation caches keypop::card::StatusWordSet::of() for
+     * getSuccessfulStatusWords() in the request, the set being only built again when the list
+     * changes. Implementations keeping their own set should override it to return it.
+     *
+     * @return A not null reference containing the same values as getSuccessfulStatusWords().
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<const StatusWordSet>
+    getSuccessfulStatusWordSet() const {
+        const std::vector<int>& statusWords = getSuccessfulStatusWords();
+        std::shared_ptr<const StatusWordSetCache> cache
+            = std::atomic_load(&mStatusWordSetCache);
+        if (cache == nullptr || cache->statusWords != statusWords) {
+            /* Built out of any lock: concurrent callers may build it too, the last one is kept */
+            const std::shared_ptr<StatusWordSetCache> newCache
+                = std::make_shared<StatusWordSetCache>();
+            newCache->statusWords = statusWords;
+            newCache->statusWordSet = StatusWordSet::of(statusWords);
+            cache = newCache;
+            std::atomic_store(&mStatusWordSetCache, cache);
+        }
+
+        return cache->statusWordSet;
+    }
+
+    /**
+     * Indicates whether a status word received for the APDU is successful.
+     *
+     * <p>Readers call it for each APDU response. The default implementation scans
+     * getSuccessfulStatusWords(), without allocation nor lock. Implementations caching a
+     * keypop::card::StatusWordSet should override it to check it in constant time.
+     *
+     * @param statusWord The status word.
+     * @return True if the status word belongs to getSuccessfulStatusWords().
+     * @since 2.1.0
+     */
+    virtual bool
+    isSuccessfulStatusWord(const int statusWord) const {
+        for (const int successfulStatusWord : getSuccessfulStatusWords()) {
+            if (successfulStatusWord == statusWord) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     /**
      * Gets the information about this APDU request (e.g. command name).
      *
@@ -64,8 +158,9 @@ public:
     friend std::ostream&
     operator<<(std::ostream& os, ApduRequestSpi& ars) {
         os << "APDU_REQUEST_SPI: {"
-           << "APDU: " << ars.getApdu() << ", "
-           << "SUCCESSFUL_STATUS_WORDS: " << ars.getSuccessfulStatusWords() << ", "
+           << "APDU: " << HexFormat(ars.getApduView()) << ", "
+           << "SUCCESSFUL_STATUS_WORDS: " << StatusWordFormat(ars.getSuccessfulStatusWords())
+           << ", "
            << "INFO: " << ars.getInfo() << "}";
 
         return os;
@@ -103,6 +198,20 @@ public:
 
         return os;
     }
+
+private:
+    /**
+     * Set built by the default getSuccessfulStatusWordSet(), with the list it was built from.
+     */
+    struct StatusWordSetCache {
+        std::vector<int> statusWords;
+        std::shared_ptr<const StatusWordSet> statusWordSet;
+    };
+
+    /**
+     *
+     */
+    mutable std::shared_ptr<const StatusWordSetCache> mStatusWordSetCache;
 };
 
 } /* namespace spi */
@@ -0,0 +1,61 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "keypop/card/ApduResponseApi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Observer notified of each APDU response as soon as it is received from the card, while the
+ * processing of the keypop::card::spi::CardRequestSpi it belongs to is still in progress.
+ *
+ * <p>It allows the responses of a long request (e.g. reading many records) to be parsed while the
+ * following APDUs are being exchanged with the card.
+ *
+ * <p>The reader invokes the observer on its processing thread, before sending the next APDU. The
+ * implementation must therefore return quickly, typically by handing the response over to another
+ * thread.
+ *
+ * @see keypop::card::spi::CardRequestSpi::getApduResponseObserver()
+ * @since 2.1.0
+ */
+class ApduResponseObserverSpi {
+public:
+    /**
+     * Virtual destructor.
+     */
+    virtual ~ApduResponseObserverSpi() = default;
+
+    /**
+     * Invoked for each APDU response received, in the order of the requests.
+     *
+     * <p>The same keypop::card::ApduResponseApi instances are later found in the
+     * keypop::card::CardResponseApi of the request (or in the partial response carried by a
+     * keypop::card::AbstractApduException).
+     *
+     * @param index The index of the corresponding APDU request in
+     *        keypop::card::spi::CardRequestSpi::getApduRequests().
+     * @param apduResponse The APDU response (not null).
+     * @since 2.1.0
+     */
+    virtual void
+    onApduResponse(const std::size_t index, const std::shared_ptr<ApduResponseApi> apduResponse)
+        = 0;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,213 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Non-owning view over the APDUs of a card request stored back-to-back in one contiguous block,
+ * with an offset table.
+ *
+ * <p>It gives readers a bulk access to the command bytes and successful status words of all the
+ * APDUs of a request without any virtual call, reference counting nor pointer chasing per APDU
+ * (see keypop::card::spi::CardRequestSpi::getApduSequence()).
+ *
+ * <p>A view is only valid as long as the card request it comes from is alive and not modified.
+ *
+ * @since 2.1.0
+ */
+class ApduSequenceView final {
+public:
+    /**
+     * Location and successful status words of one APDU.
+     *
+     * @since 2.1.0
+     */
+    struct Entry {
+        /**
+         * Offset of the first byte of the APDU in the block.
+         *
+         * @since 2.1.0
+         */
+        std::size_t offset;
+
+        /**
+         * Number of bytes of the APDU.
+         *
+         * @since 2.1.0
+         */
+        std::size_t length;
+
+        /**
+         * Status words considered successful for the APDU (not null).
+         *
+         * @since 2.1.0
+         */
+        const StatusWordSet* successfulStatusWords;
+    };
+
+    /**
+     * Builds an empty view, meaning that the card request does not provide a bulk access.
+     *
+     * @since 2.1.0
+     */
+    constexpr ApduSequenceView() noexcept
+    : mBytes(nullptr)
+    , mEntries(nullptr)
+    , mInfos(nullptr)
+    , mSize(0) {
+    }
+
+    /**
+     * Builds a view over a block of APDUs.
+     *
+     * @param bytes The first byte of the block.
+     * @param entries The first entry of the offset table.
+     * @param size The number of APDUs.
+     * @param infos The first information string, one per APDU (null if not provided).
+     * @since 2.1.0
+     */
+    constexpr ApduSequenceView(
+        const uint8_t* bytes,
+        const Entry* entries,
+        const std::size_t size,
+        const std::string* infos = nullptr) noexcept
+    : mBytes(bytes)
+    , mEntries(entries)
+    , mInfos(infos)
+    , mSize(size) {
+    }
+
+    /**
+     * Gets the number of APDUs.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    constexpr std::size_t
+    size() const noexcept {
+        return mSize;
+    }
+
+    /**
+     * Indicates if the view is empty.
+     *
+     * @return True if the view contains no APDU.
+     * @since 2.1.0
+     */
+    constexpr bool
+    empty() const noexcept {
+        return mSize == 0;
+    }
+
+    /**
+     * Gets the command bytes of an APDU.
+     *
+     * @param index The index of the APDU, lower than size() (not checked).
+     * @return A view on the block.
+     * @since 2.1.0
+     */
+    constexpr ByteSpan
+    getApdu(const std::size_t index) const noexcept {
+        return ByteSpan(mBytes + mEntries[index].offset, mEntries[index].length);
+    }
+
+    /**
+     * Gets the block of bytes holding the APDUs.
+     *
+     * @return A view from the first byte of the block to the end of its last APDU.
+     * @since 2.1.0
+     */
+    ByteSpan
+    getBlock() const noexcept {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < mSize; i++) {
+            if (mEntries[i].offset + mEntries[i].length > size) {
+                size = mEntries[i].offset + mEntries[i].length;
+            }
+        }
+
+        return ByteSpan(mBytes, size);
+    }
+
+    /**
+     * Builds a view over another block, typically a patched copy of getBlock(), sharing the
+     * offset table, the successful status words and the information of this view.
+     *
+     * @param bytes The first byte of the other block, at least as long as getBlock().
+     * @return A view valid as long as this view and the other block.
+     * @since 2.1.0
+     */
+    constexpr ApduSequenceView
+    withBlock(const uint8_t* bytes) const noexcept {
+        return ApduSequenceView(bytes, mEntries, mSize, mInfos);
+    }
+
+    /**
+     * Gets the successful status words of an APDU.
+     *
+     * @param index The index of the APDU, lower than size() (not checked).
+     * @return A reference valid as long as the view.
+     * @since 2.1.0
+     */
+    const StatusWordSet&
+    getSuccessfulStatusWords(const std::size_t index) const noexcept {
+        return *mEntries[index].successfulStatusWords;
+    }
+
+    /**
+     * Gets the information about an APDU (see keypop::card::spi::ApduRequestSpi::getInfo()).
+     *
+     * @param index The index of the APDU, lower than size() (not checked).
+     * @return A reference valid as long as the view, empty if the view provides no information.
+     * @since 2.1.0
+     */
+    const std::string&
+    getInfo(const std::size_t index) const {
+        static const std::string noInfo;
+
+        return mInfos != nullptr ? mInfos[index] : noInfo;
+    }
+
+private:
+    /**
+     *
+     */
+    const uint8_t* mBytes;
+
+    /**
+     *
+     */
+    const Entry* mEntries;
+
+    /**
+     *
+     */
+    const std::string* mInfos;
+
+    /**
+     *
+     */
+    std::size_t mSize;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
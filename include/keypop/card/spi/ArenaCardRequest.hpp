@@ -0,0 +1,123 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduArena.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+#include "keypop/card/spi/ApduSequenceView.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Implementation of keypop::card::spi::CardRequestSpi storing all its APDUs back-to-back in a
+ * single keypop::card::spi::ApduArena.
+ *
+ * <p>Readers iterate over the APDUs through getApduSequence() without virtual call nor pointer
+ * chasing per APDU. The keypop::card::spi::ApduRequestSpi objects of getApduRequests() are only
+ * built for readers relying on this legacy accessor.
+ *
+ * @since 2.1.0
+ */
+class ArenaCardRequest final : public CardRequestSpi {
+public:
+    /**
+     * Builds an empty card request.
+     *
+     * @param stopOnUnsuccessfulStatusWord True if the processing must stop at the first
+     *        unsuccessful status word received.
+     * @param expectedApduCount The number of APDUs to reserve room for.
+     * @param expectedByteCount The total number of APDU bytes to reserve room for.
+     * @since 2.1.0
+     */
+    explicit ArenaCardRequest(
+        const bool stopOnUnsuccessfulStatusWord,
+        const std::size_t expectedApduCount = 0,
+        const std::size_t expectedByteCount = 0)
+    : mArena(expectedApduCount, expectedByteCount)
+    , mStopOnUnsuccessfulStatusWord(stopOnUnsuccessfulStatusWord) {
+    }
+
+    /**
+     * Appends an APDU to the request.
+     *
+     * @param apdu The command bytes (at least 4 bytes).
+     * @param successfulStatusWords The successful status words (null for the default set).
+     * @param info The information about the APDU.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    ArenaCardRequest&
+    addApdu(
+        const ByteSpan apdu,
+        const std::shared_ptr<const StatusWordSet>& successfulStatusWords = nullptr,
+        const std::string& info = "") {
+        mArena.addApdu(apdu, successfulStatusWords, info);
+
+        return *this;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The APDU requests are views on the arena, built on the first call.
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<ApduRequestSpi>>&
+    getApduRequests() const override {
+        return mArena.getApduRequests();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool
+    stopOnUnsuccessfulStatusWord() const override {
+        return mStopOnUnsuccessfulStatusWord;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ApduSequenceView
+    getApduSequence() const override {
+        return mArena.getSequence();
+    }
+
+private:
+    /**
+     *
+     */
+    ApduArena mArena;
+
+    /**
+     *
+     */
+    const bool mStopOnUnsuccessfulStatusWord;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
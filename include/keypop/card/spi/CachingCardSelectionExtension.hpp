@@ -0,0 +1,334 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/CardResponseApi.hpp"
+#include "keypop/card/CardSelectionResponse.hpp"
+#include "keypop/card/spi/CardSelectionExtensionSpi.hpp"
+#include "keypop/card/spi/CardSelectionRequestSpi.hpp"
+#include "keypop/card/spi/SmartCardSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Decorator of keypop::card::spi::CardSelectionExtensionSpi caching the parsed
+ * keypop::card::spi::SmartCardSpi in a bounded LRU cache.
+ *
+ * <p>The cache key is made of all the data the parsing depends on: the matching status, the
+ * power-on data, the bytes of the response to the <b>Select Application</b> command and the bytes
+ * of the responses to the other APDUs of the selection request, a missing response being
+ * distinguished from an empty one. When the same card is presented again with identical
+ * selection data, the previously parsed smart card is returned without calling the decorated
+ * extension. Parsing failures are not cached, nor the null smart cards an extension may return,
+ * which are returned as is.
+ *
+ * <p>Since the smart card objects are usually updated by the card extension after parsing, a
+ * cloner is applied to the cached instance before returning it, on each call. Only if the smart
+ * card objects are immutable may the cloner return the cached instance itself.
+ *
+ * <p>The cache lives as long as the decorator (typically a session of the terminal); it is not
+ * saved anywhere. This class is thread safe if the decorated extension is.
+ *
+ * @since 2.1.0
+ */
+class CachingCardSelectionExtension final : public CardSelectionExtensionSpi {
+public:
+    /**
+     * Function creating an independent copy of a cached smart card.
+     *
+     * @since 2.1.0
+     */
+    using SmartCardCloner
+        = std::function<std::shared_ptr<SmartCardSpi>(const std::shared_ptr<SmartCardSpi>&)>;
+
+    /**
+     * Builds a new caching decorator.
+     *
+     * @param extension The decorated extension (not null).
+     * @param cloner The function applied to a cached smart card before returning it (not null).
+     *        It may return its argument only if the smart card objects are immutable.
+     * @param capacity The maximum number of cached smart cards (at least 1).
+     * @throw std::invalid_argument If the extension or the cloner is null.
+     * @since 2.1.0
+     */
+    CachingCardSelectionExtension(
+        const std::shared_ptr<CardSelectionExtensionSpi>& extension,
+        const SmartCardCloner& cloner,
+        const std::size_t capacity = 64)
+    : mExtension(extension)
+    , mCapacity(capacity > 0 ? capacity : 1)
+    , mCloner(cloner)
+    , mHitCount(0)
+    , mMissCount(0) {
+        if (extension == nullptr) {
+            throw std::invalid_argument("Null extension");
+        }
+        if (!mCloner) {
+            throw std::invalid_argument("Null cloner");
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::shared_ptr<CardSelectionRequestSpi>
+    getCardSelectionRequest() const override {
+        return mExtension->getCardSelectionRequest();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The decorated extension is only called if the selection data is not in the cache.
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<SmartCardSpi>
+    parse(
+        const std::shared_ptr<CardSelectionResponseApi> cardSelectionResponseApi) const override {
+        const std::string key = buildKey(*cardSelectionResponseApi);
+        std::shared_ptr<SmartCardSpi> smartCard = find(key);
+        if (smartCard == nullptr) {
+            smartCard = mExtension->parse(cardSelectionResponseApi);
+            if (smartCard == nullptr) {
+                return nullptr;
+            }
+            insert(key, smartCard);
+        }
+
+        return mCloner(smartCard);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The decorated extension is only called if the selection data is not in the cache.
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<SmartCardSpi>
+    parse(const CardSelectionResponseApi& cardSelectionResponseApi) const override {
+        const std::string key = buildKey(cardSelectionResponseApi);
+        std::shared_ptr<SmartCardSpi> smartCard = find(key);
+        if (smartCard == nullptr) {
+            smartCard = mExtension->parse(cardSelectionResponseApi);
+            if (smartCard == nullptr) {
+                return nullptr;
+            }
+            insert(key, smartCard);
+        }
+
+        return mCloner(smartCard);
+    }
+
+    /**
+     * Removes all the cached smart cards.
+     *
+     * @since 2.1.0
+     */
+    void
+    clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEntries.clear();
+        mIndex.clear();
+    }
+
+    /**
+     * Gets the number of cached smart cards.
+     *
+     * @return A value lower or equal to the capacity.
+     * @since 2.1.0
+     */
+    std::size_t
+    size() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mEntries.size();
+    }
+
+    /**
+     * Gets the number of parsings served from the cache.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getHitCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mHitCount;
+    }
+
+    /**
+     * Gets the number of parsings delegated to the decorated extension.
+     *
+     * @return A positive or null value.
+     * @since 2.1.0
+     */
+    std::size_t
+    getMissCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mMissCount;
+    }
+
+private:
+    /**
+     *
+     */
+    using Entry = std::pair<std::string, std::shared_ptr<SmartCardSpi>>;
+
+    /**
+     * Appends a length-prefixed field to a key, so that distinct field splits give distinct keys.
+     */
+    static void
+    appendField(std::string& key, const ByteSpan field) {
+        const std::size_t size = field.size();
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            key.push_back(static_cast<char>(size >> shift));
+        }
+        if (size != 0) {
+            key.append(reinterpret_cast<const char*>(field.data()), size);
+        }
+    }
+
+    /**
+     *
+     */
+    static std::string
+    buildKey(const CardSelectionResponseApi& cardSelectionResponseApi) {
+        const std::string& powerOnData = cardSelectionResponseApi.getPowerOnData();
+        const std::shared_ptr<ApduResponseApi> selectApplicationResponse
+            = cardSelectionResponseApi.getSelectApplicationResponse();
+        const std::shared_ptr<CardResponseApi> cardResponse
+            = cardSelectionResponseApi.getCardResponse();
+
+        std::string key;
+        key.reserve(256);
+        key.push_back(cardSelectionResponseApi.hasMatched() ? 1 : 0);
+        appendField(
+            key,
+            ByteSpan(reinterpret_cast<const uint8_t*>(powerOnData.data()), powerOnData.size()));
+        /* Presence markers of the optional fields */
+        key.push_back(selectApplicationResponse != nullptr ? 1 : 0);
+        if (selectApplicationResponse != nullptr) {
+            appendField(key, selectApplicationResponse->getApduView());
+        }
+        key.push_back(cardResponse != nullptr ? 1 : 0);
+        if (cardResponse != nullptr) {
+            for (const auto& apduResponse : cardResponse->getApduResponses()) {
+                appendField(key, apduResponse->getApduView());
+            }
+        }
+
+        return key;
+    }
+
+    /**
+     * Gets a cached smart card and marks it as the most recently used one.
+     */
+    std::shared_ptr<SmartCardSpi>
+    find(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const auto it = mIndex.find(key);
+        if (it == mIndex.end()) {
+            mMissCount++;
+            return nullptr;
+        }
+        mHitCount++;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+
+        return it->second->second;
+    }
+
+    /**
+     * Caches a smart card, evicting the least recently used one if the cache is full.
+     */
+    void
+    insert(const std::string& key, const std::shared_ptr<SmartCardSpi>& smartCard) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        const auto it = mIndex.find(key);
+        if (it != mIndex.end()) {
+            /* Parsed concurrently by another thread */
+            mEntries.splice(mEntries.begin(), mEntries, it->second);
+            return;
+        }
+        if (mEntries.size() >= mCapacity) {
+            mIndex.erase(mEntries.back().first);
+            mEntries.pop_back();
+        }
+        mEntries.emplace_front(key, smartCard);
+        mIndex[key] = mEntries.begin();
+    }
+
+    /**
+     *
+     */
+    const std::shared_ptr<CardSelectionExtensionSpi> mExtension;
+
+    /**
+     *
+     */
+    const std::size_t mCapacity;
+
+    /**
+     *
+     */
+    const SmartCardCloner mCloner;
+
+    /**
+     *
+     */
+    mutable std::mutex mMutex;
+
+    /**
+     * Most recently used first.
+     */
+    mutable std::list<Entry> mEntries;
+
+    /**
+     *
+     */
+    mutable std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+
+    /**
+     *
+     */
+    mutable std::size_t mHitCount;
+
+    /**
+     *
+     */
+    mutable std::size_t mMissCount;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,227 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "keypop/card/spi/ApduChainingSpi.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+#include "keypop/card/spi/ApduResponseObserverSpi.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Default implementation of keypop::card::spi::CardRequestSpi holding a list of APDU requests.
+ *
+ * @since 2.1.0
+ */
+class CardRequestAdapter final : public CardRequestSpi {
+public:
+    /**
+     * Builds an empty card request.
+     *
+     * @param stopOnUnsuccessfulStatusWord True if the processing must stop at the first
+     *        unsuccessful status word received.
+     * @param expectedApduRequestCount The number of APDU requests to reserve room for.
+     * @since 2.1.0
+     */
+    explicit CardRequestAdapter(
+        const bool stopOnUnsuccessfulStatusWord, const std::size_t expectedApduRequestCount = 0)
+    : mStopOnUnsuccessfulStatusWord(stopOnUnsuccessfulStatusWord)
+    , mDeadline(std::chrono::steady_clock::time_point::max())
+    , mApduTimeout(std::chrono::microseconds::zero()) {
+        mApduRequests.reserve(expectedApduRequestCount);
+    }
+
+    /**
+     * Adds an APDU request at the end of the list.
+     *
+     * @param apduRequest The APDU request (not null).
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    CardRequestAdapter&
+    addApduRequest(const std::shared_ptr<ApduRequestSpi>& apduRequest) {
+        mApduRequests.push_back(apduRequest);
+
+        return *this;
+    }
+
+    /**
+     * Attaches an observer notified of each APDU response as soon as it is received.
+     *
+     * @param apduResponseObserver The observer (null to detach).
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    CardRequestAdapter&
+    setApduResponseObserver(const std::shared_ptr<ApduResponseObserverSpi>& apduResponseObserver) {
+        mApduResponseObserver = apduResponseObserver;
+
+        return *this;
+    }
+
+    /**
+     * Sets the generator of the APDU requests to be chained after each exchange.
+     *
+     * @param apduChaining The generator (null for none).
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    CardRequestAdapter&
+    setApduChaining(const std::shared_ptr<ApduChainingSpi>& apduChaining) {
+        mApduChaining = apduChaining;
+
+        return *this;
+    }
+
+    /**
+     * Sets the time before which the whole request must be processed.
+     *
+     * @param deadline A time point of the steady clock (the maximum one for no deadline).
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    CardRequestAdapter&
+    setDeadline(const std::chrono::steady_clock::time_point deadline) {
+        mDeadline = deadline;
+
+        return *this;
+    }
+
+    /**
+     * Sets the deadline of the request relatively to now.
+     *
+     * @param budget The time allowed to process the whole request from now.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    CardRequestAdapter&
+    setTimeout(const std::chrono::microseconds budget) {
+        mDeadline = std::chrono::steady_clock::now() + budget;
+
+        return *this;
+    }
+
+    /**
+     * Sets the maximum time to wait for the response to each APDU.
+     *
+     * @param apduTimeout The timeout (zero for none).
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    CardRequestAdapter&
+    setApduTimeout(const std::chrono::microseconds apduTimeout) {
+        mApduTimeout = apduTimeout;
+
+        return *this;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<ApduRequestSpi>>&
+    getApduRequests() const override {
+        return mApduRequests;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool
+    stopOnUnsuccessfulStatusWord() const override {
+        return mStopOnUnsuccessfulStatusWord;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<ApduResponseObserverSpi>
+    getApduResponseObserver() const override {
+        return mApduResponseObserver;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<ApduChainingSpi>
+    getApduChaining() const override {
+        return mApduChaining;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::chrono::steady_clock::time_point
+    getDeadline() const override {
+        return mDeadline;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::chrono::microseconds
+    getApduTimeout() const override {
+        return mApduTimeout;
+    }
+
+private:
+    /**
+     *
+     */
+    std::vector<std::shared_ptr<ApduRequestSpi>> mApduRequests;
+
+    /**
+     *
+     */
+    const bool mStopOnUnsuccessfulStatusWord;
+
+    /**
+     *
+     */
+    std::shared_ptr<ApduResponseObserverSpi> mApduResponseObserver;
+
+    /**
+     *
+     */
+    std::shared_ptr<ApduChainingSpi> mApduChaining;
+
+    /**
+     *
+     */
+    std::chrono::steady_clock::time_point mDeadline;
+
+    /**
+     *
+     */
+    std::chrono::microseconds mApduTimeout;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
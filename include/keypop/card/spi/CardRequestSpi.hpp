@@ -9,10 +9,14 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
+#include "keypop/card/spi/ApduChainingSpi.hpp"
 #include "keypop/card/spi/ApduRequestSpi.hpp"
+#include "keypop/card/spi/ApduResponseObserverSpi.hpp"
+#include "keypop/card/spi/ApduSequenceView.hpp"
 
 namespace keypop {
 namespace card {
@@ -50,6 +54,88 @@ public:
      * @since 1.0.0
      */
     virtual bool stopOnUnsuccessfulStatusWord() const = 0;
+
+    /**
+     * Gets the observer to notify of each APDU response as soon as it is received.
+     *
+     * <p>The default implementation returns null (no streaming notification).
+     *
+     * @return Null if no observer is attached to this request.
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<ApduResponseObserverSpi>
+    getApduResponseObserver() const {
+        return nullptr;
+    }
+
+    /**
+     * Gets the generator of the APDU requests to be chained after each exchange.
+     *
+     * <p>The responses to the generated requests are notified to the observer (if any) with the
+     * index of the APDU request that started the chain.
+     *
+     * <p>The default implementation returns null (fixed list of APDU requests).
+     *
+     * @return Null if the APDU requests are only those of getApduRequests().
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<ApduChainingSpi>
+    getApduChaining() const {
+        return nullptr;
+    }
+
+    /**
+     * Gets a bulk view on the APDUs of the request, when they are stored in one contiguous block.
+     *
+     * <p>When it is not empty, the view describes the same APDUs, in the same order, as
+     * getApduRequests(). Readers may then iterate over the command bytes and the successful status
+     * words with a single virtual call per request instead of several per APDU. The view is valid
+     * as long as the request is alive and not modified.
+     *
+     * <p>The default implementation returns an empty view (no bulk access, getApduRequests() must
+     * be used).
+     *
+     * @return An empty view if the request does not provide a bulk access.
+     * @since 2.1.0
+     */
+    virtual ApduSequenceView
+    getApduSequence() const {
+        return ApduSequenceView();
+    }
+
+    /**
+     * Gets the time before which the whole request must be processed (e.g. the budget of a
+     * contactless tap).
+     *
+     * <p>Readers check it before sending each APDU: once it is reached, the remaining APDUs are not
+     * sent and keypop::card::CardRequestTimeoutException is thrown with the partial response.
+     *
+     * <p>The default implementation returns the maximum time point (no deadline).
+     *
+     * @return A time point of the steady clock.
+     * @since 2.1.0
+     */
+    virtual std::chrono::steady_clock::time_point
+    getDeadline() const {
+        return std::chrono::steady_clock::time_point::max();
+    }
+
+    /**
+     * Gets the maximum time to wait for the response to each APDU.
+     *
+     * <p>When a response is not received in time, the reader stops waiting, closes the logical
+     * channel (the state of the card is unknown) and throws
+     * keypop::card::CardRequestTimeoutException with the partial response.
+     *
+     * <p>The default implementation returns zero (no timeout).
+     *
+     * @return Zero if the reader waits as long as needed.
+     * @since 2.1.0
+     */
+    virtual std::chrono::microseconds
+    getApduTimeout() const {
+        return std::chrono::microseconds::zero();
+    }
 };
 
 } /* namespace spi */
@@ -0,0 +1,262 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduArena.hpp"
+#include "keypop/card/spi/ApduSequenceView.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Immutable precompiled sequence of APDU commands with named variable fields.
+ *
+ * <p>The bytes of all the APDUs are stored back-to-back in a single contiguous block (see
+ * keypop::card::spi::ApduArena). A field designates a range of bytes of one APDU (P1/P2,
+ * challenge, counter...) whose value changes from one execution to the next.
+ *
+ * <p>A template is built once (see keypop::card::spi::CardRequestTemplate::Builder) and shared,
+ * including between threads. Each execution uses a keypop::card::spi::TemplateCardRequest, which
+ * copies the block and patches the fields.
+ *
+ * @since 2.1.0
+ */
+class CardRequestTemplate final {
+public:
+    /**
+     * Range of bytes of the block to be patched for each execution.
+     *
+     * @since 2.1.0
+     */
+    struct Field {
+        /**
+         * Offset of the first byte of the field in the block.
+         *
+         * @since 2.1.0
+         */
+        std::size_t offset;
+
+        /**
+         * Number of bytes of the field.
+         *
+         * @since 2.1.0
+         */
+        std::size_t length;
+    };
+
+    /**
+     * Builder of keypop::card::spi::CardRequestTemplate.
+     *
+     * @since 2.1.0
+     */
+    class Builder final {
+    public:
+        /**
+         * Builds an empty template builder.
+         *
+         * @param stopOnUnsuccessfulStatusWord True if the processing of the requests must stop at
+         *        the first unsuccessful status word received.
+         * @since 2.1.0
+         */
+        explicit Builder(const bool stopOnUnsuccessfulStatusWord = true)
+        : mTemplate(new CardRequestTemplate(stopOnUnsuccessfulStatusWord)) {
+        }
+
+        /**
+         * Adds an APDU at the end of the sequence.
+         *
+         * <p>APDUs are indexed from 0 in the order of addition. The bytes of the variable fields
+         * are placeholders (typically zeros).
+         *
+         * @param apdu The command bytes (at least 4 bytes).
+         * @param successfulStatusWords The successful status words (null for the default set).
+         * @param info The information about the APDU.
+         * @return The current instance.
+         * @since 2.1.0
+         */
+        Builder&
+        addApdu(
+            const ByteSpan apdu,
+            const std::shared_ptr<const StatusWordSet>& successfulStatusWords = nullptr,
+            const std::string& info = "") {
+            mTemplate->mArena.addApdu(apdu, successfulStatusWords, info);
+
+            return *this;
+        }
+
+        /**
+         * Declares a variable field in a previously added APDU.
+         *
+         * @param name The name of the field, unique in the template.
+         * @param apduIndex The index of the APDU.
+         * @param offset The offset of the field in the APDU (e.g. 2 for P1).
+         * @param length The number of bytes of the field.
+         * @return The current instance.
+         * @throw std::invalid_argument If the APDU does not exist, the range exceeds the APDU or
+         *        the name is already used.
+         * @since 2.1.0
+         */
+        Builder&
+        addField(
+            const std::string& name,
+            const std::size_t apduIndex,
+            const std::size_t offset,
+            const std::size_t length) {
+            if (apduIndex >= mTemplate->mArena.size()) {
+                throw std::invalid_argument("Unknown APDU index for field " + name);
+            }
+            const ApduSequenceView::Entry& apdu = mTemplate->mArena.getEntry(apduIndex);
+            if (offset > apdu.length || length > apdu.length - offset) {
+                throw std::invalid_argument("Field " + name + " exceeds its APDU");
+            }
+            if (mTemplate->mFieldIndexes.count(name) != 0) {
+                throw std::invalid_argument("Duplicate field " + name);
+            }
+
+            Field field;
+            field.offset = apdu.offset + offset;
+            field.length = length;
+            mTemplate->mFieldIndexes[name] = mTemplate->mFields.size();
+            mTemplate->mFields.push_back(field);
+
+            return *this;
+        }
+
+        /**
+         * Builds the template.
+         *
+         * <p>The builder must not be used afterwards.
+         *
+         * @return A not null reference.
+         * @since 2.1.0
+         */
+        std::shared_ptr<const CardRequestTemplate>
+        build() {
+            return std::shared_ptr<const CardRequestTemplate>(std::move(mTemplate));
+        }
+
+    private:
+        /**
+         *
+         */
+        std::unique_ptr<CardRequestTemplate> mTemplate;
+    };
+
+    /**
+     * Gets the index of a field, to be resolved once and then used for each patch.
+     *
+     * @param name The name of the field.
+     * @return The index of the field.
+     * @throw std::invalid_argument If the field does not exist.
+     * @since 2.1.0
+     */
+    std::size_t
+    getFieldIndex(const std::string& name) const {
+        const auto it = mFieldIndexes.find(name);
+        if (it == mFieldIndexes.end()) {
+            throw std::invalid_argument("Unknown field " + name);
+        }
+
+        return it->second;
+    }
+
+    /**
+     * Gets the contiguous block holding the bytes of all the APDUs, fields being set to their
+     * placeholder values.
+     *
+     * @return A view valid as long as the template is alive.
+     * @since 2.1.0
+     */
+    ByteSpan
+    getBytes() const {
+        return mArena.getBytes();
+    }
+
+    /**
+     * Gets the APDUs of the template, fields being set to their placeholder values.
+     *
+     * <p>The arena is meant to be copied (see keypop::card::spi::TemplateCardRequest); since the
+     * template is shared, keypop::card::spi::ApduArena::getApduRequests() must not be called on it.
+     *
+     * @return A not empty arena.
+     * @since 2.1.0
+     */
+    const ApduArena&
+    getApduArena() const {
+        return mArena;
+    }
+
+    /**
+     * Gets the description of the fields, in declaration order.
+     *
+     * @return A list, empty if the template has no variable field.
+     * @since 2.1.0
+     */
+    const std::vector<Field>&
+    getFields() const {
+        return mFields;
+    }
+
+    /**
+     * Indicates if the processing of the requests must stop when an unexpected status word is
+     * received.
+     *
+     * @return True if the process must stop at the first unsuccessful status word received.
+     * @since 2.1.0
+     */
+    bool
+    stopOnUnsuccessfulStatusWord() const {
+        return mStopOnUnsuccessfulStatusWord;
+    }
+
+private:
+    /**
+     *
+     */
+    explicit CardRequestTemplate(const bool stopOnUnsuccessfulStatusWord)
+    : mStopOnUnsuccessfulStatusWord(stopOnUnsuccessfulStatusWord) {
+    }
+
+    /**
+     *
+     */
+    ApduArena mArena;
+
+    /**
+     *
+     */
+    std::vector<Field> mFields;
+
+    /**
+     *
+     */
+    std::map<std::string, std::size_t> mFieldIndexes;
+
+    /**
+     *
+     */
+    const bool mStopOnUnsuccessfulStatusWord;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
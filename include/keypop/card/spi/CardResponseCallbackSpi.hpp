@@ -0,0 +1,64 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <exception>
+#include <memory>
+
+#include "keypop/card/CardResponseApi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Completion handler of an asynchronous card request transmission.
+ *
+ * <p>Exactly one of the two methods is invoked for each call to
+ * keypop::card::ProxyReaderApi::transmitCardRequestAsync(). Methods may be invoked from a thread
+ * owned by the reader; they must return quickly and must not wait for another request of the same
+ * reader to complete.
+ *
+ * @see keypop::card::ProxyReaderApi
+ * @since 2.1.0
+ */
+class CardResponseCallbackSpi {
+public:
+    /**
+     * Virtual destructor.
+     */
+    virtual ~CardResponseCallbackSpi() = default;
+
+    /**
+     * Invoked when all the APDUs of the card request have been processed successfully.
+     *
+     * @param cardResponse The card response, identical to the one that would have been returned by
+     *        keypop::card::ProxyReaderApi::transmitCardRequest().
+     * @since 2.1.0
+     */
+    virtual void onCardResponse(const std::shared_ptr<CardResponseApi> cardResponse) = 0;
+
+    /**
+     * Invoked when the processing of the card request has failed.
+     *
+     * <p>The provided exception is the one that would have been thrown by
+     * keypop::card::ProxyReaderApi::transmitCardRequest(). When it is a
+     * keypop::card::AbstractApduException, the responses received before the failure are
+     * available from it (rethrow the exception and catch it to access them).
+     *
+     * @param exception The failure cause (not null).
+     * @since 2.1.0
+     */
+    virtual void onCardRequestFailure(const std::exception_ptr exception) = 0;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
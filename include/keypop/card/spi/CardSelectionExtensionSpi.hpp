@@ -11,7 +11,10 @@
 
 #include <memory>
 
+#include "keypop/card/CardSelectionResponse.hpp"
+#include "keypop/card/CardSelectionResponseAdapter.hpp"
 #include "keypop/card/spi/CardSelectionRequestSpi.hpp"
+#include "keypop/card/spi/SmartCardSpi.hpp"
 
 namespace keypop {
 namespace card {
@@ -54,7 +57,35 @@ public:
      * @since 1.0.0
      */
     virtual std::shared_ptr<SmartCardSpi>
-    parse(const std::shared_ptr<CardSelectionRequestSpi> cardSelectionResponseApi) const = 0;
+    parse(const std::shared_ptr<CardSelectionResponseApi> cardSelectionResponseApi) const = 0;
+
+    /**
+     * Analyzes the response received from the card during the selection process and creates a
+     * SmartCardSpi, without taking a reference on the response.
+     *
+     * <p>This overload allows a caller owning the response to parse it without sharing it. The
+     * extension must not retain the response after the call.
+     *
+     * <p>The default implementation is only a compatibility shim for the extensions written before
+     * this overload, not a fast path: since the extension may keep the response in the returned
+     * SmartCardSpi, it delegates to the <b>std::shared_ptr</b> based overload with an owning copy
+     * of the response (a keypop::card::CardSelectionResponseAdapter referring to the same APDU and
+     * card responses), which costs one more allocation. Extensions should override it to parse the
+     * response directly.
+     *
+     * @param cardSelectionResponseApi The card selection response.
+     * @return A non-null reference.
+     * @throw ParseException If the card selection response parsing failed.
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<SmartCardSpi>
+    parse(const CardSelectionResponseApi& cardSelectionResponseApi) const {
+        return parse(std::make_shared<CardSelectionResponseAdapter>(
+            cardSelectionResponseApi.getPowerOnData(),
+            cardSelectionResponseApi.getSelectApplicationResponse(),
+            cardSelectionResponseApi.hasMatched(),
+            cardSelectionResponseApi.getCardResponse()));
+    }
 };
 
 } /* namespace spi */
@@ -13,6 +13,8 @@
 #include <ostream>
 #include <vector>
 
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/StatusWordSet.hpp"
 #include "keypop/card/spi/CardRequestSpi.hpp"
 
 namespace keypop {
@@ -30,11 +32,137 @@ namespace spi {
  */
 class CardSelectionRequestSpi {
 public:
+    /**
+     * Occurrence of the file to select among those matching the AID (P2 bits b2-b1 of the
+     * <b>Select Application</b> command).
+     *
+     * @since 2.1.0
+     */
+    enum class FileOccurrence {
+        /**
+         * First or only occurrence.
+         *
+         * @since 2.1.0
+         */
+        FIRST,
+
+        /**
+         * Last occurrence.
+         *
+         * @since 2.1.0
+         */
+        LAST,
+
+        /**
+         * Next occurrence.
+         *
+         * @since 2.1.0
+         */
+        NEXT,
+
+        /**
+         * Previous occurrence.
+         *
+         * @since 2.1.0
+         */
+        PREVIOUS
+    };
+
+    /**
+     * File control information requested in the response to the <b>Select Application</b>
+     * command (P2 bits b4-b3).
+     *
+     * @since 2.1.0
+     */
+    enum class FileControlInformation {
+        /**
+         * File control information template.
+         *
+         * @since 2.1.0
+         */
+        FCI,
+
+        /**
+         * File control parameters template.
+         *
+         * @since 2.1.0
+         */
+        FCP,
+
+        /**
+         * File management data template.
+         *
+         * @since 2.1.0
+         */
+        FMD,
+
+        /**
+         * No response data.
+         *
+         * @since 2.1.0
+         */
+        NO_RESPONSE
+    };
+
     /**
      * Virtual destructor.
      */
     virtual ~CardSelectionRequestSpi() = default;
 
+    /**
+     * Gets the AID of the application to select.
+     *
+     * <p>The default implementation returns an empty span, i.e. no <b>Select Application</b>
+     * command is sent and any card present matches.
+     *
+     * @return An empty span if no application selection is required (at most 16 bytes).
+     * @since 2.1.0
+     */
+    virtual ByteSpan
+    getAid() const {
+        return ByteSpan();
+    }
+
+    /**
+     * Gets the occurrence of the file to select.
+     *
+     * <p>The default implementation returns FileOccurrence::FIRST.
+     *
+     * @return A FileOccurrence value.
+     * @since 2.1.0
+     */
+    virtual FileOccurrence
+    getFileOccurrence() const {
+        return FileOccurrence::FIRST;
+    }
+
+    /**
+     * Gets the file control information requested from the card.
+     *
+     * <p>The default implementation returns FileControlInformation::FCI.
+     *
+     * @return A FileControlInformation value.
+     * @since 2.1.0
+     */
+    virtual FileControlInformation
+    getFileControlInformation() const {
+        return FileControlInformation::FCI;
+    }
+
+    /**
+     * Gets the status words of the <b>Select Application</b> response for which the card
+     * matches.
+     *
+     * <p>The default implementation returns keypop::card::StatusWordSet::getDefault().
+     *
+     * @return A not null set.
+     * @since 2.1.0
+     */
+    virtual std::shared_ptr<const StatusWordSet>
+    getSuccessfulSelectionStatusWordSet() const {
+        return StatusWordSet::getDefault();
+    }
+
     /**
      * Gets the card request.
      *
@@ -48,11 +176,23 @@ public:
      */
     friend std::ostream&
     operator<<(std::ostream& os, const std::shared_ptr<CardSelectionRequestSpi> csr) {
-        (void)csr;
+        if (csr == nullptr) {
+            os << "CARD_SELECTION_REQUEST_SPI: null";
+            return os;
+        }
 
         os << "CARD_SELECTION_REQUEST_SPI: {"
-           << "<TODO>"
-           << "}";
+           << "CARD_REQUEST = ";
+        const std::shared_ptr<CardRequestSpi> cardRequest = csr->getCardRequest();
+        if (cardRequest == nullptr) {
+            os << "null";
+        } else {
+            os << "{"
+               << "APDU_REQUESTS = " << cardRequest->getApduRequests() << ", "
+               << "STOP_ON_UNSUCCESSFUL_STATUS_WORD = "
+               << cardRequest->stopOnUnsuccessfulStatusWord() << "}";
+        }
+        os << "}";
 
         return os;
     }
@@ -0,0 +1,138 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "keypop/card/ApduBuffer.hpp"
+#include "keypop/card/ApduResponseApi.hpp"
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/spi/ApduChainingSpi.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Implementation of keypop::card::spi::ApduChainingSpi handling the ISO 7816-4 transport status
+ * words.
+ *
+ * <ul>
+ * <li><b>61xx</b>: a GET RESPONSE command (INS C0h) with Le = xx is sent.
+ * <li><b>6Cxx</b>: the previous command is sent again with Le = xx.
+ * </ul>
+ *
+ * <p>The generated requests keep the CLA byte, the successful status words and the information of
+ * the request they follow. The length of a chain is bounded to prevent endless dialogues with a
+ * misbehaving card.
+ *
+ * <p>An instance keeps track of the current chain and must not be shared between requests
+ * processed concurrently.
+ *
+ * @since 2.1.0
+ */
+class Iso7816ApduChaining final : public ApduChainingSpi {
+public:
+    /**
+     * Builds a new instance.
+     *
+     * @param maxChainLength The maximum number of requests generated in a row.
+     * @since 2.1.0
+     */
+    explicit Iso7816ApduChaining(const std::size_t maxChainLength = 16)
+    : mMaxChainLength(maxChainLength)
+    , mChainLength(0) {
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<ApduRequestSpi>
+    getNextApduRequest(
+        const std::shared_ptr<ApduRequestSpi> previousApduRequest,
+        const std::shared_ptr<ApduResponseApi> previousApduResponse) override {
+        if (previousApduRequest != mLastGeneratedApduRequest) {
+            mChainLength = 0;
+        }
+        mLastGeneratedApduRequest = nullptr;
+
+        const int statusWord = previousApduResponse->getStatusWord();
+        const uint8_t sw1 = static_cast<uint8_t>(statusWord >> 8);
+        const uint8_t sw2 = static_cast<uint8_t>(statusWord);
+        const ByteSpan previousApdu = previousApduRequest->getApduView();
+
+        if ((sw1 != 0x61 && sw1 != 0x6C) || previousApdu.size() < 4
+            || mChainLength >= mMaxChainLength) {
+            return nullptr;
+        }
+
+        ApduCommandBuffer apdu;
+        if (sw1 == 0x61) {
+            const uint8_t getResponse[] = {previousApdu[0], 0xC0, 0x00, 0x00, sw2};
+            apdu.assign(ByteSpan(getResponse, sizeof(getResponse)));
+        } else {
+            apdu.assign(previousApdu.first(getLeOffset(previousApdu)));
+            apdu.push_back(sw2);
+        }
+
+        auto nextApduRequest = std::make_shared<ApduRequestAdapter>(apdu.view());
+        nextApduRequest->setSuccessfulStatusWords(previousApduRequest->getSuccessfulStatusWordSet())
+            .setInfo(previousApduRequest->getInfo());
+
+        mChainLength++;
+        mLastGeneratedApduRequest = nextApduRequest;
+
+        return nextApduRequest;
+    }
+
+private:
+    /**
+     * Gets the offset of the Le byte of a short APDU, or its size if it has no Le byte.
+     */
+    static std::size_t
+    getLeOffset(const ByteSpan apdu) {
+        if (apdu.size() == 5) {
+            /* Case 2: CLA INS P1 P2 Le */
+            return 4;
+        }
+        if (apdu.size() > 5 && apdu.size() == 6 + static_cast<std::size_t>(apdu[4])) {
+            /* Case 4: CLA INS P1 P2 Lc Data Le */
+            return apdu.size() - 1;
+        }
+
+        /* Case 1 or 3: no Le */
+        return apdu.size();
+    }
+
+    /**
+     *
+     */
+    const std::size_t mMaxChainLength;
+
+    /**
+     *
+     */
+    std::size_t mChainLength;
+
+    /**
+     *
+     */
+    std::shared_ptr<ApduRequestSpi> mLastGeneratedApduRequest;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,214 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keypop/card/ApduBuffer.hpp"
+#include "keypop/card/ApduCommandEncoder.hpp"
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Implementation of keypop::card::spi::ApduRequestSpi described by a keypop::card::spi::ApduCommand
+ * whose data field is made of segments (e.g. a large file write).
+ *
+ * <p>Readers supporting keypop::card::spi::ApduRequestSpi::getSegmentedCommand() gather the data
+ * from the segments exchange by exchange. For the others, the command is encoded as a single
+ * (extended-length if needed) APDU on the first call of getApduView() or getApdu().
+ *
+ * @since 2.1.0
+ */
+class SegmentedApduRequest final : public ApduRequestSpi {
+public:
+    /**
+     * Builds a new APDU request.
+     *
+     * @param command The command, whose segments must remain valid as long as the request is in
+     *        use.
+     * @since 2.1.0
+     */
+    explicit SegmentedApduRequest(ApduCommand command)
+    : mCommand(std::move(command))
+    , mIsApduBuilt(false)
+    , mSuccessfulStatusWords(StatusWordSet::getDefault()) {
+    }
+
+    /**
+     * Replaces the set of status words considered successful for this APDU.
+     *
+     * @param successfulStatusWords The set (must contain 9000h).
+     * @return The current instance.
+     * @throw std::invalid_argument If the set is null or does not contain 9000h.
+     * @since 2.1.0
+     */
+    SegmentedApduRequest&
+    setSuccessfulStatusWords(const std::shared_ptr<const StatusWordSet>& successfulStatusWords) {
+        if (successfulStatusWords == nullptr) {
+            throw std::invalid_argument("Null successful status words");
+        }
+        if (!successfulStatusWords->contains(0x9000)) {
+            throw std::invalid_argument("Successful status words without 9000h");
+        }
+        mSuccessfulStatusWords = successfulStatusWords;
+
+        return *this;
+    }
+
+    /**
+     * Sets the information about this APDU request (e.g. command name).
+     *
+     * @param info The information.
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    SegmentedApduRequest&
+    setInfo(const std::string& info) {
+        mInfo = info;
+
+        return *this;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The first call encodes the command into a new vector.
+     *
+     * @throw std::invalid_argument If the data field exceeds the one of an extended-length APDU.
+     * @since 2.1.0
+     */
+    std::vector<uint8_t>&
+    getApdu() override {
+        if (mLegacyApdu.empty()) {
+            mLegacyApdu = getApduView().toVector();
+        }
+
+        return mLegacyApdu;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The first call encodes the command as a single APDU.
+     *
+     * @throw std::invalid_argument If the data field exceeds the one of an extended-length APDU.
+     * @since 2.1.0
+     */
+    ByteSpan
+    getApduView() override {
+        if (!mIsApduBuilt) {
+            const ApduCommandEncoder encoder(EXTENDED_APDU_COMMAND_MAX_LENGTH);
+            if (encoder.getExchangeCount(mCommand) != 1) {
+                throw std::invalid_argument("Command too long for a single APDU");
+            }
+            encoder.encode(mCommand, 0, mApdu);
+            mIsApduBuilt = true;
+        }
+
+        return mApdu.view();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const ApduCommand*
+    getSegmentedCommand() const override {
+        return &mCommand;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<int>&
+    getSuccessfulStatusWords() const override {
+        return mSuccessfulStatusWords->getStatusWords();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<const StatusWordSet>
+    getSuccessfulStatusWordSet() const override {
+        return mSuccessfulStatusWords;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool
+    isSuccessfulStatusWord(const int statusWord) const override {
+        return mSuccessfulStatusWords->contains(statusWord);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string&
+    getInfo() const override {
+        return mInfo;
+    }
+
+private:
+    /**
+     *
+     */
+    const ApduCommand mCommand;
+
+    /**
+     *
+     */
+    ApduCommandBuffer mApdu;
+
+    /**
+     *
+     */
+    bool mIsApduBuilt;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mLegacyApdu;
+
+    /**
+     *
+     */
+    std::shared_ptr<const StatusWordSet> mSuccessfulStatusWords;
+
+    /**
+     *
+     */
+    std::string mInfo;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,173 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/StaticApdu.hpp"
+#include "keypop/card/StaticStatusWords.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Implementation of keypop::card::spi::ApduRequestSpi viewing a constant command.
+ *
+ * <p>The command bytes are not copied: they are typically the static storage of a
+ * keypop::card::StaticApdu. An instance may be shared by any number of card requests and threads
+ * (of() provides such a shared instance per command type), provided that the <b>std::vector</b>
+ * returned by the legacy accessor getApdu(), which is only built on its first call and is common
+ * to all the callers, is never modified.
+ *
+ * @since 2.1.0
+ */
+class StaticApduRequest final : public ApduRequestSpi {
+public:
+    /**
+     * Builds a new APDU request viewing the provided command bytes.
+     *
+     * @param apdu The command bytes (at least 4 bytes), which must remain valid as long as the
+     *        request is alive.
+     * @param successfulStatusWords The successful status words (null for the default set).
+     * @param info The information about the APDU (e.g. command name).
+     * @since 2.1.0
+     */
+    explicit StaticApduRequest(
+        const ByteSpan apdu,
+        const std::shared_ptr<const StatusWordSet>& successfulStatusWords = nullptr,
+        const std::string& info = "")
+    : mApdu(apdu)
+    , mSuccessfulStatusWords(
+          successfulStatusWords != nullptr ? successfulStatusWords : StatusWordSet::getDefault())
+    , mInfo(info) {
+    }
+
+    /**
+     * Gets the shared request of a compile-time command.
+     *
+     * @tparam Apdu The command, a keypop::card::StaticApdu.
+     * @tparam SuccessfulStatusWords The successful status words, a
+     *         keypop::card::StaticStatusWords.
+     * @return A reference to an instance built on the first call.
+     * @since 2.1.0
+     */
+    template <typename Apdu, typename SuccessfulStatusWords = StaticStatusWords<0x9000>>
+    static const std::shared_ptr<StaticApduRequest>&
+    of() {
+        static const std::shared_ptr<StaticApduRequest> apduRequest
+            = std::make_shared<StaticApduRequest>(
+                Apdu::getBytes(), SuccessfulStatusWords::getSet());
+
+        return apduRequest;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The returned vector is a copy of the command, built on the first call and returned to all
+     * the callers: it must not be modified.
+     *
+     * @since 2.1.0
+     */
+    std::vector<uint8_t>&
+    getApdu() override {
+        std::call_once(mLegacyApduFlag, [this]() { mLegacyApdu = mApdu.toVector(); });
+
+        return mLegacyApdu;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ByteSpan
+    getApduView() override {
+        return mApdu;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<int>&
+    getSuccessfulStatusWords() const override {
+        return mSuccessfulStatusWords->getStatusWords();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    std::shared_ptr<const StatusWordSet>
+    getSuccessfulStatusWordSet() const override {
+        return mSuccessfulStatusWords;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool
+    isSuccessfulStatusWord(const int statusWord) const override {
+        return mSuccessfulStatusWords->contains(statusWord);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::string&
+    getInfo() const override {
+        return mInfo;
+    }
+
+private:
+    /**
+     *
+     */
+    const ByteSpan mApdu;
+
+    /**
+     *
+     */
+    const std::shared_ptr<const StatusWordSet> mSuccessfulStatusWords;
+
+    /**
+     *
+     */
+    const std::string mInfo;
+
+    /**
+     *
+     */
+    std::once_flag mLegacyApduFlag;
+
+    /**
+     *
+     */
+    std::vector<uint8_t> mLegacyApdu;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,212 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/spi/ApduArena.hpp"
+#include "keypop/card/spi/ApduRequestSpi.hpp"
+#include "keypop/card/spi/ApduSequenceView.hpp"
+#include "keypop/card/spi/CardRequestSpi.hpp"
+#include "keypop/card/spi/CardRequestTemplate.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Implementation of keypop::card::spi::CardRequestSpi instantiated from a
+ * keypop::card::spi::CardRequestTemplate.
+ *
+ * <p>The memory is allocated when the instance is built: a copy of the template
+ * keypop::card::spi::ApduArena, whose APDU requests are views on the copied block. An instance is
+ * then reused for each execution: reset() restores the template bytes with a single copy, then
+ * patch() writes the variable fields. The successful status words and the information of the
+ * APDUs are shared with the template.
+ *
+ * <p>An instance must not be modified while it is being transmitted. Use one instance per thread.
+ *
+ * @since 2.1.0
+ */
+class TemplateCardRequest final : public CardRequestSpi {
+public:
+    /**
+     * Builds a new instance holding a copy of the template bytes.
+     *
+     * @param cardRequestTemplate The template (not null).
+     * @since 2.1.0
+     */
+    explicit TemplateCardRequest(
+        const std::shared_ptr<const CardRequestTemplate>& cardRequestTemplate)
+    : mTemplate(cardRequestTemplate)
+    , mArena(cardRequestTemplate->getApduArena()) {
+    }
+
+    /**
+     *
+     */
+    TemplateCardRequest(const TemplateCardRequest&) = delete;
+
+    /**
+     *
+     */
+    TemplateCardRequest& operator=(const TemplateCardRequest&) = delete;
+
+    /**
+     * Restores the bytes of the template, fields included.
+     *
+     * @return The current instance.
+     * @since 2.1.0
+     */
+    TemplateCardRequest&
+    reset() {
+        const ByteSpan bytes = mTemplate->getBytes();
+        std::memcpy(mArena.getMutableBytes(), bytes.data(), bytes.size());
+
+        return *this;
+    }
+
+    /**
+     * Writes the value of a field.
+     *
+     * @param fieldIndex The index of the field (see
+     *        keypop::card::spi::CardRequestTemplate::getFieldIndex()).
+     * @param value The value, having the length of the field.
+     * @return The current instance.
+     * @throw std::invalid_argument If the field does not exist or the length does not match.
+     * @since 2.1.0
+     */
+    TemplateCardRequest&
+    patch(const std::size_t fieldIndex, const ByteSpan value) {
+        const CardRequestTemplate::Field& field = getField(fieldIndex);
+        if (value.size() != field.length) {
+            throw std::invalid_argument("Bad field value length");
+        }
+        std::memcpy(mArena.getMutableBytes() + field.offset, value.data(), value.size());
+
+        return *this;
+    }
+
+    /**
+     * Writes the value of a field as a big-endian unsigned integer (e.g. a counter, or P1 for a
+     * field of one byte).
+     *
+     * @param fieldIndex The index of the field (see
+     *        keypop::card::spi::CardRequestTemplate::getFieldIndex()).
+     * @param value The value, truncated to the length of the field.
+     * @return The current instance.
+     * @throw std::invalid_argument If the field does not exist.
+     * @since 2.1.0
+     */
+    TemplateCardRequest&
+    patch(const std::size_t fieldIndex, uint64_t value) {
+        const CardRequestTemplate::Field& field = getField(fieldIndex);
+        uint8_t* const bytes = mArena.getMutableBytes() + field.offset;
+        for (std::size_t i = field.length; i > 0; i--) {
+            bytes[i - 1] = static_cast<uint8_t>(value);
+            value >>= 8;
+        }
+
+        return *this;
+    }
+
+    /**
+     * Writes the value of a field designated by its name.
+     *
+     * <p>This resolves the name at each call; on the hot path, resolve the index once with
+     * keypop::card::spi::CardRequestTemplate::getFieldIndex().
+     *
+     * @param name The name of the field.
+     * @param value The value, having the length of the field.
+     * @return The current instance.
+     * @throw std::invalid_argument If the field does not exist or the length does not match.
+     * @since 2.1.0
+     */
+    TemplateCardRequest&
+    patch(const std::string& name, const ByteSpan value) {
+        return patch(mTemplate->getFieldIndex(name), value);
+    }
+
+    /**
+     * Gets the template of this instance.
+     *
+     * @return A not null reference.
+     * @since 2.1.0
+     */
+    const std::shared_ptr<const CardRequestTemplate>&
+    getTemplate() const {
+        return mTemplate;
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    const std::vector<std::shared_ptr<ApduRequestSpi>>&
+    getApduRequests() const override {
+        return mArena.getApduRequests();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    bool
+    stopOnUnsuccessfulStatusWord() const override {
+        return mTemplate->stopOnUnsuccessfulStatusWord();
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    ApduSequenceView
+    getApduSequence() const override {
+        return mArena.getSequence();
+    }
+
+private:
+    /**
+     *
+     */
+    const CardRequestTemplate::Field&
+    getField(const std::size_t fieldIndex) const {
+        const std::vector<CardRequestTemplate::Field>& fields = mTemplate->getFields();
+        if (fieldIndex >= fields.size()) {
+            throw std::invalid_argument("Unknown field index");
+        }
+
+        return fields[fieldIndex];
+    }
+
+    /**
+     *
+     */
+    const std::shared_ptr<const CardRequestTemplate> mTemplate;
+
+    /**
+     *
+     */
+    ApduArena mArena;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,376 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "keypop/card/spi/TransmissionInstrumentationSpi.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Implementation of keypop::card::spi::TransmissionInstrumentationSpi aggregating the records into
+ * duration histograms that can be scraped at any time (e.g. by a metrics exporter).
+ *
+ * <p>The APDU records are aggregated per APDU information (see
+ * keypop::card::spi::ApduRequestSpi::getInfo()), the card request records all together. Each
+ * histogram has logarithmic buckets: bucket <i>i</i> counts the durations <i>d</i> (in
+ * nanoseconds) such that 2<sup><i>i</i></sup> &le; <i>d</i> &lt; 2<sup><i>i</i>+1</sup>, the
+ * first one also counting the null durations and the last one being unbounded.
+ *
+ * <p>Each recording thread owns a shard of counters that only it updates, with relaxed atomic
+ * operations: recording never waits for another thread. A lock is only taken the first time a
+ * thread records through an instance, or records an APDU information it has not seen before.
+ * Scraping sums the shards of all the threads that ever recorded.
+ *
+ * <p>This class is thread safe.
+ *
+ * @since 2.1.0
+ */
+class TransmissionHistograms final : public TransmissionInstrumentationSpi {
+public:
+    /**
+     * Aggregated values of a histogram at the time of a scrape.
+     *
+     * @since 2.1.0
+     */
+    struct Snapshot {
+        /**
+         * APDU information of the histogram (empty for the card requests).
+         *
+         * @since 2.1.0
+         */
+        std::string key;
+
+        /**
+         * Number of records.
+         *
+         * @since 2.1.0
+         */
+        uint64_t count;
+
+        /**
+         * Number of successful records: APDUs answered with one of their successful status words,
+         * card requests without exception.
+         *
+         * @since 2.1.0
+         */
+        uint64_t successCount;
+
+        /**
+         * Total number of command bytes.
+         *
+         * @since 2.1.0
+         */
+        uint64_t commandLength;
+
+        /**
+         * Total number of response bytes.
+         *
+         * @since 2.1.0
+         */
+        uint64_t responseLength;
+
+        /**
+         * Sum of the durations, in nanoseconds.
+         *
+         * @since 2.1.0
+         */
+        uint64_t totalDuration;
+
+        /**
+         * Number of records per logarithmic duration bucket.
+         *
+         * @since 2.1.0
+         */
+        std::vector<uint64_t> buckets;
+    };
+
+    /**
+     * Builds an empty instance.
+     *
+     * @since 2.1.0
+     */
+    TransmissionHistograms()
+    : mId(nextId()) {
+    }
+
+    /**
+     *
+     */
+    TransmissionHistograms(const TransmissionHistograms&) = delete;
+
+    /**
+     *
+     */
+    TransmissionHistograms& operator=(const TransmissionHistograms&) = delete;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void
+    onApduExchanged(const ApduRecord& record) override {
+        Shard& shard = getShard();
+
+        Counters* counters;
+        const auto it = shard.apdus.find(record.info);
+        if (it != shard.apdus.end()) {
+            counters = it->second.get();
+        } else {
+            /* Only the owner thread inserts, the lock protects the scrapers */
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            std::unique_ptr<Counters>& newCounters = shard.apdus[record.info];
+            newCounters.reset(new Counters());
+            counters = newCounters.get();
+        }
+        counters->add(
+            record.isSuccessful,
+            record.commandLength,
+            record.responseLength,
+            record.duration);
+    }
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.1.0
+     */
+    void
+    onCardRequestTransmitted(const CardRequestRecord& record) override {
+        getShard().cardRequests.add(
+            record.exceptionType == nullptr,
+            record.commandLength,
+            record.responseLength,
+            record.duration);
+    }
+
+    /**
+     * Gets the histograms of the APDUs.
+     *
+     * @return A list sorted by APDU information, empty if no APDU was recorded.
+     * @since 2.1.0
+     */
+    std::vector<Snapshot>
+    scrapeApdus() const {
+        std::map<std::string, Snapshot> snapshots;
+        {
+            std::lock_guard<std::mutex> lock(mShardsMutex);
+            for (const auto& shard : mShards) {
+                std::lock_guard<std::mutex> shardLock(shard.second->mutex);
+                for (const auto& counters : shard.second->apdus) {
+                    Snapshot& snapshot = snapshots[counters.first];
+                    if (snapshot.buckets.empty()) {
+                        initialize(snapshot, counters.first);
+                    }
+                    counters.second->addTo(snapshot);
+                }
+            }
+        }
+
+        std::vector<Snapshot> result;
+        result.reserve(snapshots.size());
+        for (auto& snapshot : snapshots) {
+            result.push_back(std::move(snapshot.second));
+        }
+
+        return result;
+    }
+
+    /**
+     * Gets the histogram of the card requests.
+     *
+     * @return A snapshot having an empty key.
+     * @since 2.1.0
+     */
+    Snapshot
+    scrapeCardRequests() const {
+        Snapshot snapshot;
+        initialize(snapshot, "");
+
+        std::lock_guard<std::mutex> lock(mShardsMutex);
+        for (const auto& shard : mShards) {
+            shard.second->cardRequests.addTo(snapshot);
+        }
+
+        return snapshot;
+    }
+
+    /**
+     * Gets the index of the bucket of a duration.
+     *
+     * @param duration The duration.
+     * @return A value lower than the number of buckets.
+     * @since 2.1.0
+     */
+    static std::size_t
+    getBucketIndex(const std::chrono::nanoseconds duration) {
+        uint64_t value = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+        std::size_t index = 0;
+        for (std::size_t shift = 32; shift > 0; shift >>= 1) {
+            if (value >> shift != 0) {
+                value >>= shift;
+                index += shift;
+            }
+        }
+
+        return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+    }
+
+private:
+    /**
+     * Up to about 4 seconds.
+     */
+    enum { BUCKET_COUNT = 32 };
+
+    /**
+     * Counters of a histogram, updated by a single thread and read by the scrapers.
+     */
+    struct Counters {
+        Counters()
+        : count(0)
+        , successCount(0)
+        , commandLength(0)
+        , responseLength(0)
+        , totalDuration(0) {
+            for (auto& bucket : buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void
+        add(const bool isSuccessful,
+            const std::size_t commandBytes,
+            const std::size_t responseBytes,
+            const std::chrono::nanoseconds duration) {
+            count.fetch_add(1, std::memory_order_relaxed);
+            if (isSuccessful) {
+                successCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            commandLength.fetch_add(commandBytes, std::memory_order_relaxed);
+            responseLength.fetch_add(responseBytes, std::memory_order_relaxed);
+            totalDuration.fetch_add(
+                static_cast<uint64_t>(duration.count()), std::memory_order_relaxed);
+            buckets[getBucketIndex(duration)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void
+        addTo(Snapshot& snapshot) const {
+            snapshot.count += count.load(std::memory_order_relaxed);
+            snapshot.successCount += successCount.load(std::memory_order_relaxed);
+            snapshot.commandLength += commandLength.load(std::memory_order_relaxed);
+            snapshot.responseLength += responseLength.load(std::memory_order_relaxed);
+            snapshot.totalDuration += totalDuration.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+                snapshot.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> successCount;
+        std::atomic<uint64_t> commandLength;
+        std::atomic<uint64_t> responseLength;
+        std::atomic<uint64_t> totalDuration;
+        std::atomic<uint64_t> buckets[BUCKET_COUNT];
+    };
+
+    /**
+     * Counters of one recording thread.
+     */
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::unique_ptr<Counters>> apdus;
+        Counters cardRequests;
+    };
+
+    /**
+     * Instances are identified by a number never reused, so that a thread local cache cannot
+     * designate a destroyed instance.
+     */
+    static uint64_t
+    nextId() {
+        static std::atomic<uint64_t> id(0);
+
+        return ++id;
+    }
+
+    /**
+     *
+     */
+    static void
+    initialize(Snapshot& snapshot, const std::string& key) {
+        snapshot.key = key;
+        snapshot.count = 0;
+        snapshot.successCount = 0;
+        snapshot.commandLength = 0;
+        snapshot.responseLength = 0;
+        snapshot.totalDuration = 0;
+        snapshot.buckets.assign(BUCKET_COUNT, 0);
+    }
+
+    /**
+     * Gets the shard of the calling thread, creating it on the first call.
+     *
+     * <p>The last shard used is cached per thread, so the lock is only taken when a thread
+     * alternates between several instances.
+     */
+    Shard&
+    getShard() const {
+        struct Cache {
+            uint64_t id;
+            Shard* shard;
+        };
+        static thread_local Cache cache = {0, nullptr};
+
+        if (cache.id != mId) {
+            std::lock_guard<std::mutex> lock(mShardsMutex);
+            std::unique_ptr<Shard>& shard = mShards[std::this_thread::get_id()];
+            if (shard == nullptr) {
+                shard.reset(new Shard());
+            }
+            cache.id = mId;
+            cache.shard = shard.get();
+        }
+
+        return *cache.shard;
+    }
+
+    /**
+     *
+     */
+    const uint64_t mId;
+
+    /**
+     *
+     */
+    mutable std::mutex mShardsMutex;
+
+    /**
+     * A shard is kept when its thread ends, and reused by a new thread getting the same id.
+     */
+    mutable std::map<std::thread::id, std::unique_ptr<Shard>> mShards;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
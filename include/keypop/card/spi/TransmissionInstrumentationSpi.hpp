@@ -0,0 +1,181 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <typeinfo>
+
+#include "keypop/card/ChannelControl.hpp"
+
+namespace keypop {
+namespace card {
+namespace spi {
+
+/**
+ * Observer of the card requests transmitted through a keypop::card::InstrumentedProxyReader.
+ *
+ * <p>It is notified of each APDU exchange, then of the outcome of the card request, once the card
+ * request is processed (the APDU records carry the time of each exchange). The records only
+ * reference data owned by the request being processed: they are valid during the call only and
+ * must be copied if needed afterwards.
+ *
+ * <p>The methods are invoked on the thread processing the request, before the response is
+ * returned to the caller, and possibly by several threads at the same time if the decorated
+ * readers are used concurrently. The implementation must therefore be thread safe and return
+ * quickly (see keypop::card::spi::TransmissionHistograms).
+ *
+ * @since 2.1.0
+ */
+class TransmissionInstrumentationSpi {
+public:
+    /**
+     * Description of the exchange of one APDU.
+     *
+     * @since 2.1.0
+     */
+    struct ApduRecord {
+        /**
+         * Information about the APDU (see keypop::card::spi::ApduRequestSpi::getInfo()).
+         *
+         * @since 2.1.0
+         */
+        const std::string& info;
+
+        /**
+         * Index of the APDU request in the card request.
+         *
+         * @since 2.1.0
+         */
+        std::size_t index;
+
+        /**
+         * Number of bytes of the command (header and data field for a segmented command).
+         *
+         * @since 2.1.0
+         */
+        std::size_t commandLength;
+
+        /**
+         * Number of bytes of the response, status word included.
+         *
+         * @since 2.1.0
+         */
+        std::size_t responseLength;
+
+        /**
+         * Status word of the response.
+         *
+         * @since 2.1.0
+         */
+        int statusWord;
+
+        /**
+         * True if the reader classified the response as successful (see
+         * keypop::card::CardResponseApi::isApduResponseSuccessful()), 9000h being the only
+         * successful status word if no card response is available.
+         *
+         * @since 2.1.0
+         */
+        bool isSuccessful;
+
+        /**
+         * Time elapsed since the previous APDU response (or since the start of the transmission
+         * for the first one), zero if the reader does not notify the responses as they are
+         * received.
+         *
+         * @since 2.1.0
+         */
+        std::chrono::nanoseconds duration;
+    };
+
+    /**
+     * Description of the transmission of a card request.
+     *
+     * @since 2.1.0
+     */
+    struct CardRequestRecord {
+        /**
+         * Channel control policy applied.
+         *
+         * @since 2.1.0
+         */
+        ChannelControl channelControl;
+
+        /**
+         * Number of APDU requests of the card request.
+         *
+         * @since 2.1.0
+         */
+        std::size_t apduCount;
+
+        /**
+         * Number of APDU responses received, possibly lower than apduCount in case of failure.
+         *
+         * @since 2.1.0
+         */
+        std::size_t apduResponseCount;
+
+        /**
+         * Total number of command bytes of the exchanged APDUs.
+         *
+         * @since 2.1.0
+         */
+        std::size_t commandLength;
+
+        /**
+         * Total number of response bytes received.
+         *
+         * @since 2.1.0
+         */
+        std::size_t responseLength;
+
+        /**
+         * Type of the exception thrown (or reported by
+         * keypop::card::ProxyReaderApi::tryTransmitCardRequest()), null if the request succeeded.
+         *
+         * @since 2.1.0
+         */
+        const std::type_info* exceptionType;
+
+        /**
+         * Duration of the whole transmission.
+         *
+         * @since 2.1.0
+         */
+        std::chrono::nanoseconds duration;
+    };
+
+    /**
+     * Virtual destructor.
+     */
+    virtual ~TransmissionInstrumentationSpi() = default;
+
+    /**
+     * Invoked for each APDU response received, in the order of the exchanges.
+     *
+     * @param record The description of the exchange, valid during the call only.
+     * @since 2.1.0
+     */
+    virtual void onApduExchanged(const ApduRecord& record) = 0;
+
+    /**
+     * Invoked once per card request, after the APDU exchanges, whether it succeeded or not.
+     *
+     * @param record The description of the transmission.
+     * @since 2.1.0
+     */
+    virtual void onCardRequestTransmitted(const CardRequestRecord& record) = 0;
+};
+
+} /* namespace spi */
+} /* namespace card */
+} /* namespace keypop */
@@ -0,0 +1,103 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keypop Card */
+#include "keypop/card/StaticApdu.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestTemplate.hpp"
+#include "keypop/card/spi/StaticApduRequest.hpp"
+#include "keypop/card/spi/TemplateCardRequest.hpp"
+
+using keypop::card::ByteSpan;
+using keypop::card::StaticApdu;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::CardRequestAdapter;
+using keypop::card::spi::CardRequestTemplate;
+using keypop::card::spi::StaticApduRequest;
+using keypop::card::spi::TemplateCardRequest;
+
+static const std::vector<uint8_t> READ_RECORD = {0x94, 0xB2, 0x01, 0x3C, 0x1D};
+
+static void
+BM_ApduRequestAdapter_construct(benchmark::State& state) {
+    for (auto _ : state) {
+        ApduRequestAdapter apduRequest((ByteSpan(READ_RECORD)));
+        benchmark::DoNotOptimize(apduRequest.getApduView().data());
+    }
+}
+BENCHMARK(BM_ApduRequestAdapter_construct);
+
+static void
+BM_ApduRequestAdapter_makeShared(benchmark::State& state) {
+    for (auto _ : state) {
+        auto apduRequest = std::make_shared<ApduRequestAdapter>(ByteSpan(READ_RECORD));
+        benchmark::DoNotOptimize(apduRequest);
+    }
+}
+BENCHMARK(BM_ApduRequestAdapter_makeShared);
+
+static void
+BM_ApduRequestAdapter_legacyGetApdu(benchmark::State& state) {
+    for (auto _ : state) {
+        ApduRequestAdapter apduRequest((ByteSpan(READ_RECORD)));
+        benchmark::DoNotOptimize(apduRequest.getApdu().data());
+    }
+}
+BENCHMARK(BM_ApduRequestAdapter_legacyGetApdu);
+
+static void
+BM_StaticApduRequest_of(benchmark::State& state) {
+    using ReadRecord = StaticApdu<0x94, 0xB2, 0x01, 0x3C, 0x1D>;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StaticApduRequest::of<ReadRecord>()->getApduView().data());
+    }
+}
+BENCHMARK(BM_StaticApduRequest_of);
+
+static void
+BM_CardRequestAdapter_construct(benchmark::State& state) {
+    const std::size_t apduCount = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        auto cardRequest = std::make_shared<CardRequestAdapter>(true, apduCount);
+        for (std::size_t i = 0; i < apduCount; i++) {
+            cardRequest->addApduRequest(
+                std::make_shared<ApduRequestAdapter>(ByteSpan(READ_RECORD)));
+        }
+        benchmark::DoNotOptimize(cardRequest);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CardRequestAdapter_construct)->Arg(1)->Arg(6)->Arg(12)->Arg(30);
+
+static void
+BM_TemplateCardRequest_resetAndPatch(benchmark::State& state) {
+    const std::size_t apduCount = static_cast<std::size_t>(state.range(0));
+    CardRequestTemplate::Builder builder;
+    for (std::size_t i = 0; i < apduCount; i++) {
+        builder.addApdu(ByteSpan(READ_RECORD)).addField(std::to_string(i), i, 2, 1);
+    }
+    TemplateCardRequest cardRequest(builder.build());
+    for (auto _ : state) {
+        cardRequest.reset();
+        for (std::size_t i = 0; i < apduCount; i++) {
+            cardRequest.patch(i, static_cast<uint64_t>(i + 1));
+        }
+        benchmark::DoNotOptimize(cardRequest.getApduRequests().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TemplateCardRequest_resetAndPatch)->Arg(1)->Arg(6)->Arg(12)->Arg(30);
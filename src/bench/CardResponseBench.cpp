@@ -0,0 +1,140 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/SharedObjectPool.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ByteSpan;
+using keypop::card::CardResponseAdapter;
+using keypop::card::CardResponseApi;
+using keypop::card::SharedObjectPool;
+
+static const std::vector<uint8_t> RECORD_RESPONSE(31, 0x5A);
+
+/**
+ * Card response whose responses are all successful except the last one.
+ */
+static std::shared_ptr<CardResponseApi>
+createLastUnsuccessfulCardResponse(const std::size_t apduCount) {
+    std::vector<uint8_t> successfulResponse(RECORD_RESPONSE);
+    successfulResponse[successfulResponse.size() - 2] = 0x90;
+    successfulResponse[successfulResponse.size() - 1] = 0x00;
+
+    auto cardResponse = std::make_shared<CardResponseAdapter>(apduCount);
+    for (std::size_t i = 0; i < apduCount; i++) {
+        const bool isSuccessful = i + 1 < apduCount;
+        cardResponse->addApduResponse(
+            std::make_shared<ApduResponseAdapter>(
+                ByteSpan(isSuccessful ? successfulResponse : RECORD_RESPONSE)),
+            isSuccessful);
+    }
+
+    return cardResponse;
+}
+
+static void
+BM_ApduResponseAdapter_makeShared(benchmark::State& state) {
+    for (auto _ : state) {
+        auto apduResponse = std::make_shared<ApduResponseAdapter>(ByteSpan(RECORD_RESPONSE));
+        benchmark::DoNotOptimize(apduResponse);
+    }
+}
+BENCHMARK(BM_ApduResponseAdapter_makeShared);
+
+static void
+BM_ApduResponseAdapter_getDataOut(benchmark::State& state) {
+    const ApduResponseAdapter apduResponse((ByteSpan(RECORD_RESPONSE)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(apduResponse.getDataOut());
+    }
+}
+BENCHMARK(BM_ApduResponseAdapter_getDataOut);
+
+static void
+BM_ApduResponseAdapter_getDataOutView(benchmark::State& state) {
+    const ApduResponseAdapter apduResponse((ByteSpan(RECORD_RESPONSE)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(apduResponse.getDataOutView());
+    }
+}
+BENCHMARK(BM_ApduResponseAdapter_getDataOutView);
+
+static void
+BM_CardResponseAdapter_construct(benchmark::State& state) {
+    const std::size_t apduCount = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        auto cardResponse = std::make_shared<CardResponseAdapter>(apduCount);
+        for (std::size_t i = 0; i < apduCount; i++) {
+            cardResponse->addApduResponse(
+                std::make_shared<ApduResponseAdapter>(ByteSpan(RECORD_RESPONSE)));
+        }
+        benchmark::DoNotOptimize(cardResponse);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CardResponseAdapter_construct)->Arg(1)->Arg(6)->Arg(12)->Arg(30);
+
+static void
+BM_CardResponseAdapter_pooled(benchmark::State& state) {
+    const std::size_t apduCount = static_cast<std::size_t>(state.range(0));
+    SharedObjectPool<CardResponseAdapter> cardResponsePool([apduCount]() {
+        return std::unique_ptr<CardResponseAdapter>(new CardResponseAdapter(apduCount));
+    });
+    SharedObjectPool<ApduResponseAdapter> apduResponsePool(
+        []() { return std::unique_ptr<ApduResponseAdapter>(new ApduResponseAdapter()); },
+        2 * apduCount);
+    for (auto _ : state) {
+        auto cardResponse = cardResponsePool.acquire();
+        for (std::size_t i = 0; i < apduCount; i++) {
+            auto apduResponse = apduResponsePool.acquire();
+            apduResponse->setApdu(ByteSpan(RECORD_RESPONSE));
+            cardResponse->addApduResponse(apduResponse);
+        }
+        benchmark::DoNotOptimize(cardResponse);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CardResponseAdapter_pooled)->Arg(1)->Arg(6)->Arg(12)->Arg(30);
+
+static void
+BM_CardResponse_firstUnsuccessfulScan(benchmark::State& state) {
+    const std::shared_ptr<CardResponseApi> cardResponseApi
+        = createLastUnsuccessfulCardResponse(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::size_t index = 0;
+        for (const auto& apduResponse : cardResponseApi->getApduResponses()) {
+            if (apduResponse->getStatusWord() != 0x9000) {
+                break;
+            }
+            index++;
+        }
+        benchmark::DoNotOptimize(index);
+    }
+}
+BENCHMARK(BM_CardResponse_firstUnsuccessfulScan)->Arg(6)->Arg(30);
+
+static void
+BM_CardResponse_firstUnsuccessfulSummary(benchmark::State& state) {
+    const std::shared_ptr<CardResponseApi> cardResponseApi
+        = createLastUnsuccessfulCardResponse(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cardResponseApi->getSummary().getFirstUnsuccessfulIndex());
+    }
+}
+BENCHMARK(BM_CardResponse_firstUnsuccessfulSummary)->Arg(6)->Arg(30);
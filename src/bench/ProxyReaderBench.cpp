@@ -0,0 +1,190 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keypop Card */
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/CardTraceRing.hpp"
+#include "keypop/card/InstrumentedProxyReader.hpp"
+#include "keypop/card/RecordingProxyReader.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/UnexpectedStatusWordException.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/ArenaCardRequest.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+#include "keypop/card/spi/TransmissionHistograms.hpp"
+
+using keypop::card::AbstractApduException;
+using keypop::card::ByteSpan;
+using keypop::card::CardResponseAdapter;
+using keypop::card::CardTraceRing;
+using keypop::card::InstrumentedProxyReader;
+using keypop::card::RecordingProxyReader;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::ChannelControl;
+using keypop::card::UnexpectedStatusWordException;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::ArenaCardRequest;
+using keypop::card::spi::CardRequestAdapter;
+using keypop::card::spi::TransmissionHistograms;
+
+static std::shared_ptr<SimulatedCard>
+createLoopbackCard(const int statusWord = 0x9000) {
+    auto card = std::make_shared<SimulatedCard>();
+    card->addHandler(ByteSpan(), SimulatedCard::echo(statusWord));
+
+    return card;
+}
+
+static std::shared_ptr<CardRequestAdapter>
+createCardRequest(const std::size_t apduCount) {
+    const std::vector<uint8_t> apdu = {0x94, 0xDC, 0x01, 0x3C, 0x04, 0x11, 0x22, 0x33, 0x44};
+    auto cardRequest = std::make_shared<CardRequestAdapter>(true, apduCount);
+    for (std::size_t i = 0; i < apduCount; i++) {
+        cardRequest->addApduRequest(std::make_shared<ApduRequestAdapter>(ByteSpan(apdu)));
+    }
+
+    return cardRequest;
+}
+
+static void
+BM_Loopback_transmitCardRequest(benchmark::State& state) {
+    SimulatedProxyReader reader(createLoopbackCard());
+    const auto cardRequest = createCardRequest(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Loopback_transmitCardRequest)->Arg(1)->Arg(6)->Arg(12);
+
+static void
+BM_Loopback_transmitInstrumented(benchmark::State& state) {
+    InstrumentedProxyReader reader(
+        std::make_shared<SimulatedProxyReader>(createLoopbackCard()),
+        std::make_shared<TransmissionHistograms>());
+    reader.setEnabled(state.range(1) != 0);
+    const auto cardRequest = createCardRequest(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Loopback_transmitInstrumented)->Args({6, 0})->Args({6, 1});
+
+static void
+BM_Loopback_transmitRecorded(benchmark::State& state) {
+    std::vector<uint8_t> block(1 << 20);
+    RecordingProxyReader reader(
+        std::make_shared<SimulatedProxyReader>(createLoopbackCard()),
+        std::make_shared<CardTraceRing>(block.data(), block.size()));
+    const auto cardRequest = createCardRequest(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Loopback_transmitRecorded)->Arg(6);
+
+static void
+BM_Loopback_transmitArenaCardRequest(benchmark::State& state) {
+    const std::vector<uint8_t> apdu = {0x94, 0xDC, 0x01, 0x3C, 0x04, 0x11, 0x22, 0x33, 0x44};
+    const std::size_t apduCount = static_cast<std::size_t>(state.range(0));
+    SimulatedProxyReader reader(createLoopbackCard());
+    auto cardRequest = std::make_shared<ArenaCardRequest>(true, apduCount, apduCount * apdu.size());
+    for (std::size_t i = 0; i < apduCount; i++) {
+        cardRequest->addApdu(ByteSpan(apdu));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Loopback_transmitArenaCardRequest)->Arg(1)->Arg(6)->Arg(12);
+
+static void
+BM_Loopback_transmitCardRequestByReference(benchmark::State& state) {
+    SimulatedProxyReader reader(createLoopbackCard());
+    const auto cardRequest = createCardRequest(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            reader.transmitCardRequest(*cardRequest, ChannelControl::KEEP_OPEN));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Loopback_transmitCardRequestByReference)->Arg(1)->Arg(6)->Arg(12);
+
+static void
+BM_Loopback_unexpectedStatusWord(benchmark::State& state) {
+    SimulatedProxyReader reader(createLoopbackCard(0x6283));
+    const auto cardRequest = createCardRequest(1);
+    for (auto _ : state) {
+        try {
+            reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+        } catch (const AbstractApduException& e) {
+            benchmark::DoNotOptimize(e.isCardResponseComplete());
+        }
+    }
+}
+BENCHMARK(BM_Loopback_unexpectedStatusWord);
+
+static void
+BM_Loopback_tryUnexpectedStatusWord(benchmark::State& state) {
+    SimulatedProxyReader reader(createLoopbackCard(0x6283));
+    const auto cardRequest = createCardRequest(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            reader.tryTransmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN));
+    }
+}
+BENCHMARK(BM_Loopback_tryUnexpectedStatusWord);
+
+static void
+BM_Simulated_virtualTaps(benchmark::State& state) {
+    SimulatedProxyReader reader(createLoopbackCard(), 1);
+    reader.setLatency(std::chrono::microseconds(2000), std::chrono::microseconds(500))
+        .setRealTime(false)
+        .setFaultProbability(SimulatedProxyReader::Fault::CARD_TEARING, 0.001);
+    const auto cardRequest = createCardRequest(6);
+    for (auto _ : state) {
+        try {
+            benchmark::DoNotOptimize(
+                reader.transmitCardRequest(cardRequest, ChannelControl::CLOSE_AFTER));
+        } catch (const AbstractApduException& e) {
+            benchmark::DoNotOptimize(e.isCardResponseComplete());
+            reader.insertCard();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Simulated_virtualTaps);
+
+static void
+BM_Exception_throwCatch(benchmark::State& state) {
+    const auto cardResponse = std::make_shared<CardResponseAdapter>();
+    for (auto _ : state) {
+        try {
+            throw UnexpectedStatusWordException(cardResponse, false, "Unexpected status word");
+        } catch (const AbstractApduException& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+BENCHMARK(BM_Exception_throwCatch);
@@ -0,0 +1,61 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keypop Card */
+#include "keypop/card/StatusWordSet.hpp"
+
+using keypop::card::StatusWordSet;
+
+static std::vector<int>
+createStatusWords(const int count) {
+    std::vector<int> statusWords = {0x9000};
+    for (int i = 1; i < count; i++) {
+        statusWords.push_back(0x6200 + i);
+    }
+
+    return statusWords;
+}
+
+static void
+BM_StatusWord_vectorScan(benchmark::State& state) {
+    const std::vector<int> statusWords = createStatusWords(static_cast<int>(state.range(0)));
+    int statusWord = 0x6283;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(statusWord);
+        const bool isSuccessful
+            = std::find(statusWords.begin(), statusWords.end(), statusWord) != statusWords.end();
+        benchmark::DoNotOptimize(isSuccessful);
+    }
+}
+BENCHMARK(BM_StatusWord_vectorScan)->Arg(1)->Arg(4)->Arg(16);
+
+static void
+BM_StatusWord_setContains(benchmark::State& state) {
+    const auto statusWords = StatusWordSet::of(createStatusWords(static_cast<int>(state.range(0))));
+    int statusWord = 0x6283;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(statusWord);
+        benchmark::DoNotOptimize(statusWords->contains(statusWord));
+    }
+}
+BENCHMARK(BM_StatusWord_setContains)->Arg(1)->Arg(4)->Arg(16);
+
+static void
+BM_StatusWord_setOfDefault(benchmark::State& state) {
+    const std::vector<int> statusWords = {0x9000};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StatusWordSet::of(statusWords));
+    }
+}
+BENCHMARK(BM_StatusWord_setOfDefault);
@@ -0,0 +1,86 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/HexFormat.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ApduResponseApi;
+using keypop::card::ByteSpan;
+using keypop::card::CardResponseAdapter;
+using keypop::card::CardResponseApi;
+using keypop::card::HexFormat;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::ApduRequestSpi;
+
+static void
+BM_Stream_apduRequest(benchmark::State& state) {
+    const std::vector<uint8_t> apdu = {0x94, 0xB2, 0x01, 0x3C, 0x1D};
+    const std::shared_ptr<ApduRequestSpi> apduRequest
+        = std::make_shared<ApduRequestAdapter>(ByteSpan(apdu));
+    for (auto _ : state) {
+        std::ostringstream os;
+        os << apduRequest;
+        benchmark::DoNotOptimize(os.str());
+    }
+}
+BENCHMARK(BM_Stream_apduRequest);
+
+static void
+BM_Stream_apduResponse(benchmark::State& state) {
+    const std::vector<uint8_t> apdu(31, 0x5A);
+    const std::shared_ptr<ApduResponseApi> apduResponse
+        = std::make_shared<ApduResponseAdapter>(ByteSpan(apdu));
+    for (auto _ : state) {
+        std::ostringstream os;
+        os << apduResponse;
+        benchmark::DoNotOptimize(os.str());
+    }
+}
+BENCHMARK(BM_Stream_apduResponse);
+
+static void
+BM_Stream_cardResponse(benchmark::State& state) {
+    const std::vector<uint8_t> apdu(31, 0x5A);
+    auto cardResponse = std::make_shared<CardResponseAdapter>();
+    for (int i = 0; i < state.range(0); i++) {
+        cardResponse->addApduResponse(std::make_shared<ApduResponseAdapter>(ByteSpan(apdu)));
+    }
+    const std::shared_ptr<CardResponseApi> cardResponseApi = cardResponse;
+    for (auto _ : state) {
+        std::ostringstream os;
+        os << cardResponseApi;
+        benchmark::DoNotOptimize(os.str());
+    }
+}
+BENCHMARK(BM_Stream_cardResponse)->Arg(1)->Arg(12);
+
+static void
+BM_Stream_hexFormat(benchmark::State& state) {
+    const std::vector<uint8_t> bytes(static_cast<std::size_t>(state.range(0)), 0x5A);
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.str("");
+        os << HexFormat(ByteSpan(bytes));
+        benchmark::DoNotOptimize(os);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Stream_hexFormat)->Arg(31)->Arg(4096);
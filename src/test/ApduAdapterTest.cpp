@@ -0,0 +1,179 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ByteSpan;
+using keypop::card::StatusWordSet;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::ApduRequestSpi;
+
+/**
+ * APDU request implementing only the methods of version 1.0.0.
+ */
+class LegacyApduRequest final : public ApduRequestSpi {
+public:
+    std::vector<uint8_t>&
+    getApdu() override {
+        return mApdu;
+    }
+
+    const std::vector<int>&
+    getSuccessfulStatusWords() const override {
+        return mSuccessfulStatusWords;
+    }
+
+    const std::string&
+    getInfo() const override {
+        return mInfo;
+    }
+
+    void
+    addSuccessfulStatusWord(const int statusWord) {
+        mSuccessfulStatusWords.push_back(statusWord);
+    }
+
+private:
+    std::vector<uint8_t> mApdu = {0x00, 0xB2, 0x01, 0x04};
+    std::vector<int> mSuccessfulStatusWords = {0x9000, 0x6283};
+    std::string mInfo;
+};
+
+TEST(ApduAdapterTest, requestView_shouldReferToInlineStorage) {
+    const std::vector<uint8_t> apdu = {0x00, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54};
+    ApduRequestAdapter request((ByteSpan(apdu)));
+
+    ASSERT_EQ(request.getApduView().toVector(), apdu);
+    ASSERT_EQ(request.getApduView()[1], 0xA4);
+}
+
+TEST(ApduAdapterTest, requestLegacyApdu_shouldBecomeTheStorage) {
+    const std::vector<uint8_t> apdu = {0x00, 0xB2, 0x01, 0x04, 0x1D};
+    ApduRequestAdapter request((ByteSpan(apdu)));
+
+    request.getApdu()[2] = 0x02;
+
+    ASSERT_EQ(request.getApdu().size(), apdu.size());
+    ASSERT_EQ(request.getApduView()[2], 0x02);
+    ASSERT_EQ(request.getApduView().data(), request.getApdu().data());
+}
+
+TEST(ApduAdapterTest, requestStatusWords_shouldDefaultTo9000AndBeExtendable) {
+    const std::vector<uint8_t> apdu = {0x00, 0xB2, 0x01, 0x04};
+    ApduRequestAdapter request((ByteSpan(apdu)));
+    ApduRequestAdapter other((ByteSpan(apdu)));
+
+    request.addSuccessfulStatusWord(0x6283).setInfo("Read Record");
+
+    ASSERT_EQ(request.getSuccessfulStatusWords(), std::vector<int>({0x6283, 0x9000}));
+    ASSERT_EQ(other.getSuccessfulStatusWords(), std::vector<int>({0x9000}));
+    ASSERT_EQ(request.getInfo(), "Read Record");
+}
+
+TEST(ApduAdapterTest, requestStatusWordSet_whenInvalid_shouldThrow) {
+    const std::vector<uint8_t> apdu = {0x00, 0xB2, 0x01, 0x04};
+    ApduRequestAdapter request((ByteSpan(apdu)));
+
+    ASSERT_THROW(request.setSuccessfulStatusWords(nullptr), std::invalid_argument);
+    ASSERT_THROW(
+        request.setSuccessfulStatusWords(StatusWordSet::of({0x6283})), std::invalid_argument);
+    ASSERT_TRUE(request.isSuccessfulStatusWord(0x9000));
+    ASSERT_FALSE(request.isSuccessfulStatusWord(0x6283));
+
+    request.setSuccessfulStatusWords(StatusWordSet::of({0x9000, 0x6283}));
+
+    ASSERT_TRUE(request.isSuccessfulStatusWord(0x6283));
+}
+
+TEST(ApduAdapterTest, legacyRequestStatusWords_shouldBeCheckedWithoutSet) {
+    const LegacyApduRequest request;
+
+    ASSERT_TRUE(request.isSuccessfulStatusWord(0x6283));
+    ASSERT_TRUE(request.isSuccessfulStatusWord(0x9000));
+    ASSERT_FALSE(request.isSuccessfulStatusWord(0x6A82));
+    ASSERT_TRUE(request.getSuccessfulStatusWordSet()->contains(0x6283));
+}
+
+TEST(ApduAdapterTest, legacyRequestStatusWordSet_shouldBeCachedUntilListChanges) {
+    LegacyApduRequest request;
+    const std::shared_ptr<const keypop::card::StatusWordSet> statusWordSet
+        = request.getSuccessfulStatusWordSet();
+
+    ASSERT_EQ(request.getSuccessfulStatusWordSet(), statusWordSet);
+
+    request.addSuccessfulStatusWord(0x6A82);
+
+    ASSERT_NE(request.getSuccessfulStatusWordSet(), statusWordSet);
+    ASSERT_TRUE(request.getSuccessfulStatusWordSet()->contains(0x6A82));
+    ASSERT_EQ(request.getSuccessfulStatusWordSet(), request.getSuccessfulStatusWordSet());
+}
+
+TEST(ApduAdapterTest, response_shouldExposeDataOutAndStatusWord) {
+    const std::vector<uint8_t> apdu = {0x12, 0x34, 0x62, 0x83};
+    const ApduResponseAdapter response((ByteSpan(apdu)));
+
+    ASSERT_EQ(response.getStatusWord(), 0x6283);
+    ASSERT_EQ(response.getDataOutView().toVector(), std::vector<uint8_t>({0x12, 0x34}));
+    ASSERT_EQ(response.getDataOut(), std::vector<uint8_t>({0x12, 0x34}));
+    ASSERT_EQ(response.getApdu(), apdu);
+}
+
+TEST(ApduAdapterTest, responseLegacyApdu_shouldBeBuiltOnceByConcurrentReaders) {
+    const std::vector<uint8_t> apdu = {0x12, 0x34, 0x90, 0x00};
+    const ApduResponseAdapter response((ByteSpan(apdu)));
+    const std::vector<uint8_t>* legacyApdus[4] = {};
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&response, &legacyApdus, i]() {
+            legacyApdus[i] = &response.getApdu();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(legacyApdus[i], legacyApdus[0]);
+    }
+    ASSERT_EQ(*legacyApdus[0], apdu);
+}
+
+TEST(ApduAdapterTest, statusWordOnlyResponse_shouldHaveEmptyDataOut) {
+    const std::vector<uint8_t> apdu = {0x90, 0x00};
+    const ApduResponseAdapter response((ByteSpan(apdu)));
+
+    ASSERT_EQ(response.getStatusWord(), 0x9000);
+    ASSERT_TRUE(response.getDataOutView().empty());
+}
+
+TEST(ApduAdapterTest, requestStatusWordSet_shouldBeInternedByDefault) {
+    const std::vector<uint8_t> apdu = {0x00, 0xB2, 0x01, 0x04};
+    ApduRequestAdapter request((ByteSpan(apdu)));
+
+    ASSERT_EQ(request.getSuccessfulStatusWordSet(), keypop::card::StatusWordSet::getDefault());
+
+    request.addSuccessfulStatusWord(0x6283);
+
+    ASSERT_TRUE(request.getSuccessfulStatusWordSet()->contains(0x6283));
+    ASSERT_TRUE(request.getSuccessfulStatusWordSet()->contains(0x9000));
+    ASSERT_TRUE(request.isSuccessfulStatusWord(0x6283));
+}
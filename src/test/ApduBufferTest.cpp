@@ -0,0 +1,71 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduBuffer.hpp"
+
+using keypop::card::ApduCommandBuffer;
+using keypop::card::BasicApduBuffer;
+using keypop::card::ByteSpan;
+
+TEST(ApduBufferTest, shortApdu_shouldStayInline) {
+    const std::vector<uint8_t> apdu(261, 0x55);
+    const ApduCommandBuffer buffer((ByteSpan(apdu)));
+
+    ASSERT_TRUE(buffer.isInline());
+    ASSERT_EQ(buffer.view().toVector(), apdu);
+}
+
+TEST(ApduBufferTest, extendedApdu_shouldFallBackToHeap) {
+    const std::vector<uint8_t> apdu(300, 0x55);
+    ApduCommandBuffer buffer((ByteSpan(apdu)));
+
+    ASSERT_FALSE(buffer.isInline());
+    ASSERT_EQ(buffer.view().toVector(), apdu);
+
+    buffer.resize(4);
+
+    ASSERT_TRUE(buffer.isInline());
+    ASSERT_EQ(buffer.view().toVector(), std::vector<uint8_t>(4, 0x55));
+}
+
+TEST(ApduBufferTest, append_shouldCrossInlineCapacity) {
+    const std::vector<uint8_t> head = {0x01, 0x02, 0x03};
+    const std::vector<uint8_t> tail = {0x04, 0x05};
+    BasicApduBuffer<4> buffer((ByteSpan(head)));
+
+    buffer.append(ByteSpan(tail));
+    buffer.push_back(0x06);
+
+    ASSERT_FALSE(buffer.isInline());
+    ASSERT_EQ(buffer.view().toVector(), std::vector<uint8_t>({0x01, 0x02, 0x03, 0x04, 0x05, 0x06}));
+}
+
+TEST(ApduBufferTest, copyAndMove_shouldPreserveContent) {
+    const std::vector<uint8_t> shortApdu = {0x00, 0xB2, 0x01, 0x04, 0x1D};
+    const std::vector<uint8_t> longApdu(512, 0xAA);
+    ApduCommandBuffer a((ByteSpan(shortApdu)));
+    ApduCommandBuffer b((ByteSpan(longApdu)));
+
+    ApduCommandBuffer c(a);
+    ApduCommandBuffer d(std::move(b));
+    a = d;
+
+    ASSERT_EQ(c.view().toVector(), shortApdu);
+    ASSERT_EQ(d.view().toVector(), longApdu);
+    ASSERT_EQ(a.view().toVector(), longApdu);
+    ASSERT_TRUE(b.empty());
+}
@@ -0,0 +1,258 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduCommandEncoder.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+#include "keypop/card/spi/SegmentedApduRequest.hpp"
+
+using keypop::card::ApduCommandBuffer;
+using keypop::card::ApduCommandEncoder;
+using keypop::card::ApduResponseBuffer;
+using keypop::card::ByteSpan;
+using keypop::card::ChannelControl;
+using keypop::card::EXTENDED_APDU_COMMAND_MAX_LENGTH;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::StatusWordSet;
+using keypop::card::spi::ApduCommand;
+using keypop::card::spi::CardRequestAdapter;
+using keypop::card::spi::SegmentedApduRequest;
+
+static std::vector<uint8_t>
+encode(const ApduCommandEncoder& encoder, const ApduCommand& command, const std::size_t index) {
+    ApduCommandBuffer buffer;
+    encoder.encode(command, index, buffer);
+
+    return buffer.view().toVector();
+}
+
+static std::vector<uint8_t>
+createData(const std::size_t length) {
+    std::vector<uint8_t> data(length);
+    for (std::size_t i = 0; i < length; i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    return data;
+}
+
+TEST(ApduCommandEncoderTest, constructor_whenLengthOutOfRange_shouldThrow) {
+    ASSERT_THROW(ApduCommandEncoder(100), std::invalid_argument);
+    ASSERT_THROW(ApduCommandEncoder(EXTENDED_APDU_COMMAND_MAX_LENGTH + 1), std::invalid_argument);
+    ASSERT_FALSE(ApduCommandEncoder().isExtendedLengthSupported());
+    ASSERT_TRUE(ApduCommandEncoder(1024).isExtendedLengthSupported());
+}
+
+TEST(ApduCommandEncoderTest, setLe_whenOutOfRange_shouldThrow) {
+    ApduCommand command(0x00, 0xB0, 0x00, 0x00);
+
+    ASSERT_THROW(command.setLe(0), std::invalid_argument);
+    ASSERT_THROW(command.setLe(65537), std::invalid_argument);
+    ASSERT_NO_THROW(command.setLe(ApduCommand::NO_LE));
+}
+
+TEST(ApduCommandEncoderTest, encode_shortCases_shouldUseShortFields) {
+    const std::vector<uint8_t> data = {0x11, 0x22};
+    const ApduCommandEncoder encoder;
+
+    ApduCommand case1(0x00, 0x20, 0x00, 0x01);
+    ApduCommand case2(0x00, 0xB0, 0x00, 0x00);
+    case2.setLe(256);
+    ApduCommand case4(0x00, 0xA4, 0x04, 0x00);
+    case4.addData(ByteSpan(data)).setLe(16);
+
+    ASSERT_EQ(encode(encoder, case1, 0), std::vector<uint8_t>({0x00, 0x20, 0x00, 0x01}));
+    ASSERT_EQ(encode(encoder, case2, 0), std::vector<uint8_t>({0x00, 0xB0, 0x00, 0x00, 0x00}));
+    ASSERT_EQ(
+        encode(encoder, case4, 0),
+        std::vector<uint8_t>({0x00, 0xA4, 0x04, 0x00, 0x02, 0x11, 0x22, 0x10}));
+}
+
+TEST(ApduCommandEncoderTest, encode_extendedCases_shouldUseExtendedFields) {
+    const std::vector<uint8_t> data = createData(300);
+    const ApduCommandEncoder encoder(EXTENDED_APDU_COMMAND_MAX_LENGTH);
+
+    ApduCommand case2(0x00, 0xB0, 0x00, 0x00);
+    case2.setLe(65536);
+    ApduCommand case3(0x00, 0xD6, 0x00, 0x00);
+    case3.addData(ByteSpan(data));
+    ApduCommand case4(0x00, 0xD6, 0x00, 0x00);
+    case4.addData(ByteSpan(data)).setLe(512);
+
+    ASSERT_EQ(
+        encode(encoder, case2, 0),
+        std::vector<uint8_t>({0x00, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x00}));
+
+    const std::vector<uint8_t> apdu3 = encode(encoder, case3, 0);
+    ASSERT_EQ(apdu3.size(), 4u + 3u + 300u);
+    ASSERT_EQ(
+        std::vector<uint8_t>(apdu3.begin() + 4, apdu3.begin() + 7),
+        std::vector<uint8_t>({0x00, 0x01, 0x2C}));
+    ASSERT_EQ(std::vector<uint8_t>(apdu3.begin() + 7, apdu3.end()), data);
+
+    const std::vector<uint8_t> apdu4 = encode(encoder, case4, 0);
+    ASSERT_EQ(apdu4.size(), 4u + 3u + 300u + 2u);
+    ASSERT_EQ(apdu4[apdu4.size() - 2], 0x02);
+    ASSERT_EQ(apdu4[apdu4.size() - 1], 0x00);
+}
+
+TEST(ApduCommandEncoderTest, encode_whenExtendedNotSupported_shouldThrow) {
+    ApduCommand command(0x00, 0xB0, 0x00, 0x00);
+    command.setLe(1024);
+    ApduCommandBuffer buffer;
+
+    ASSERT_THROW(ApduCommandEncoder().encode(command, 0, buffer), std::invalid_argument);
+}
+
+TEST(ApduCommandEncoderTest, encode_withExtendedLe_shouldNotExceedMaxCommandLength) {
+    const std::vector<uint8_t> data = createData(255);
+    ApduCommand command(0x00, 0xD6, 0x00, 0x00);
+    command.addData(ByteSpan(data)).setLe(300);
+    const ApduCommandEncoder encoder(262);
+
+    ASSERT_EQ(encoder.getExchangeCount(command), 2u);
+
+    const std::vector<uint8_t> first = encode(encoder, command, 0);
+    const std::vector<uint8_t> last = encode(encoder, command, 1);
+    ASSERT_LE(first.size(), 262u);
+    ASSERT_LE(last.size(), 262u);
+    ASSERT_EQ(first[4], 253);
+    ASSERT_EQ(
+        last,
+        std::vector<uint8_t>({0x00, 0xD6, 0x00, 0x00, 0x00, 0x00, 0x02, 253, 254, 0x01, 0x2C}));
+
+    command.setLe(256);
+    ASSERT_EQ(encoder.getExchangeCount(command), 1u);
+    ASSERT_EQ(encode(encoder, command, 0).size(), 261u);
+}
+
+TEST(ApduCommandEncoderTest, encode_largeData_shouldChainAndGatherSegments) {
+    const std::vector<uint8_t> data = createData(4096);
+    ApduCommand command(0x00, 0xD6, 0x00, 0x00);
+    command.addData(ByteSpan(data).first(1000))
+        .addData(ByteSpan())
+        .addData(ByteSpan(data).subspan(1000, 3096))
+        .setLe(256);
+    const ApduCommandEncoder encoder;
+
+    ASSERT_EQ(command.getDataLength(), 4096u);
+    ASSERT_EQ(command.getDataSegments().size(), 2u);
+    ASSERT_EQ(encoder.getExchangeCount(command), 17u);
+
+    std::vector<uint8_t> gathered;
+    for (std::size_t i = 0; i < 17; i++) {
+        const std::vector<uint8_t> apdu = encode(encoder, command, i);
+        const bool isLast = i == 16;
+        ASSERT_EQ(apdu[0], isLast ? 0x00 : 0x10);
+        ASSERT_EQ(apdu[4], isLast ? 4096 - 16 * 255 : 255);
+        const std::size_t dataEnd = isLast ? apdu.size() - 1 : apdu.size();
+        gathered.insert(gathered.end(), apdu.begin() + 5, apdu.begin() + dataEnd);
+    }
+    ASSERT_EQ(gathered, data);
+    ASSERT_THROW(encode(encoder, command, 17), std::invalid_argument);
+}
+
+TEST(ApduCommandEncoderTest, segmentedApduRequest_shouldProvideSingleApdu) {
+    const std::vector<uint8_t> data = createData(300);
+    ApduCommand command(0x00, 0xD6, 0x00, 0x00);
+    command.addData(ByteSpan(data));
+    SegmentedApduRequest apduRequest(command);
+
+    ASSERT_EQ(apduRequest.getSegmentedCommand()->getDataLength(), 300u);
+    ASSERT_EQ(apduRequest.getApduView().size(), 307u);
+    ASSERT_EQ(apduRequest.getApdu().size(), 307u);
+
+    const std::vector<uint8_t> largeData = createData(70000);
+    ApduCommand largeCommand(0x00, 0xD6, 0x00, 0x00);
+    largeCommand.addData(ByteSpan(largeData));
+    SegmentedApduRequest largeApduRequest(largeCommand);
+
+    ASSERT_THROW(largeApduRequest.getApduView(), std::invalid_argument);
+}
+
+TEST(ApduCommandEncoderTest, segmentedApduRequest_withInvalidStatusWords_shouldThrow) {
+    SegmentedApduRequest apduRequest(ApduCommand(0x00, 0xD6, 0x00, 0x00));
+
+    ASSERT_THROW(apduRequest.setSuccessfulStatusWords(nullptr), std::invalid_argument);
+    ASSERT_THROW(
+        apduRequest.setSuccessfulStatusWords(StatusWordSet::of({0x6283})), std::invalid_argument);
+    ASSERT_TRUE(apduRequest.isSuccessfulStatusWord(0x9000));
+    ASSERT_FALSE(apduRequest.isSuccessfulStatusWord(0x6283));
+
+    apduRequest.setSuccessfulStatusWords(StatusWordSet::of({0x9000, 0x6283}));
+
+    ASSERT_TRUE(apduRequest.isSuccessfulStatusWord(0x6283));
+}
+
+TEST(ApduCommandEncoderTest, simulatedProxyReader_shouldSendChainAndKeepLastResponse) {
+    std::vector<std::vector<uint8_t>> commands;
+    auto card = std::make_shared<SimulatedCard>();
+    card->addHandler(ByteSpan(), [&commands](const ByteSpan command, ApduResponseBuffer& response) {
+        commands.push_back(command.toVector());
+        if ((command[0] & 0x10) == 0) {
+            response.push_back(0xAB);
+        }
+        response.push_back(0x90);
+        response.push_back(0x00);
+    });
+    SimulatedProxyReader reader(card);
+
+    const std::vector<uint8_t> data = createData(600);
+    ApduCommand command(0x00, 0xD6, 0x00, 0x00);
+    command.addData(ByteSpan(data)).setLe(1);
+    auto cardRequest = std::make_shared<CardRequestAdapter>(true);
+    cardRequest->addApduRequest(std::make_shared<SegmentedApduRequest>(command));
+
+    auto cardResponse = reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(commands.size(), 3u);
+    ASSERT_EQ(cardResponse->getApduResponses().size(), 1u);
+    ASSERT_EQ(
+        cardResponse->getApduResponses()[0]->getApdu(), std::vector<uint8_t>({0xAB, 0x90, 0x00}));
+
+    commands.clear();
+    reader.setMaxCommandLength(EXTENDED_APDU_COMMAND_MAX_LENGTH);
+    reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(commands.size(), 1u);
+    ASSERT_EQ(commands[0].size(), 4u + 3u + 600u + 2u);
+}
+
+TEST(ApduCommandEncoderTest, simulatedProxyReader_whenIntermediateFails_shouldStopChain) {
+    int count = 0;
+    auto card = std::make_shared<SimulatedCard>();
+    card->addHandler(ByteSpan(), [&count](const ByteSpan, ApduResponseBuffer& response) {
+        count++;
+        response.push_back(0x68);
+        response.push_back(0x84);
+    });
+    SimulatedProxyReader reader(card);
+
+    const std::vector<uint8_t> data = createData(600);
+    ApduCommand command(0x00, 0xD6, 0x00, 0x00);
+    command.addData(ByteSpan(data));
+    auto cardRequest = std::make_shared<CardRequestAdapter>(false);
+    cardRequest->addApduRequest(std::make_shared<SegmentedApduRequest>(command));
+
+    auto cardResponse = reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(count, 1);
+    ASSERT_EQ(cardResponse->getApduResponses()[0]->getStatusWord(), 0x6884);
+}
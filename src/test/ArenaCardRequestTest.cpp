@@ -0,0 +1,107 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ArenaCardRequest.hpp"
+
+using keypop::card::ByteSpan;
+using keypop::card::CardTransmitResult;
+using keypop::card::CardTransmitStatus;
+using keypop::card::ChannelControl;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::StatusWordSet;
+using keypop::card::spi::ApduRequestSpi;
+using keypop::card::spi::ApduSequenceView;
+using keypop::card::spi::ArenaCardRequest;
+
+static const std::vector<uint8_t> SELECT = {0x00, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54};
+static const std::vector<uint8_t> READ = {0x00, 0xB2, 0x01, 0x04, 0x00};
+
+TEST(ArenaCardRequestTest, getApduSequence_shouldStoreApdusBackToBack) {
+    ArenaCardRequest cardRequest(true, 2, SELECT.size() + READ.size());
+    cardRequest.addApdu(ByteSpan(SELECT))
+        .addApdu(ByteSpan(READ), StatusWordSet::of({0x9000, 0x6A83}));
+
+    const ApduSequenceView apduSequence = cardRequest.getApduSequence();
+
+    ASSERT_EQ(apduSequence.size(), 2u);
+    ASSERT_EQ(apduSequence.getApdu(0).toVector(), SELECT);
+    ASSERT_EQ(apduSequence.getApdu(1).toVector(), READ);
+    ASSERT_EQ(apduSequence.getApdu(1).data(), apduSequence.getApdu(0).end());
+    ASSERT_FALSE(apduSequence.getSuccessfulStatusWords(0).contains(0x6A83));
+    ASSERT_TRUE(apduSequence.getSuccessfulStatusWords(1).contains(0x6A83));
+}
+
+TEST(ArenaCardRequestTest, getApduRequests_shouldViewArena) {
+    ArenaCardRequest cardRequest(false);
+    cardRequest.addApdu(ByteSpan(SELECT), nullptr, "Select");
+    const std::shared_ptr<ApduRequestSpi> select = cardRequest.getApduRequests()[0];
+    cardRequest.addApdu(ByteSpan(READ), nullptr, "Read");
+
+    const auto& apduRequests = cardRequest.getApduRequests();
+
+    ASSERT_EQ(apduRequests.size(), 2u);
+    ASSERT_EQ(apduRequests[0], select);
+    ASSERT_EQ(select->getApduView().toVector(), SELECT);
+    ASSERT_EQ(apduRequests[1]->getApdu(), READ);
+    ASSERT_EQ(apduRequests[1]->getInfo(), "Read");
+    ASSERT_EQ(apduRequests[1]->getSuccessfulStatusWordSet(), StatusWordSet::getDefault());
+    ASSERT_FALSE(cardRequest.stopOnUnsuccessfulStatusWord());
+}
+
+TEST(ArenaCardRequestTest, getApduRequests_shouldOutliveRequestAndThenBeReleased) {
+    std::weak_ptr<ApduRequestSpi> weakSelect;
+    std::shared_ptr<ApduRequestSpi> select;
+    {
+        ArenaCardRequest cardRequest(true);
+        cardRequest.addApdu(ByteSpan(SELECT)).addApdu(ByteSpan(READ));
+        select = cardRequest.getApduRequests()[0];
+        weakSelect = select;
+    }
+
+    ASSERT_EQ(select->getApduView().toVector(), SELECT);
+
+    select.reset();
+
+    ASSERT_TRUE(weakSelect.expired());
+}
+
+TEST(ArenaCardRequestTest, transmit_shouldCheckStatusWordsFromSequence) {
+    auto card = std::make_shared<SimulatedCard>();
+    const std::vector<uint8_t> recordNotFound = {0x6A, 0x83};
+    card->addResponse(ByteSpan(READ).first(2), ByteSpan(recordNotFound))
+        .addHandler(ByteSpan(), SimulatedCard::echo());
+    SimulatedProxyReader reader(card);
+    auto tolerant = std::make_shared<ArenaCardRequest>(true);
+    tolerant->addApdu(ByteSpan(SELECT))
+        .addApdu(ByteSpan(READ), StatusWordSet::of({0x9000, 0x6A83}));
+    auto strict = std::make_shared<ArenaCardRequest>(true);
+    strict->addApdu(ByteSpan(READ)).addApdu(ByteSpan(SELECT));
+
+    const CardTransmitResult tolerantResult
+        = reader.tryTransmitCardRequest(tolerant, ChannelControl::KEEP_OPEN);
+    const CardTransmitResult strictResult
+        = reader.tryTransmitCardRequest(strict, ChannelControl::KEEP_OPEN);
+
+    ASSERT_TRUE(tolerantResult.isSuccessful());
+    ASSERT_EQ(tolerantResult.getCardResponse()->getApduResponses().size(), 2u);
+    ASSERT_EQ(strictResult.getStatus(), CardTransmitStatus::UNEXPECTED_STATUS_WORD);
+    ASSERT_EQ(strictResult.getCardResponse()->getApduResponses().size(), 1u);
+}
@@ -0,0 +1,65 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ByteSpan.hpp"
+
+using keypop::card::ByteSpan;
+
+TEST(ByteSpanTest, defaultConstructor_shouldBeEmpty) {
+    const ByteSpan span;
+
+    ASSERT_TRUE(span.empty());
+    ASSERT_EQ(span.size(), 0U);
+    ASSERT_EQ(span.begin(), span.end());
+}
+
+TEST(ByteSpanTest, vectorConstructor_shouldReferToVectorStorage) {
+    const std::vector<uint8_t> bytes = {0x00, 0xA4, 0x04, 0x00};
+    const ByteSpan span(bytes);
+
+    ASSERT_EQ(span.data(), bytes.data());
+    ASSERT_EQ(span.size(), 4U);
+    ASSERT_EQ(span[1], 0xA4);
+}
+
+TEST(ByteSpanTest, firstAndLast_shouldSplitDataOutAndStatusWord) {
+    const std::vector<uint8_t> response = {0x12, 0x34, 0x90, 0x00};
+    const ByteSpan span(response);
+
+    ASSERT_EQ(span.first(2).toVector(), std::vector<uint8_t>({0x12, 0x34}));
+    ASSERT_EQ(span.last(2).toVector(), std::vector<uint8_t>({0x90, 0x00}));
+    ASSERT_EQ(span.first(10).size(), 4U);
+    ASSERT_EQ(span.last(10).size(), 4U);
+}
+
+TEST(ByteSpanTest, subspan_shouldClampOutOfRangeValues) {
+    const std::vector<uint8_t> bytes = {0x01, 0x02, 0x03};
+    const ByteSpan span(bytes);
+
+    ASSERT_EQ(span.subspan(1, 1).toVector(), std::vector<uint8_t>({0x02}));
+    ASSERT_EQ(span.subspan(1, 10).toVector(), std::vector<uint8_t>({0x02, 0x03}));
+    ASSERT_TRUE(span.subspan(5, 1).empty());
+}
+
+TEST(ByteSpanTest, equality_shouldCompareContent) {
+    const std::vector<uint8_t> a = {0x01, 0x02};
+    const std::vector<uint8_t> b = {0x01, 0x02};
+    const std::vector<uint8_t> c = {0x01, 0x03};
+
+    ASSERT_TRUE(ByteSpan(a) == ByteSpan(b));
+    ASSERT_TRUE(ByteSpan(a) != ByteSpan(c));
+    ASSERT_TRUE(ByteSpan(a).first(1) == ByteSpan(c).first(1));
+}
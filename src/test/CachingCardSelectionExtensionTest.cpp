@@ -0,0 +1,270 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/spi/CachingCardSelectionExtension.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ApduResponseApi;
+using keypop::card::ByteSpan;
+using keypop::card::CardResponseAdapter;
+using keypop::card::CardResponseApi;
+using keypop::card::CardSelectionResponseApi;
+using keypop::card::spi::CachingCardSelectionExtension;
+using keypop::card::spi::CardSelectionExtensionSpi;
+using keypop::card::spi::CardSelectionRequestSpi;
+using keypop::card::spi::SmartCardSpi;
+
+using testing::_;
+using testing::Return;
+using testing::ReturnRef;
+
+class CardSelectionExtensionSpiMock final : public CardSelectionExtensionSpi {
+public:
+    using CardSelectionExtensionSpi::parse;
+
+    MOCK_METHOD(
+        const std::shared_ptr<CardSelectionRequestSpi>,
+        getCardSelectionRequest,
+        (),
+        (const, override));
+    MOCK_METHOD(
+        std::shared_ptr<SmartCardSpi>,
+        parse,
+        (const std::shared_ptr<CardSelectionResponseApi>),
+        (const, override));
+};
+
+class CardSelectionResponseStub final : public CardSelectionResponseApi {
+public:
+    CardSelectionResponseStub(const std::string& powerOnData, const std::vector<uint8_t>& fci)
+    : mPowerOnData(powerOnData)
+    , selectApplicationResponse(std::make_shared<ApduResponseAdapter>(ByteSpan(fci)))
+    , isMatched(true) {
+    }
+
+    const std::string&
+    getPowerOnData() const override {
+        return mPowerOnData;
+    }
+
+    const std::shared_ptr<ApduResponseApi>
+    getSelectApplicationResponse() const override {
+        return selectApplicationResponse;
+    }
+
+    bool
+    hasMatched() const override {
+        return isMatched;
+    }
+
+    const std::shared_ptr<CardResponseApi>
+    getCardResponse() const override {
+        return cardResponse;
+    }
+
+private:
+    const std::string mPowerOnData;
+
+public:
+    std::shared_ptr<ApduResponseApi> selectApplicationResponse;
+    std::shared_ptr<CardResponseApi> cardResponse;
+    bool isMatched;
+};
+
+class SmartCardStub final : public SmartCardSpi {};
+
+static const std::vector<uint8_t> FCI = {0x6F, 0x02, 0x84, 0x00, 0x90, 0x00};
+
+static const CachingCardSelectionExtension::SmartCardCloner SHARE_IMMUTABLE
+    = [](const std::shared_ptr<SmartCardSpi>& smartCard) { return smartCard; };
+
+TEST(CachingCardSelectionExtensionTest, parse_withSameSelectionData_shouldParseOnce) {
+    auto extension = std::make_shared<CardSelectionExtensionSpiMock>();
+    auto smartCard = std::make_shared<SmartCardStub>();
+    CachingCardSelectionExtension cache(extension, SHARE_IMMUTABLE);
+
+    EXPECT_CALL(*extension, parse(_)).Times(1).WillOnce(Return(smartCard));
+
+    auto first = cache.parse(std::make_shared<CardSelectionResponseStub>("3B8F8001", FCI));
+    auto second = cache.parse(std::make_shared<CardSelectionResponseStub>("3B8F8001", FCI));
+
+    ASSERT_EQ(first, smartCard);
+    ASSERT_EQ(second, smartCard);
+    ASSERT_EQ(cache.getHitCount(), 1u);
+    ASSERT_EQ(cache.getMissCount(), 1u);
+}
+
+TEST(CachingCardSelectionExtensionTest, parse_withDifferentSelectionData_shouldParseEach) {
+    auto extension = std::make_shared<CardSelectionExtensionSpiMock>();
+    CachingCardSelectionExtension cache(extension, SHARE_IMMUTABLE);
+    const std::vector<uint8_t> otherFci = {0x6F, 0x02, 0x84, 0x01, 0x90, 0x00};
+
+    EXPECT_CALL(*extension, parse(_))
+        .Times(3)
+        .WillRepeatedly(testing::Invoke([](const std::shared_ptr<CardSelectionResponseApi>) {
+            return std::make_shared<SmartCardStub>();
+        }));
+
+    auto first = cache.parse(std::make_shared<CardSelectionResponseStub>("3B8F8001", FCI));
+    auto second = cache.parse(std::make_shared<CardSelectionResponseStub>("3B8F8002", FCI));
+    auto third = cache.parse(std::make_shared<CardSelectionResponseStub>("3B8F8001", otherFci));
+
+    ASSERT_NE(first, second);
+    ASSERT_NE(first, third);
+    ASSERT_EQ(cache.size(), 3u);
+}
+
+TEST(CachingCardSelectionExtensionTest, parse_withDifferentOutcomes_shouldParseEach) {
+    auto extension = std::make_shared<CardSelectionExtensionSpiMock>();
+    CachingCardSelectionExtension cache(extension, SHARE_IMMUTABLE);
+    auto selected = std::make_shared<CardSelectionResponseStub>("3B8F8001", FCI);
+    auto withEmptyCardResponse = std::make_shared<CardSelectionResponseStub>("3B8F8001", FCI);
+    withEmptyCardResponse->cardResponse = std::make_shared<CardResponseAdapter>();
+    auto notMatched = std::make_shared<CardSelectionResponseStub>("3B8F8001", FCI);
+    notMatched->isMatched = false;
+    auto withoutSelection = std::make_shared<CardSelectionResponseStub>("3B8F8001", FCI);
+    withoutSelection->selectApplicationResponse = nullptr;
+    auto withEmptySelection = std::make_shared<CardSelectionResponseStub>("3B8F8001", FCI);
+    withEmptySelection->selectApplicationResponse = std::make_shared<ApduResponseAdapter>();
+
+    EXPECT_CALL(*extension, parse(_))
+        .Times(5)
+        .WillRepeatedly(testing::Invoke([](const std::shared_ptr<CardSelectionResponseApi>) {
+            return std::make_shared<SmartCardStub>();
+        }));
+
+    cache.parse(selected);
+    cache.parse(withEmptyCardResponse);
+    cache.parse(notMatched);
+    cache.parse(withoutSelection);
+    cache.parse(withEmptySelection);
+
+    ASSERT_EQ(cache.size(), 5u);
+    ASSERT_EQ(cache.getHitCount(), 0u);
+}
+
+TEST(CachingCardSelectionExtensionTest, parse_whenFull_shouldEvictLeastRecentlyUsed) {
+    auto extension = std::make_shared<CardSelectionExtensionSpiMock>();
+    CachingCardSelectionExtension cache(extension, SHARE_IMMUTABLE, 2);
+    CardSelectionResponseStub a("A", FCI);
+    CardSelectionResponseStub b("B", FCI);
+    CardSelectionResponseStub c("C", FCI);
+
+    EXPECT_CALL(*extension, parse(_))
+        .Times(4)
+        .WillRepeatedly(testing::Invoke([](const std::shared_ptr<CardSelectionResponseApi>) {
+            return std::make_shared<SmartCardStub>();
+        }));
+
+    cache.parse(a);
+    cache.parse(b);
+    cache.parse(a);
+    cache.parse(c);
+    cache.parse(a);
+    cache.parse(b);
+
+    ASSERT_EQ(cache.size(), 2u);
+    ASSERT_EQ(cache.getHitCount(), 2u);
+    ASSERT_EQ(cache.getMissCount(), 4u);
+}
+
+TEST(CachingCardSelectionExtensionTest, parse_withCloner_shouldReturnClones) {
+    auto extension = std::make_shared<CardSelectionExtensionSpiMock>();
+    auto smartCard = std::make_shared<SmartCardStub>();
+    CachingCardSelectionExtension cache(extension, [](const std::shared_ptr<SmartCardSpi>&) {
+        return std::make_shared<SmartCardStub>();
+    });
+
+    EXPECT_CALL(*extension, parse(_)).WillOnce(Return(smartCard));
+
+    auto first = cache.parse(std::make_shared<CardSelectionResponseStub>("3B", FCI));
+    auto second = cache.parse(std::make_shared<CardSelectionResponseStub>("3B", FCI));
+
+    ASSERT_NE(first, smartCard);
+    ASSERT_NE(second, smartCard);
+    ASSERT_NE(first, second);
+}
+
+TEST(CachingCardSelectionExtensionTest, constructor_withoutCloner_shouldThrow) {
+    ASSERT_THROW(
+        CachingCardSelectionExtension(std::make_shared<CardSelectionExtensionSpiMock>(), nullptr),
+        std::invalid_argument);
+}
+
+TEST(CachingCardSelectionExtensionTest, constructor_withoutExtension_shouldThrow) {
+    ASSERT_THROW(
+        CachingCardSelectionExtension(nullptr, SHARE_IMMUTABLE), std::invalid_argument);
+}
+
+TEST(CachingCardSelectionExtensionTest, parse_whenParsingReturnsNull_shouldNotCacheNorClone) {
+    auto extension = std::make_shared<CardSelectionExtensionSpiMock>();
+    int cloneCount = 0;
+    CachingCardSelectionExtension cache(
+        extension, [&cloneCount](const std::shared_ptr<SmartCardSpi>& smartCard) {
+            cloneCount++;
+            return smartCard;
+        });
+    CardSelectionResponseStub response("3B", FCI);
+
+    EXPECT_CALL(*extension, parse(_)).Times(2).WillRepeatedly(Return(nullptr));
+
+    ASSERT_EQ(cache.parse(std::make_shared<CardSelectionResponseStub>("3B", FCI)), nullptr);
+    ASSERT_EQ(cache.parse(response), nullptr);
+    ASSERT_EQ(cache.size(), 0u);
+    ASSERT_EQ(cache.getMissCount(), 2u);
+    ASSERT_EQ(cloneCount, 0);
+}
+
+TEST(CachingCardSelectionExtensionTest, parse_whenParsingFails_shouldNotCache) {
+    auto extension = std::make_shared<CardSelectionExtensionSpiMock>();
+    CachingCardSelectionExtension cache(extension, SHARE_IMMUTABLE);
+
+    EXPECT_CALL(*extension, parse(_))
+        .WillOnce(testing::Throw(std::runtime_error("parse")))
+        .WillOnce(Return(std::make_shared<SmartCardStub>()));
+
+    ASSERT_THROW(
+        cache.parse(std::make_shared<CardSelectionResponseStub>("3B", FCI)), std::runtime_error);
+    ASSERT_NE(cache.parse(std::make_shared<CardSelectionResponseStub>("3B", FCI)), nullptr);
+    ASSERT_EQ(cache.size(), 1u);
+}
+
+TEST(CardSelectionExtensionSpiTest, parseByReference_shouldPassOwningCopyOfResponse) {
+    CardSelectionExtensionSpiMock extension;
+    std::shared_ptr<CardSelectionResponseApi> parsedResponse;
+    std::shared_ptr<ApduResponseApi> selectApplicationResponse;
+
+    EXPECT_CALL(extension, parse(_))
+        .WillOnce(testing::DoAll(
+            testing::SaveArg<0>(&parsedResponse), Return(std::make_shared<SmartCardStub>())));
+
+    {
+        CardSelectionResponseStub response("3B8F8001", FCI);
+        selectApplicationResponse = response.getSelectApplicationResponse();
+        extension.parse(static_cast<const CardSelectionResponseApi&>(response));
+    }
+
+    ASSERT_NE(parsedResponse, nullptr);
+    ASSERT_EQ(parsedResponse.use_count(), 1);
+    ASSERT_EQ(parsedResponse->getPowerOnData(), "3B8F8001");
+    ASSERT_EQ(parsedResponse->getSelectApplicationResponse(), selectApplicationResponse);
+    ASSERT_TRUE(parsedResponse->hasMatched());
+}
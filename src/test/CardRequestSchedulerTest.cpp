@@ -0,0 +1,147 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/CardRequestScheduler.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+
+using keypop::card::ByteSpan;
+using keypop::card::CardRequestScheduler;
+using keypop::card::CardTransmitStatus;
+using keypop::card::ChannelControl;
+using keypop::card::ProxyReaderApi;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::CardRequestAdapter;
+
+static const std::vector<uint8_t> DIGEST = {0x80, 0x8A, 0x00, 0xFF, 0x04, 0x11, 0x22, 0x33, 0x44};
+
+static std::vector<std::shared_ptr<ProxyReaderApi>>
+createReaders(const std::size_t count, const std::chrono::microseconds latency) {
+    std::vector<std::shared_ptr<ProxyReaderApi>> readers;
+    for (std::size_t i = 0; i < count; i++) {
+        auto card = std::make_shared<SimulatedCard>();
+        card->addHandler(ByteSpan(), SimulatedCard::echo(0x9000));
+        auto reader = std::make_shared<SimulatedProxyReader>(card);
+        reader->setLatency(latency, std::chrono::microseconds(0));
+        readers.push_back(reader);
+    }
+
+    return readers;
+}
+
+static std::shared_ptr<CardRequestAdapter>
+createCardRequest() {
+    auto cardRequest = std::make_shared<CardRequestAdapter>(true);
+    cardRequest->addApduRequest(std::make_shared<ApduRequestAdapter>(ByteSpan(DIGEST)));
+
+    return cardRequest;
+}
+
+TEST(CardRequestSchedulerTest, submit_shouldBalanceRequestsOverReaders) {
+    CardRequestScheduler scheduler(createReaders(3, std::chrono::microseconds(2000)));
+
+    std::vector<std::future<CardRequestScheduler::Completion>> futures;
+    for (int i = 0; i < 12; i++) {
+        futures.push_back(scheduler.submit(createCardRequest(), ChannelControl::CLOSE_AFTER));
+    }
+
+    std::set<std::size_t> readerIndexes;
+    for (auto& future : futures) {
+        const CardRequestScheduler::Completion completion = future.get();
+        ASSERT_TRUE(completion.result.isSuccessful());
+        readerIndexes.insert(completion.readerIndex);
+    }
+    ASSERT_GT(readerIndexes.size(), 1u);
+}
+
+TEST(CardRequestSchedulerTest, submitWithAffinity_shouldUseGivenReader) {
+    CardRequestScheduler scheduler(createReaders(3, std::chrono::microseconds(0)));
+
+    const CardRequestScheduler::Completion completion
+        = scheduler.submit(2, createCardRequest(), ChannelControl::CLOSE_AFTER).get();
+
+    ASSERT_EQ(completion.readerIndex, 2u);
+    ASSERT_THROW(
+        scheduler.submit(3, createCardRequest(), ChannelControl::CLOSE_AFTER),
+        std::invalid_argument);
+}
+
+TEST(CardRequestSchedulerTest, keepOpen_shouldReserveReaderUntilReleased) {
+    CardRequestScheduler scheduler(createReaders(2, std::chrono::microseconds(0)));
+
+    const std::size_t reserved
+        = scheduler.submit(createCardRequest(), ChannelControl::KEEP_OPEN).get().readerIndex;
+    for (int i = 0; i < 10; i++) {
+        ASSERT_NE(
+            scheduler.submit(createCardRequest(), ChannelControl::CLOSE_AFTER).get().readerIndex,
+            reserved);
+    }
+    ASSERT_EQ(
+        scheduler.submit(reserved, createCardRequest(), ChannelControl::KEEP_OPEN)
+            .get()
+            .readerIndex,
+        reserved);
+
+    scheduler.releaseChannel(reserved).get();
+
+    std::set<std::size_t> readerIndexes;
+    for (int i = 0; i < 20 && readerIndexes.size() < 2; i++) {
+        readerIndexes.insert(
+            scheduler.submit(createCardRequest(), ChannelControl::CLOSE_AFTER).get().readerIndex);
+    }
+    ASSERT_EQ(readerIndexes.size(), 2u);
+}
+
+TEST(CardRequestSchedulerTest, keepOpen_whenTimedOut_shouldNotReserveReader) {
+    CardRequestScheduler scheduler(createReaders(2, std::chrono::microseconds(2000)));
+    auto cardRequest = createCardRequest();
+    cardRequest->setApduTimeout(std::chrono::microseconds(500));
+
+    const CardRequestScheduler::Completion completion
+        = scheduler.submit(cardRequest, ChannelControl::KEEP_OPEN).get();
+
+    ASSERT_EQ(completion.result.getStatus(), CardTransmitStatus::TIMEOUT);
+    std::set<std::size_t> readerIndexes;
+    for (int i = 0; i < 20 && readerIndexes.size() < 2; i++) {
+        readerIndexes.insert(
+            scheduler.submit(createCardRequest(), ChannelControl::CLOSE_AFTER).get().readerIndex);
+    }
+    ASSERT_EQ(readerIndexes.size(), 2u);
+}
+
+TEST(CardRequestSchedulerTest, shutdown_shouldProcessSubmittedRequestsThenReject) {
+    CardRequestScheduler scheduler(createReaders(2, std::chrono::microseconds(500)));
+    std::vector<std::future<CardRequestScheduler::Completion>> futures;
+    for (int i = 0; i < 8; i++) {
+        futures.push_back(scheduler.submit(createCardRequest(), ChannelControl::CLOSE_AFTER));
+    }
+
+    scheduler.shutdown();
+
+    for (auto& future : futures) {
+        ASSERT_TRUE(future.get().result.isSuccessful());
+    }
+    ASSERT_THROW(
+        scheduler.submit(createCardRequest(), ChannelControl::CLOSE_AFTER), std::logic_error);
+}
@@ -0,0 +1,162 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/CardResponseSummary.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ApduResponseApi;
+using keypop::card::ByteSpan;
+using keypop::card::CardResponseAdapter;
+using keypop::card::CardResponseApi;
+using keypop::card::CardResponseSummary;
+using keypop::card::ChannelControl;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::StatusWordSet;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::CardRequestAdapter;
+
+using StatusWordClass = CardResponseSummary::StatusWordClass;
+
+static std::shared_ptr<ApduResponseApi>
+createApduResponse(const std::vector<uint8_t>& apdu) {
+    return std::make_shared<ApduResponseAdapter>(ByteSpan(apdu));
+}
+
+/* Card response relying on the default implementation of getSummary() */
+class ListCardResponse final : public CardResponseApi {
+public:
+    const std::vector<std::shared_ptr<ApduResponseApi>>&
+    getApduResponses() const override {
+        return mApduResponses;
+    }
+
+    bool
+    isLogicalChannelOpen() const override {
+        return true;
+    }
+
+    std::vector<std::shared_ptr<ApduResponseApi>> mApduResponses;
+};
+
+TEST(CardResponseSummaryTest, classify_shouldFollowIso7816) {
+    ASSERT_EQ(CardResponseSummary::classify(0x9000), StatusWordClass::NORMAL);
+    ASSERT_EQ(CardResponseSummary::classify(0x6110), StatusWordClass::NORMAL);
+    ASSERT_EQ(CardResponseSummary::classify(0x6282), StatusWordClass::WARNING);
+    ASSERT_EQ(CardResponseSummary::classify(0x63C2), StatusWordClass::WARNING);
+    ASSERT_EQ(CardResponseSummary::classify(0x6400), StatusWordClass::EXECUTION_ERROR);
+    ASSERT_EQ(CardResponseSummary::classify(0x6581), StatusWordClass::EXECUTION_ERROR);
+    ASSERT_EQ(CardResponseSummary::classify(0x6700), StatusWordClass::CHECKING_ERROR);
+    ASSERT_EQ(CardResponseSummary::classify(0x6A82), StatusWordClass::CHECKING_ERROR);
+    ASSERT_EQ(CardResponseSummary::classify(0x6F00), StatusWordClass::CHECKING_ERROR);
+    ASSERT_EQ(CardResponseSummary::classify(0x9100), StatusWordClass::PROPRIETARY);
+}
+
+TEST(CardResponseSummaryTest, empty_shouldBeAllSuccessful) {
+    const CardResponseSummary summary;
+
+    ASSERT_EQ(summary.getResponseCount(), 0u);
+    ASSERT_TRUE(summary.isAllSuccessful());
+    ASSERT_EQ(summary.getFirstUnsuccessfulIndex(), CardResponseSummary::NO_INDEX);
+    ASSERT_EQ(summary.getFirstIndex(StatusWordClass::CHECKING_ERROR), CardResponseSummary::NO_INDEX);
+    ASSERT_EQ(summary.getTotalLength(), 0u);
+}
+
+TEST(CardResponseSummaryTest, cardResponseAdapter_shouldMaintainSummary) {
+    CardResponseAdapter cardResponse;
+    cardResponse.addApduResponse(createApduResponse({0x11, 0x22, 0x90, 0x00}));
+    cardResponse.addApduResponse(createApduResponse({0x62, 0x82}), true);
+    cardResponse.addApduResponse(createApduResponse({0x6A, 0x82}));
+    cardResponse.addApduResponse(createApduResponse({0x62, 0x83}));
+
+    const CardResponseSummary summary = cardResponse.getSummary();
+
+    ASSERT_EQ(summary.getResponseCount(), 4u);
+    ASSERT_FALSE(summary.isAllSuccessful());
+    ASSERT_EQ(summary.getFirstUnsuccessfulIndex(), 2u);
+    ASSERT_EQ(summary.getCount(StatusWordClass::NORMAL), 1u);
+    ASSERT_EQ(summary.getCount(StatusWordClass::WARNING), 2u);
+    ASSERT_EQ(summary.getCount(StatusWordClass::EXECUTION_ERROR), 0u);
+    ASSERT_EQ(summary.getCount(StatusWordClass::CHECKING_ERROR), 1u);
+    ASSERT_EQ(summary.getCount(StatusWordClass::PROPRIETARY), 0u);
+    ASSERT_EQ(summary.getFirstIndex(StatusWordClass::WARNING), 1u);
+    ASSERT_EQ(summary.getFirstIndex(StatusWordClass::CHECKING_ERROR), 2u);
+    ASSERT_EQ(summary.getTotalLength(), 10u);
+
+    ASSERT_TRUE(cardResponse.isApduResponseSuccessful(0));
+    ASSERT_TRUE(cardResponse.isApduResponseSuccessful(1));
+    ASSERT_FALSE(cardResponse.isApduResponseSuccessful(2));
+    ASSERT_EQ(cardResponse.getApduRequestIndex(3), 3u);
+
+    cardResponse.reset();
+
+    ASSERT_EQ(cardResponse.getSummary().getResponseCount(), 0u);
+    ASSERT_TRUE(cardResponse.getSummary().isAllSuccessful());
+}
+
+TEST(CardResponseSummaryTest, cardResponseAdapter_shouldKeepRequestIndexOfChainedResponses) {
+    CardResponseAdapter cardResponse;
+    cardResponse.addApduResponse(createApduResponse({0x61, 0x02}), true, 0);
+    cardResponse.addApduResponse(createApduResponse({0x11, 0x22, 0x90, 0x00}), true, 0);
+    cardResponse.addApduResponse(createApduResponse({0x6A, 0x82}), false, 1);
+
+    ASSERT_EQ(cardResponse.getApduRequestIndex(1), 0u);
+    ASSERT_EQ(cardResponse.getApduRequestIndex(2), 1u);
+    ASSERT_TRUE(cardResponse.isApduResponseSuccessful(0));
+    ASSERT_EQ(cardResponse.getSummary().getFirstUnsuccessfulIndex(), 2u);
+}
+
+TEST(CardResponseSummaryTest, defaultImplementation_shouldScanResponses) {
+    ListCardResponse cardResponse;
+    cardResponse.mApduResponses.push_back(createApduResponse({0x90, 0x00}));
+    cardResponse.mApduResponses.push_back(createApduResponse({0x11, 0x6A, 0x82}));
+
+    const CardResponseSummary summary = cardResponse.getSummary();
+
+    ASSERT_EQ(summary.getResponseCount(), 2u);
+    ASSERT_EQ(summary.getFirstUnsuccessfulIndex(), 1u);
+    ASSERT_EQ(summary.getCount(StatusWordClass::CHECKING_ERROR), 1u);
+    ASSERT_EQ(summary.getTotalLength(), 5u);
+}
+
+TEST(CardResponseSummaryTest, simulatedProxyReader_shouldApplySuccessfulStatusWords) {
+    const std::vector<uint8_t> read = {0x00, 0xB2, 0x01, 0x04, 0x00};
+    const std::vector<uint8_t> update = {0x00, 0xDC, 0x01, 0x04, 0x01, 0x00};
+    const std::vector<uint8_t> warning = {0x62, 0x82};
+    auto card = std::make_shared<SimulatedCard>();
+    card->addResponse(ByteSpan(read).first(2), ByteSpan(warning))
+        .addResponse(ByteSpan(update).first(2), ByteSpan(warning));
+    SimulatedProxyReader reader(card);
+
+    auto readRequest = std::make_shared<ApduRequestAdapter>(ByteSpan(read));
+    readRequest->setSuccessfulStatusWords(StatusWordSet::of({0x9000, 0x6282}));
+    auto cardRequest = std::make_shared<CardRequestAdapter>(false);
+    cardRequest->addApduRequest(readRequest)
+        .addApduRequest(std::make_shared<ApduRequestAdapter>(ByteSpan(update)));
+
+    const CardResponseSummary summary
+        = reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN)->getSummary();
+
+    ASSERT_EQ(summary.getCount(StatusWordClass::WARNING), 2u);
+    ASSERT_EQ(summary.getFirstUnsuccessfulIndex(), 1u);
+}
@@ -0,0 +1,400 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/CardBrokenCommunicationException.hpp"
+#include "keypop/card/CardSelectionProcessor.hpp"
+#include "keypop/card/CardSelectionScenario.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/CardSelectionRequestSpi.hpp"
+
+#include "CardTestFixture.hpp"
+
+using keypop::card::ApduResponseApi;
+using keypop::card::ApduResponseBuffer;
+using keypop::card::ByteSpan;
+using keypop::card::CardBrokenCommunicationException;
+using keypop::card::CardResponseApi;
+using keypop::card::CardSelectionProcessor;
+using keypop::card::CardSelectionResponseApi;
+using keypop::card::CardSelectionScenario;
+using keypop::card::CardTransmitResult;
+using keypop::card::ChannelControl;
+using keypop::card::MultiSelectionProcessing;
+using keypop::card::ProxyReaderApi;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::StatusWordSet;
+using keypop::card::spi::CardRequestSpi;
+using keypop::card::spi::CardSelectionRequestSpi;
+
+static const std::vector<uint8_t> AID_1 = {0x31, 0x54};
+static const std::vector<uint8_t> AID_2 = {0xA0, 0x00, 0x00, 0x04, 0x04, 0x01, 0x25};
+static const std::vector<uint8_t> SELECT_AID_1 = {0x00, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54};
+static const std::vector<uint8_t> SELECT_AID_2_LAST_FCP
+    = {0x00, 0xA4, 0x04, 0x05, 0x07, 0xA0, 0x00, 0x00, 0x04, 0x04, 0x01, 0x25, 0x00};
+static const std::vector<uint8_t> NOT_FOUND = {0x6A, 0x82};
+static const std::vector<uint8_t> INVALIDATED = {0x62, 0x83};
+
+class CardSelectionRequest final : public CardSelectionRequestSpi {
+public:
+    CardSelectionRequest(
+        const std::vector<uint8_t>& aid, const std::shared_ptr<CardRequestSpi>& cardRequest)
+    : mAid(aid)
+    , mCardRequest(cardRequest)
+    , mFileOccurrence(FileOccurrence::FIRST)
+    , mFileControlInformation(FileControlInformation::FCI)
+    , mSuccessfulSelectionStatusWords(StatusWordSet::getDefault()) {
+    }
+
+    ByteSpan
+    getAid() const override {
+        return ByteSpan(mAid);
+    }
+
+    FileOccurrence
+    getFileOccurrence() const override {
+        return mFileOccurrence;
+    }
+
+    FileControlInformation
+    getFileControlInformation() const override {
+        return mFileControlInformation;
+    }
+
+    std::shared_ptr<const StatusWordSet>
+    getSuccessfulSelectionStatusWordSet() const override {
+        return mSuccessfulSelectionStatusWords;
+    }
+
+    const std::shared_ptr<CardRequestSpi>
+    getCardRequest() const override {
+        return mCardRequest;
+    }
+
+    const std::vector<uint8_t> mAid;
+    const std::shared_ptr<CardRequestSpi> mCardRequest;
+    FileOccurrence mFileOccurrence;
+    FileControlInformation mFileControlInformation;
+    std::shared_ptr<const StatusWordSet> mSuccessfulSelectionStatusWords;
+};
+
+/* Reader counting the channel releases */
+class ReleaseTrackingReader final : public ProxyReaderApi {
+public:
+    using ProxyReaderApi::transmitCardRequest;
+
+    explicit ReleaseTrackingReader(const std::shared_ptr<ProxyReaderApi>& reader)
+    : mReader(reader)
+    , mReleaseCount(0) {
+    }
+
+    const std::shared_ptr<CardResponseApi>
+    transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        return mReader->transmitCardRequest(cardRequest, channelControl);
+    }
+
+    CardTransmitResult
+    tryTransmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        return mReader->tryTransmitCardRequest(cardRequest, channelControl);
+    }
+
+    void
+    releaseChannel() override {
+        mReleaseCount++;
+        mReader->releaseChannel();
+    }
+
+    const std::shared_ptr<ProxyReaderApi> mReader;
+    int mReleaseCount;
+};
+
+/* Card response classifying the responses with the default rule of CardResponseApi */
+class PlainCardResponse final : public CardResponseApi {
+public:
+    explicit PlainCardResponse(const std::shared_ptr<CardResponseApi>& cardResponse)
+    : mApduResponses(cardResponse->getApduResponses())
+    , mIsLogicalChannelOpen(cardResponse->isLogicalChannelOpen()) {
+    }
+
+    const std::vector<std::shared_ptr<ApduResponseApi>>&
+    getApduResponses() const override {
+        return mApduResponses;
+    }
+
+    bool
+    isLogicalChannelOpen() const override {
+        return mIsLogicalChannelOpen;
+    }
+
+    const std::vector<std::shared_ptr<ApduResponseApi>> mApduResponses;
+    const bool mIsLogicalChannelOpen;
+};
+
+/* Reader returning plain card responses */
+class PlainResponseReader final : public ProxyReaderApi {
+public:
+    using ProxyReaderApi::transmitCardRequest;
+
+    explicit PlainResponseReader(const std::shared_ptr<ProxyReaderApi>& reader)
+    : mReader(reader) {
+    }
+
+    const std::shared_ptr<CardResponseApi>
+    transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        return std::make_shared<PlainCardResponse>(
+            mReader->transmitCardRequest(cardRequest, channelControl));
+    }
+
+    CardTransmitResult
+    tryTransmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        const CardTransmitResult result
+            = mReader->tryTransmitCardRequest(cardRequest, channelControl);
+
+        return CardTransmitResult(
+            result.getStatus(),
+            std::make_shared<PlainCardResponse>(result.getCardResponse()),
+            result.isCardResponseComplete());
+    }
+
+    void
+    releaseChannel() override {
+        mReader->releaseChannel();
+    }
+
+    const std::shared_ptr<ProxyReaderApi> mReader;
+};
+
+/* Card answering the selection of AID_1 with FCI, 6A82h for any other AID, and READ with RECORD */
+static std::shared_ptr<SimulatedCard>
+createSelectionCard() {
+    auto card = std::make_shared<SimulatedCard>();
+    card->addResponse(ByteSpan(SELECT_AID_1), ByteSpan(FCI))
+        .addResponse(ByteSpan(SELECT_AID_1).first(4), ByteSpan(NOT_FOUND))
+        .addResponse(ByteSpan(READ).first(2), ByteSpan(RECORD));
+
+    return card;
+}
+
+static std::shared_ptr<CardSelectionScenario>
+createScenario(
+    const std::vector<std::shared_ptr<CardSelectionRequestSpi>>& cardSelectionRequests,
+    const MultiSelectionProcessing multiSelectionProcessing,
+    const ChannelControl channelControl = ChannelControl::KEEP_OPEN) {
+    return std::make_shared<CardSelectionScenario>(
+        cardSelectionRequests, multiSelectionProcessing, channelControl);
+}
+
+TEST(CardSelectionProcessorTest, scenario_withoutRequest_shouldThrowInvalidArgument) {
+    EXPECT_THROW(
+        createScenario({}, MultiSelectionProcessing::FIRST_MATCH), std::invalid_argument);
+    EXPECT_THROW(
+        createScenario({nullptr}, MultiSelectionProcessing::FIRST_MATCH), std::invalid_argument);
+}
+
+TEST(CardSelectionProcessorTest, processor_withNullReader_shouldThrowInvalidArgument) {
+    EXPECT_THROW(CardSelectionProcessor(nullptr), std::invalid_argument);
+}
+
+TEST(CardSelectionProcessorTest, firstMatch_shouldStopAtMatchingRequestAndExecuteItsCardRequest) {
+    auto reader = std::make_shared<SimulatedProxyReader>(createSelectionCard());
+    CardSelectionProcessor processor(reader);
+
+    const std::vector<std::shared_ptr<CardSelectionResponseApi>> cardSelectionResponses
+        = processor.processCardSelectionScenario(createScenario(
+            {std::make_shared<CardSelectionRequest>(AID_2, createCardRequest({READ})),
+             std::make_shared<CardSelectionRequest>(AID_1, createCardRequest({READ})),
+             std::make_shared<CardSelectionRequest>(AID_1, nullptr)},
+            MultiSelectionProcessing::FIRST_MATCH));
+
+    ASSERT_EQ(cardSelectionResponses.size(), 2U);
+    EXPECT_FALSE(cardSelectionResponses[0]->hasMatched());
+    EXPECT_EQ(
+        cardSelectionResponses[0]->getSelectApplicationResponse()->getStatusWord(), 0x6A82);
+    EXPECT_EQ(cardSelectionResponses[0]->getCardResponse(), nullptr);
+    EXPECT_TRUE(cardSelectionResponses[1]->hasMatched());
+    EXPECT_EQ(
+        cardSelectionResponses[1]->getSelectApplicationResponse()->getApdu(),
+        std::vector<uint8_t>(FCI));
+    ASSERT_NE(cardSelectionResponses[1]->getCardResponse(), nullptr);
+    EXPECT_EQ(
+        cardSelectionResponses[1]->getCardResponse()->getApduResponses()[0]->getApdu(),
+        std::vector<uint8_t>(RECORD));
+    EXPECT_EQ(reader->getExchangedApduCount(), 3U);
+}
+
+TEST(CardSelectionProcessorTest, processAll_shouldProcessEveryRequest) {
+    auto reader = std::make_shared<SimulatedProxyReader>(createSelectionCard());
+    CardSelectionProcessor processor(reader);
+
+    const std::vector<std::shared_ptr<CardSelectionResponseApi>> cardSelectionResponses
+        = processor.processCardSelectionScenario(createScenario(
+            {std::make_shared<CardSelectionRequest>(AID_1, nullptr),
+             std::make_shared<CardSelectionRequest>(AID_2, createCardRequest({READ}))},
+            MultiSelectionProcessing::PROCESS_ALL));
+
+    ASSERT_EQ(cardSelectionResponses.size(), 2U);
+    EXPECT_TRUE(cardSelectionResponses[0]->hasMatched());
+    EXPECT_FALSE(cardSelectionResponses[1]->hasMatched());
+    EXPECT_EQ(cardSelectionResponses[1]->getCardResponse(), nullptr);
+    EXPECT_EQ(reader->getExchangedApduCount(), 2U);
+}
+
+TEST(CardSelectionProcessorTest, select_shouldEncodeSelectionDataOfRequest) {
+    auto card = std::make_shared<SimulatedCard>();
+    card->addResponse(ByteSpan(SELECT_AID_2_LAST_FCP), ByteSpan(INVALIDATED));
+    CardSelectionProcessor processor(std::make_shared<SimulatedProxyReader>(card));
+    auto cardSelectionRequest = std::make_shared<CardSelectionRequest>(AID_2, nullptr);
+    cardSelectionRequest->mFileOccurrence = CardSelectionRequestSpi::FileOccurrence::LAST;
+    cardSelectionRequest->mFileControlInformation
+        = CardSelectionRequestSpi::FileControlInformation::FCP;
+    cardSelectionRequest->mSuccessfulSelectionStatusWords = StatusWordSet::of({0x9000, 0x6283});
+
+    const std::vector<std::shared_ptr<CardSelectionResponseApi>> cardSelectionResponses
+        = processor.processCardSelectionScenario(
+            createScenario({cardSelectionRequest}, MultiSelectionProcessing::FIRST_MATCH));
+
+    ASSERT_EQ(cardSelectionResponses.size(), 1U);
+    EXPECT_TRUE(cardSelectionResponses[0]->hasMatched());
+    EXPECT_EQ(cardSelectionResponses[0]->getSelectApplicationResponse()->getStatusWord(), 0x6283);
+}
+
+TEST(CardSelectionProcessorTest, select_withNoResponse_shouldOmitLe) {
+    std::vector<uint8_t> command;
+    auto card = std::make_shared<SimulatedCard>();
+    card->addHandler(ByteSpan(), [&command](const ByteSpan apdu, ApduResponseBuffer& response) {
+        command.assign(apdu.begin(), apdu.end());
+        response.push_back(0x90);
+        response.push_back(0x00);
+    });
+    CardSelectionProcessor processor(std::make_shared<SimulatedProxyReader>(card));
+    auto cardSelectionRequest = std::make_shared<CardSelectionRequest>(AID_1, nullptr);
+    cardSelectionRequest->mFileControlInformation
+        = CardSelectionRequestSpi::FileControlInformation::NO_RESPONSE;
+
+    const std::vector<std::shared_ptr<CardSelectionResponseApi>> cardSelectionResponses
+        = processor.processCardSelectionScenario(
+            createScenario({cardSelectionRequest}, MultiSelectionProcessing::FIRST_MATCH));
+
+    ASSERT_EQ(command, std::vector<uint8_t>({0x00, 0xA4, 0x04, 0x0C, 0x02, 0x31, 0x54}));
+    EXPECT_TRUE(cardSelectionResponses[0]->hasMatched());
+}
+
+TEST(CardSelectionProcessorTest, select_withoutAid_shouldMatchWithoutExchange) {
+    auto reader = std::make_shared<SimulatedProxyReader>(createSelectionCard());
+    CardSelectionProcessor processor(reader);
+
+    const std::vector<std::shared_ptr<CardSelectionResponseApi>> cardSelectionResponses
+        = processor.processCardSelectionScenario(createScenario(
+            {std::make_shared<CardSelectionRequest>(std::vector<uint8_t>(), nullptr)},
+            MultiSelectionProcessing::FIRST_MATCH));
+
+    ASSERT_EQ(cardSelectionResponses.size(), 1U);
+    EXPECT_TRUE(cardSelectionResponses[0]->hasMatched());
+    EXPECT_EQ(cardSelectionResponses[0]->getSelectApplicationResponse(), nullptr);
+    EXPECT_EQ(reader->getExchangedApduCount(), 0U);
+}
+
+TEST(CardSelectionProcessorTest, select_withAidTooLong_shouldThrowInvalidArgument) {
+    CardSelectionProcessor processor(std::make_shared<SimulatedProxyReader>(createSelectionCard()));
+
+    EXPECT_THROW(
+        processor.processCardSelectionScenario(createScenario(
+            {std::make_shared<CardSelectionRequest>(std::vector<uint8_t>(17, 0xA0), nullptr)},
+            MultiSelectionProcessing::FIRST_MATCH)),
+        std::invalid_argument);
+}
+
+TEST(CardSelectionProcessorTest, cardRequest_withUnexpectedStatusWord_shouldKeepPartialResponse) {
+    CardSelectionProcessor processor(std::make_shared<SimulatedProxyReader>(createSelectionCard()));
+
+    const std::vector<std::shared_ptr<CardSelectionResponseApi>> cardSelectionResponses
+        = processor.processCardSelectionScenario(createScenario(
+            {std::make_shared<CardSelectionRequest>(AID_1, createCardRequest({UNKNOWN, READ}))},
+            MultiSelectionProcessing::FIRST_MATCH));
+
+    ASSERT_EQ(cardSelectionResponses.size(), 1U);
+    EXPECT_TRUE(cardSelectionResponses[0]->hasMatched());
+    EXPECT_EQ(cardSelectionResponses[0]->getCardResponse()->getApduResponses().size(), 1U);
+}
+
+TEST(CardSelectionProcessorTest, closeAfter_shouldReleaseChannelOnceAfterLastRequest) {
+    auto reader = std::make_shared<ReleaseTrackingReader>(
+        std::make_shared<SimulatedProxyReader>(createSelectionCard()));
+    CardSelectionProcessor processor(reader);
+
+    processor.processCardSelectionScenario(createScenario(
+        {std::make_shared<CardSelectionRequest>(AID_2, nullptr),
+         std::make_shared<CardSelectionRequest>(AID_1, nullptr)},
+        MultiSelectionProcessing::PROCESS_ALL,
+        ChannelControl::CLOSE_AFTER));
+
+    EXPECT_EQ(reader->mReleaseCount, 1);
+}
+
+TEST(CardSelectionProcessorTest, keepOpen_shouldNotReleaseChannel) {
+    auto reader = std::make_shared<ReleaseTrackingReader>(
+        std::make_shared<SimulatedProxyReader>(createSelectionCard()));
+    CardSelectionProcessor processor(reader);
+
+    processor.processCardSelectionScenario(createScenario(
+        {std::make_shared<CardSelectionRequest>(AID_1, nullptr)},
+        MultiSelectionProcessing::FIRST_MATCH));
+
+    EXPECT_EQ(reader->mReleaseCount, 0);
+}
+
+TEST(CardSelectionProcessorTest, select_withPlainResponses_shouldMatchSelectionStatusWords) {
+    auto card = std::make_shared<SimulatedCard>();
+    card->addResponse(ByteSpan(SELECT_AID_1).first(4), ByteSpan(INVALIDATED));
+    CardSelectionProcessor processor(
+        std::make_shared<PlainResponseReader>(std::make_shared<SimulatedProxyReader>(card)));
+    auto cardSelectionRequest = std::make_shared<CardSelectionRequest>(AID_1, nullptr);
+    cardSelectionRequest->mSuccessfulSelectionStatusWords = StatusWordSet::of({0x9000, 0x6283});
+
+    const std::vector<std::shared_ptr<CardSelectionResponseApi>> cardSelectionResponses
+        = processor.processCardSelectionScenario(
+            createScenario({cardSelectionRequest}, MultiSelectionProcessing::FIRST_MATCH));
+
+    ASSERT_EQ(cardSelectionResponses.size(), 1U);
+    EXPECT_TRUE(cardSelectionResponses[0]->hasMatched());
+}
+
+TEST(CardSelectionProcessorTest, closeAfter_whenTransmissionFails_shouldReleaseChannel) {
+    auto simulatedReader = std::make_shared<SimulatedProxyReader>(createSelectionCard());
+    simulatedReader->scheduleFault(1, SimulatedProxyReader::Fault::CARD_BROKEN_COMMUNICATION);
+    auto reader = std::make_shared<ReleaseTrackingReader>(simulatedReader);
+    CardSelectionProcessor processor(reader);
+
+    EXPECT_THROW(
+        processor.processCardSelectionScenario(createScenario(
+            {std::make_shared<CardSelectionRequest>(AID_1, createCardRequest({READ}))},
+            MultiSelectionProcessing::FIRST_MATCH,
+            ChannelControl::CLOSE_AFTER)),
+        CardBrokenCommunicationException);
+    EXPECT_EQ(reader->mReleaseCount, 1);
+}
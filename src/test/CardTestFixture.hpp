@@ -0,0 +1,80 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/* Keypop Card */
+#include "keypop/card/ByteSpan.hpp"
+#include "keypop/card/SimulatedCard.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/ArenaCardRequest.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+
+/* Commands and responses shared by the tests driving a simulated card */
+static const std::vector<uint8_t> SELECT = {0x00, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54};
+static const std::vector<uint8_t> READ = {0x00, 0xB2, 0x01, 0x04, 0x00};
+static const std::vector<uint8_t> UNKNOWN = {0x00, 0x84, 0x00, 0x00, 0x08};
+static const std::vector<uint8_t> FCI = {0x6F, 0x00, 0x90, 0x00};
+static const std::vector<uint8_t> RECORD = {0x11, 0x22, 0x90, 0x00};
+
+/* Card answering SELECT with FCI and READ with RECORD, 6D00h otherwise */
+inline std::shared_ptr<keypop::card::SimulatedCard>
+createCard() {
+    auto card = std::make_shared<keypop::card::SimulatedCard>();
+    card->addResponse(keypop::card::ByteSpan(SELECT).first(4), keypop::card::ByteSpan(FCI))
+        .addResponse(keypop::card::ByteSpan(READ).first(2), keypop::card::ByteSpan(RECORD));
+
+    return card;
+}
+
+/* Card request stopping on the first unexpected status word, with named APDUs */
+inline std::shared_ptr<keypop::card::spi::CardRequestAdapter>
+createCardRequest(const std::vector<std::vector<uint8_t>>& apdus) {
+    auto cardRequest = std::make_shared<keypop::card::spi::CardRequestAdapter>(true);
+    for (const auto& apdu : apdus) {
+        auto apduRequest
+            = std::make_shared<keypop::card::spi::ApduRequestAdapter>(keypop::card::ByteSpan(apdu));
+        apduRequest->setInfo(apdu == SELECT ? "Select" : apdu == READ ? "Read" : "Unknown");
+        cardRequest->addApduRequest(apduRequest);
+    }
+
+    return cardRequest;
+}
+
+/* Card request providing the APDUs of an arena, counting the calls to the legacy accessor */
+class SequenceCardRequest final : public keypop::card::spi::CardRequestSpi {
+public:
+    SequenceCardRequest()
+    : arena(true)
+    , legacyCallCount(0) {
+    }
+
+    const std::vector<std::shared_ptr<keypop::card::spi::ApduRequestSpi>>&
+    getApduRequests() const override {
+        legacyCallCount++;
+        return arena.getApduRequests();
+    }
+
+    bool
+    stopOnUnsuccessfulStatusWord() const override {
+        return arena.stopOnUnsuccessfulStatusWord();
+    }
+
+    keypop::card::spi::ApduSequenceView
+    getApduSequence() const override {
+        return arena.getApduSequence();
+    }
+
+    keypop::card::spi::ArenaCardRequest arena;
+    mutable int legacyCallCount;
+};
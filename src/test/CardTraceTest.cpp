@@ -0,0 +1,372 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/CardTraceEntry.hpp"
+#include "keypop/card/CardTraceRing.hpp"
+#include "keypop/card/RecordingProxyReader.hpp"
+#include "keypop/card/ReplayProxyReader.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/spi/ApduResponseObserverSpi.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+#include "keypop/card/spi/Iso7816ApduChaining.hpp"
+#include "keypop/card/spi/SegmentedApduRequest.hpp"
+
+#include "CardTestFixture.hpp"
+
+using keypop::card::ApduResponseApi;
+using keypop::card::ByteSpan;
+using keypop::card::CardTraceEntry;
+using keypop::card::CardTraceRing;
+using keypop::card::CardTransmitStatus;
+using keypop::card::ChannelControl;
+using keypop::card::ReaderBrokenCommunicationException;
+using keypop::card::RecordingProxyReader;
+using keypop::card::ReplayProxyReader;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::UnexpectedStatusWordException;
+using keypop::card::spi::ApduCommand;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::ApduResponseObserverSpi;
+using keypop::card::spi::CardRequestAdapter;
+using keypop::card::spi::Iso7816ApduChaining;
+using keypop::card::spi::SegmentedApduRequest;
+
+/**
+ * Observer keeping the request indexes notified.
+ */
+class IndexObserver final : public ApduResponseObserverSpi {
+public:
+    void
+    onApduResponse(const std::size_t index, const std::shared_ptr<ApduResponseApi>) override {
+        indexes.push_back(index);
+    }
+
+    std::vector<std::size_t> indexes;
+};
+
+static CardTraceEntry
+createEntry(const std::size_t responseLength) {
+    CardTraceEntry entry;
+    entry.timestamp = 0x0123456789ABCDEF;
+    entry.duration = 300000;
+    entry.channelControl = ChannelControl::CLOSE_AFTER;
+    entry.status = CardTransmitStatus::CARD_BROKEN_COMMUNICATION;
+    entry.isLogicalChannelOpen = true;
+    entry.isCardResponseComplete = false;
+    entry.apduRequests = {SELECT, READ};
+    entry.apduResponses = {std::vector<uint8_t>(responseLength, 0x5A)};
+    entry.apduResponseSuccesses = {true};
+    entry.apduRequestIndexes = {1};
+
+    return entry;
+}
+
+TEST(CardTraceTest, entry_shouldRoundTrip) {
+    std::vector<uint8_t> record;
+    createEntry(200).encode(record);
+
+    const CardTraceEntry entry = CardTraceEntry::decode(ByteSpan(record));
+
+    ASSERT_EQ(entry.timestamp, 0x0123456789ABCDEFu);
+    ASSERT_EQ(entry.duration, 300000u);
+    ASSERT_EQ(entry.channelControl, ChannelControl::CLOSE_AFTER);
+    ASSERT_EQ(entry.status, CardTransmitStatus::CARD_BROKEN_COMMUNICATION);
+    ASSERT_TRUE(entry.stopOnUnsuccessfulStatusWord);
+    ASSERT_TRUE(entry.isLogicalChannelOpen);
+    ASSERT_FALSE(entry.isCardResponseComplete);
+    ASSERT_EQ(entry.apduRequests, std::vector<std::vector<uint8_t>>({SELECT, READ}));
+    ASSERT_EQ(entry.apduResponses.size(), 1u);
+    ASSERT_EQ(entry.apduResponses[0], std::vector<uint8_t>(200, 0x5A));
+    ASSERT_EQ(entry.apduResponseSuccesses, std::vector<bool>({true}));
+    ASSERT_EQ(entry.apduRequestIndexes, std::vector<std::size_t>({1}));
+}
+
+TEST(CardTraceTest, entry_withRequestIndexOutOfRange_shouldThrowInvalidArgument) {
+    CardTraceEntry entry = createEntry(4);
+    entry.apduRequestIndexes = {2};
+    std::vector<uint8_t> record;
+    entry.encode(record);
+
+    ASSERT_THROW(CardTraceEntry::decode(ByteSpan(record)), std::invalid_argument);
+}
+
+TEST(CardTraceTest, entry_whenTruncated_shouldThrowInvalidArgument) {
+    std::vector<uint8_t> record;
+    createEntry(4).encode(record);
+    record.pop_back();
+
+    ASSERT_THROW(CardTraceEntry::decode(ByteSpan(record)), std::invalid_argument);
+}
+
+TEST(CardTraceTest, ring_whenFull_shouldOverwriteOldestRecords) {
+    std::vector<uint8_t> block(80 + 40);
+    CardTraceRing ring(block.data(), block.size());
+
+    for (uint8_t i = 0; i < 10; i++) {
+        ASSERT_TRUE(ring.append(ByteSpan(std::vector<uint8_t>(6, i))));
+    }
+    ASSERT_FALSE(ring.append(ByteSpan(std::vector<uint8_t>(37, 0))));
+
+    std::vector<uint8_t> firstBytes;
+    ring.forEachRecord([&firstBytes](const ByteSpan record) {
+        ASSERT_EQ(record.size(), 6u);
+        firstBytes.push_back(record[0]);
+    });
+    ASSERT_EQ(firstBytes, std::vector<uint8_t>({6, 7, 8, 9}));
+}
+
+TEST(CardTraceTest, ring_shouldResumeRecordsOfBlock) {
+    std::vector<uint8_t> block(256);
+    {
+        CardTraceRing ring(block.data(), block.size());
+        ring.append(ByteSpan(SELECT));
+        ring.append(ByteSpan(READ));
+    }
+
+    CardTraceRing resumed(block.data(), block.size());
+
+    ASSERT_EQ(resumed.getRecordCount(), 2u);
+    ASSERT_EQ(CardTraceRing(block.data(), block.size() - 1).getRecordCount(), 0u);
+}
+
+static std::vector<uint8_t>
+getFirstBytes(const CardTraceRing& ring) {
+    std::vector<uint8_t> firstBytes;
+    ring.forEachRecord([&firstBytes](const ByteSpan record) { firstBytes.push_back(record[0]); });
+
+    return firstBytes;
+}
+
+/* Ring of 40 bytes holding the records {1}, {2}, {3} and {4} of 6 bytes, {0} being evicted */
+static std::vector<uint8_t>
+createFullRingBlock() {
+    std::vector<uint8_t> block(80 + 40);
+    CardTraceRing ring(block.data(), block.size());
+    for (uint8_t i = 0; i < 5; i++) {
+        ring.append(ByteSpan(std::vector<uint8_t>(6, i)));
+    }
+
+    return block;
+}
+
+TEST(CardTraceTest, ring_whenAppendIsTorn_shouldResumePreviousRecords) {
+    const std::vector<uint8_t> block = createFullRingBlock();
+    std::vector<std::vector<uint8_t>> firstBytes;
+
+    /* Crash while writing either copy of the positions (at offset 16 and 48) */
+    for (const std::size_t offset : {16, 48}) {
+        std::vector<uint8_t> tornBlock(block);
+        tornBlock[offset + 8] ^= 0xFF;
+        firstBytes.push_back(getFirstBytes(CardTraceRing(tornBlock.data(), tornBlock.size())));
+    }
+
+    /* The latest copy is lost with the record being appended, the previous one is intact */
+    std::sort(firstBytes.begin(), firstBytes.end());
+    ASSERT_EQ(firstBytes, std::vector<std::vector<uint8_t>>({{1, 2, 3}, {1, 2, 3, 4}}));
+}
+
+TEST(CardTraceTest, ring_withCorruptedHeaderByte_shouldResumeFromValidPositions) {
+    const std::vector<uint8_t> block = createFullRingBlock();
+
+    for (std::size_t offset = 16; offset < 80; offset++) {
+        std::vector<uint8_t> corruptedBlock(block);
+        corruptedBlock[offset] ^= 0x01;
+
+        const std::vector<uint8_t> firstBytes
+            = getFirstBytes(CardTraceRing(corruptedBlock.data(), corruptedBlock.size()));
+
+        ASSERT_TRUE(
+            firstBytes == std::vector<uint8_t>({1, 2, 3, 4})
+            || firstBytes == std::vector<uint8_t>({1, 2, 3}))
+            << "Corrupted header byte " << offset;
+    }
+}
+
+TEST(CardTraceTest, ring_withInvalidRecord_shouldTruncateBeforeIt) {
+    std::vector<uint8_t> block(256);
+    {
+        CardTraceRing ring(block.data(), block.size());
+        for (uint8_t i = 0; i < 3; i++) {
+            ring.append(ByteSpan(std::vector<uint8_t>(6, i)));
+        }
+    }
+    /* Length of the last record beyond the head */
+    block[80 + 20] = 0xFF;
+
+    CardTraceRing resumed(block.data(), block.size());
+
+    ASSERT_EQ(getFirstBytes(resumed), std::vector<uint8_t>({0, 1}));
+    ASSERT_TRUE(resumed.append(ByteSpan(std::vector<uint8_t>(6, 3))));
+    ASSERT_EQ(getFirstBytes(resumed), std::vector<uint8_t>({0, 1, 3}));
+}
+
+TEST(CardTraceTest, replay_shouldReproduceRecordedSession) {
+    std::vector<uint8_t> block(4096);
+    auto ring = std::make_shared<CardTraceRing>(block.data(), block.size());
+    RecordingProxyReader recorder(std::make_shared<SimulatedProxyReader>(createCard()), ring);
+
+    recorder.transmitCardRequest(createCardRequest({SELECT, READ}), ChannelControl::KEEP_OPEN);
+    ASSERT_THROW(
+        recorder.transmitCardRequest(createCardRequest({UNKNOWN}), ChannelControl::CLOSE_AFTER),
+        UnexpectedStatusWordException);
+    ASSERT_EQ(ring->getRecordCount(), 2u);
+
+    ReplayProxyReader replay(*ring);
+    auto cardResponse
+        = replay.transmitCardRequest(createCardRequest({SELECT, READ}), ChannelControl::KEEP_OPEN);
+    ASSERT_EQ(cardResponse->getApduResponses()[0]->getApdu(), FCI);
+    ASSERT_EQ(cardResponse->getApduResponses()[1]->getApdu(), RECORD);
+    ASSERT_TRUE(cardResponse->isLogicalChannelOpen());
+    try {
+        replay.transmitCardRequest(createCardRequest({UNKNOWN}), ChannelControl::CLOSE_AFTER);
+        FAIL();
+    } catch (UnexpectedStatusWordException& e) {
+        ASSERT_EQ(e.getCardResponse()->getApduResponses()[0]->getStatusWord(), 0x6D00);
+    }
+    ASSERT_EQ(replay.getRemainingCount(), 0u);
+    ASSERT_THROW(
+        replay.transmitCardRequest(createCardRequest({READ}), ChannelControl::KEEP_OPEN),
+        ReaderBrokenCommunicationException);
+
+    replay.rewind();
+
+    ASSERT_THROW(
+        replay.transmitCardRequest(createCardRequest({READ}), ChannelControl::KEEP_OPEN),
+        std::invalid_argument);
+}
+
+TEST(CardTraceTest, replayByReference_shouldReproduceSessionRecordedByReference) {
+    std::vector<uint8_t> block(4096);
+    auto ring = std::make_shared<CardTraceRing>(block.data(), block.size());
+    RecordingProxyReader recorder(std::make_shared<SimulatedProxyReader>(createCard()), ring);
+
+    recorder.transmitCardRequest(*createCardRequest({SELECT, READ}), ChannelControl::KEEP_OPEN);
+    ASSERT_THROW(
+        recorder.transmitCardRequest(*createCardRequest({UNKNOWN}), ChannelControl::CLOSE_AFTER),
+        UnexpectedStatusWordException);
+    ASSERT_EQ(ring->getRecordCount(), 2u);
+
+    ReplayProxyReader replay(*ring);
+    auto cardResponse
+        = replay.transmitCardRequest(*createCardRequest({SELECT, READ}), ChannelControl::KEEP_OPEN);
+    ASSERT_EQ(cardResponse->getApduResponses()[1]->getApdu(), RECORD);
+    ASSERT_TRUE(cardResponse->isLogicalChannelOpen());
+    try {
+        replay.transmitCardRequest(*createCardRequest({UNKNOWN}), ChannelControl::CLOSE_AFTER);
+        FAIL();
+    } catch (UnexpectedStatusWordException& e) {
+        ASSERT_EQ(e.getCardResponse()->getApduResponses()[0]->getStatusWord(), 0x6D00);
+        ASSERT_FALSE(e.getCardResponse()->isLogicalChannelOpen());
+    }
+}
+
+TEST(CardTraceTest, record_whenLargerThanRing_shouldCountDroppedRecord) {
+    std::vector<uint8_t> block(80 + 16);
+    auto ring = std::make_shared<CardTraceRing>(block.data(), block.size());
+    RecordingProxyReader recorder(std::make_shared<SimulatedProxyReader>(createCard()), ring);
+
+    auto cardResponse
+        = recorder.transmitCardRequest(createCardRequest({SELECT}), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(cardResponse->getApduResponses()[0]->getApdu(), FCI);
+    ASSERT_EQ(ring->getRecordCount(), 0u);
+    ASSERT_EQ(recorder.getDroppedRecordCount(), 1u);
+}
+
+TEST(CardTraceTest, recorder_whenReaderOrRingIsNull_shouldThrowInvalidArgument) {
+    std::vector<uint8_t> block(4096);
+    auto ring = std::make_shared<CardTraceRing>(block.data(), block.size());
+
+    ASSERT_THROW(RecordingProxyReader(nullptr, ring), std::invalid_argument);
+    ASSERT_THROW(
+        RecordingProxyReader(std::make_shared<SimulatedProxyReader>(createCard()), nullptr),
+        std::invalid_argument);
+}
+
+TEST(CardTraceTest, replay_shouldKeepSuccessOfRecordedResponses) {
+    std::vector<uint8_t> block(4096);
+    auto ring = std::make_shared<CardTraceRing>(block.data(), block.size());
+    RecordingProxyReader recorder(std::make_shared<SimulatedProxyReader>(createCard()), ring);
+    auto cardRequest = createCardRequest({SELECT, UNKNOWN});
+    std::static_pointer_cast<ApduRequestAdapter>(cardRequest->getApduRequests()[1])
+        ->addSuccessfulStatusWord(0x6D00);
+
+    recorder.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ReplayProxyReader replay(*ring);
+    auto cardResponse = replay.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+    ASSERT_EQ(cardResponse->getApduResponses()[1]->getStatusWord(), 0x6D00);
+    ASSERT_TRUE(cardResponse->getSummary().isAllSuccessful());
+}
+
+TEST(CardTraceTest, replay_withChainedRequest_shouldKeepSummaryAndIndexesOfReader) {
+    const std::vector<uint8_t> getResponse = {0x00, 0xC0};
+    const std::vector<uint8_t> moreData = {0x61, 0x02};
+    auto card = std::make_shared<SimulatedCard>();
+    card->addResponse(ByteSpan(SELECT).first(4), ByteSpan(FCI))
+        .addResponse(ByteSpan(READ).first(2), ByteSpan(moreData))
+        .addResponse(ByteSpan(getResponse), ByteSpan(RECORD));
+    std::vector<uint8_t> block(4096);
+    auto ring = std::make_shared<CardTraceRing>(block.data(), block.size());
+    RecordingProxyReader recorder(std::make_shared<SimulatedProxyReader>(card), ring);
+    auto cardRequest = createCardRequest({SELECT, READ});
+    cardRequest->setApduChaining(std::make_shared<Iso7816ApduChaining>());
+    auto observer = std::make_shared<IndexObserver>();
+    cardRequest->setApduResponseObserver(observer);
+
+    auto recordedResponse = recorder.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+    const std::vector<std::size_t> recordedIndexes = observer->indexes;
+    observer->indexes.clear();
+
+    ReplayProxyReader replay(*ring);
+    auto replayedResponse = replay.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+    ASSERT_EQ(replayedResponse->getApduResponses().size(), 3u);
+    ASSERT_EQ(recordedIndexes, std::vector<std::size_t>({0, 1, 1}));
+    ASSERT_EQ(observer->indexes, recordedIndexes);
+    ASSERT_EQ(replayedResponse->getApduRequestIndex(2), 1u);
+    ASSERT_TRUE(recordedResponse->getSummary().isAllSuccessful());
+    ASSERT_TRUE(replayedResponse->getSummary().isAllSuccessful());
+    ASSERT_TRUE(replayedResponse->isApduResponseSuccessful(1));
+}
+
+TEST(CardTraceTest, record_withSegmentedCommand_shouldStoreHeaderAndData) {
+    std::vector<uint8_t> block(256 * 1024);
+    auto ring = std::make_shared<CardTraceRing>(block.data(), block.size());
+    RecordingProxyReader recorder(std::make_shared<SimulatedProxyReader>(createCard()), ring);
+    /* Too long for a single APDU */
+    const std::vector<uint8_t> data(70000, 0x5A);
+    ApduCommand command(0x00, 0xD6, 0x00, 0x00);
+    command.addData(ByteSpan(data).first(1000)).addData(ByteSpan(data).last(data.size() - 1000));
+    auto cardRequest = std::make_shared<CardRequestAdapter>(false);
+    cardRequest->addApduRequest(std::make_shared<SegmentedApduRequest>(command));
+
+    recorder.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ReplayProxyReader replay(*ring);
+    replay.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+    ring->forEachRecord([&data](const ByteSpan record) {
+        const CardTraceEntry entry = CardTraceEntry::decode(record);
+        ASSERT_EQ(entry.apduRequests[0].size(), 4u + data.size());
+        ASSERT_EQ(entry.apduRequests[0][1], 0xD6);
+        ASSERT_EQ(entry.apduRequests[0].back(), 0x5A);
+    });
+}
@@ -0,0 +1,111 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/HexFormat.hpp"
+#include "keypop/card/StatusWordFormat.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ApduResponseApi;
+using keypop::card::ByteSpan;
+using keypop::card::HexFormat;
+using keypop::card::StatusWordFormat;
+using keypop::card::StatusWordSet;
+using keypop::card::spi::ApduRequestAdapter;
+
+TEST(HexFormatTest, write_shouldRenderUppercaseHex) {
+    const std::vector<uint8_t> bytes = {0x00, 0xA4, 0x04, 0x0F};
+    std::ostringstream os;
+
+    os << HexFormat(ByteSpan(bytes)) << "|" << HexFormat(ByteSpan());
+
+    ASSERT_EQ(os.str(), "00A4040F|");
+}
+
+TEST(HexFormatTest, write_whenLongerThanMaxLength_shouldTruncate) {
+    const std::vector<uint8_t> bytes(300, 0xAB);
+    std::ostringstream os;
+
+    os << HexFormat(ByteSpan(bytes), 2);
+
+    ASSERT_EQ(os.str(), "ABAB...(300)");
+}
+
+TEST(HexFormatTest, write_whenLongerThanInternalBuffer_shouldRenderAllBytes) {
+    const std::vector<uint8_t> bytes(200, 0x5A);
+    std::ostringstream os;
+
+    os << HexFormat(ByteSpan(bytes), bytes.size());
+
+    std::string expected;
+    for (std::size_t i = 0; i < bytes.size(); i++) {
+        expected += "5A";
+    }
+    ASSERT_EQ(os.str(), expected);
+}
+
+TEST(HexFormatTest, apduResponseOperator_shouldUseHexFormat) {
+    const std::vector<uint8_t> apdu = {0x12, 0x34, 0x90, 0x00};
+    const std::shared_ptr<ApduResponseApi> response
+        = std::make_shared<ApduResponseAdapter>(ByteSpan(apdu));
+    std::ostringstream os;
+
+    os << response << ", " << std::shared_ptr<ApduResponseApi>();
+
+    ASSERT_EQ(
+        os.str(),
+        "APDU_RESPONSE_API: {APDU = 12349000, DATA_OUT = 1234, STATUS_WORD = 9000}, "
+        "APDU_RESPONSE_API: null");
+}
+
+TEST(HexFormatTest, statusWordFormat_shouldRenderListInOrder) {
+    const std::vector<int> statusWords = {0x9000, 0x6283, 0x6A82};
+    std::ostringstream os;
+
+    os << StatusWordFormat(statusWords) << "|" << StatusWordFormat(std::vector<int>());
+
+    ASSERT_EQ(os.str(), "{9000, 6283, 6A82}|{}");
+}
+
+TEST(HexFormatTest, statusWordFormat_shouldCollapseWholeSw1Classes) {
+    const std::shared_ptr<const StatusWordSet> statusWordSet
+        = StatusWordSet::Builder().addSw1(0x61).add(0x6283).add(0x9000).build();
+    std::ostringstream os;
+
+    os << StatusWordFormat(statusWordSet->getStatusWords());
+
+    ASSERT_EQ(os.str(), "{61xx, 6283, 9000}");
+}
+
+TEST(HexFormatTest, apduRequestOperator_shouldRenderStatusWordsInHex) {
+    const std::vector<uint8_t> apdu = {0x00, 0xB2, 0x01, 0x04};
+    ApduRequestAdapter request((ByteSpan(apdu)));
+    request.addSuccessfulStatusWord(0x6283).setInfo("Read Record");
+    std::ostringstream os;
+
+    os << request;
+
+    ASSERT_EQ(
+        os.str(),
+        "APDU_REQUEST_SPI: {APDU: 00B20104, SUCCESSFUL_STATUS_WORDS: {6283, 9000}, "
+        "INFO: Read Record}");
+}
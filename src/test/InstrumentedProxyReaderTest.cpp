@@ -0,0 +1,228 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/InstrumentedProxyReader.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+#include "keypop/card/spi/Iso7816ApduChaining.hpp"
+#include "keypop/card/spi/SegmentedApduRequest.hpp"
+#include "keypop/card/spi/TransmissionHistograms.hpp"
+
+#include "CardTestFixture.hpp"
+
+using keypop::card::CardTransmitResult;
+using keypop::card::ByteSpan;
+using keypop::card::ChannelControl;
+using keypop::card::InstrumentedProxyReader;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::UnexpectedStatusWordException;
+using keypop::card::spi::ApduCommand;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::CardRequestAdapter;
+using keypop::card::spi::Iso7816ApduChaining;
+using keypop::card::spi::SegmentedApduRequest;
+using keypop::card::spi::TransmissionHistograms;
+using keypop::card::spi::TransmissionInstrumentationSpi;
+
+class RecordingInstrumentation final : public TransmissionInstrumentationSpi {
+public:
+    void
+    onApduExchanged(const ApduRecord& record) override {
+        infos.push_back(record.info);
+        statusWords.push_back(record.statusWord);
+    }
+
+    void
+    onCardRequestTransmitted(const CardRequestRecord& record) override {
+        cardRequests.push_back(record);
+    }
+
+    std::vector<std::string> infos;
+    std::vector<int> statusWords;
+    std::vector<CardRequestRecord> cardRequests;
+};
+
+static std::shared_ptr<SimulatedProxyReader>
+createReader() {
+    return std::make_shared<SimulatedProxyReader>(createCard());
+}
+
+TEST(InstrumentedProxyReaderTest, transmitCardRequest_shouldReportApdusAndCardRequest) {
+    auto instrumentation = std::make_shared<RecordingInstrumentation>();
+    InstrumentedProxyReader reader(createReader(), instrumentation);
+
+    reader.transmitCardRequest(createCardRequest({SELECT, READ}), ChannelControl::CLOSE_AFTER);
+
+    ASSERT_EQ(instrumentation->infos, std::vector<std::string>({"Select", "Read"}));
+    ASSERT_EQ(instrumentation->statusWords, std::vector<int>({0x9000, 0x9000}));
+    ASSERT_EQ(instrumentation->cardRequests.size(), 1u);
+    const TransmissionInstrumentationSpi::CardRequestRecord& record
+        = instrumentation->cardRequests[0];
+    ASSERT_EQ(record.channelControl, ChannelControl::CLOSE_AFTER);
+    ASSERT_EQ(record.apduCount, 2u);
+    ASSERT_EQ(record.apduResponseCount, 2u);
+    ASSERT_EQ(record.commandLength, SELECT.size() + READ.size());
+    ASSERT_EQ(record.responseLength, 8u);
+    ASSERT_EQ(record.exceptionType, nullptr);
+}
+
+TEST(InstrumentedProxyReaderTest, transmitCardRequest_withApduSequence_shouldNotUseApduRequests) {
+    auto instrumentation = std::make_shared<RecordingInstrumentation>();
+    InstrumentedProxyReader reader(createReader(), instrumentation);
+    auto cardRequest = std::make_shared<SequenceCardRequest>();
+    cardRequest->arena.addApdu(ByteSpan(SELECT), nullptr, "Select")
+        .addApdu(ByteSpan(READ), nullptr, "Read");
+
+    reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+    reader.transmitCardRequest(*cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(cardRequest->legacyCallCount, 0);
+    ASSERT_EQ(
+        instrumentation->infos, std::vector<std::string>({"Select", "Read", "Select", "Read"}));
+    ASSERT_EQ(instrumentation->cardRequests.size(), 2u);
+    ASSERT_EQ(instrumentation->cardRequests[1].apduCount, 2u);
+    ASSERT_EQ(instrumentation->cardRequests[1].commandLength, SELECT.size() + READ.size());
+}
+
+TEST(InstrumentedProxyReaderTest, transmitCardRequest_whenFailing_shouldReportExceptionType) {
+    auto instrumentation = std::make_shared<RecordingInstrumentation>();
+    InstrumentedProxyReader reader(createReader(), instrumentation);
+
+    ASSERT_THROW(
+        reader.transmitCardRequest(createCardRequest({SELECT, UNKNOWN}), ChannelControl::KEEP_OPEN),
+        UnexpectedStatusWordException);
+    const CardTransmitResult result = reader.tryTransmitCardRequest(
+        createCardRequest({UNKNOWN}), ChannelControl::KEEP_OPEN);
+
+    ASSERT_FALSE(result.isSuccessful());
+    ASSERT_EQ(instrumentation->statusWords, std::vector<int>({0x9000, 0x6D00, 0x6D00}));
+    ASSERT_EQ(instrumentation->cardRequests.size(), 2u);
+    ASSERT_EQ(instrumentation->cardRequests[0].apduResponseCount, 2u);
+    for (const auto& record : instrumentation->cardRequests) {
+        ASSERT_EQ(*record.exceptionType, typeid(UnexpectedStatusWordException));
+    }
+}
+
+TEST(InstrumentedProxyReaderTest, disabled_shouldNotReport) {
+    auto instrumentation = std::make_shared<RecordingInstrumentation>();
+    InstrumentedProxyReader reader(createReader(), instrumentation);
+    reader.setEnabled(false);
+
+    reader.transmitCardRequest(createCardRequest({SELECT}), ChannelControl::KEEP_OPEN);
+
+    ASSERT_TRUE(instrumentation->cardRequests.empty());
+    ASSERT_FALSE(InstrumentedProxyReader(createReader(), nullptr).setEnabled(true).isEnabled());
+}
+
+TEST(InstrumentedProxyReaderTest, histograms_shouldAggregateAllThreadsPerInfo) {
+    auto histograms = std::make_shared<TransmissionHistograms>();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&histograms]() {
+            InstrumentedProxyReader reader(createReader(), histograms);
+            for (int j = 0; j < 10; j++) {
+                reader.transmitCardRequest(
+                    createCardRequest({SELECT, READ, READ}), ChannelControl::KEEP_OPEN);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const std::vector<TransmissionHistograms::Snapshot> apdus = histograms->scrapeApdus();
+    ASSERT_EQ(apdus.size(), 2u);
+    ASSERT_EQ(apdus[0].key, "Read");
+    ASSERT_EQ(apdus[0].count, 80u);
+    ASSERT_EQ(apdus[0].successCount, 80u);
+    ASSERT_EQ(apdus[0].commandLength, 80u * READ.size());
+    ASSERT_EQ(apdus[1].key, "Select");
+    ASSERT_EQ(apdus[1].count, 40u);
+    uint64_t bucketTotal = 0;
+    for (const uint64_t bucket : apdus[1].buckets) {
+        bucketTotal += bucket;
+    }
+    ASSERT_EQ(bucketTotal, 40u);
+    ASSERT_EQ(histograms->scrapeCardRequests().count, 40u);
+}
+
+TEST(InstrumentedProxyReaderTest, histograms_shouldCountSuccessWithStatusWordsOfRequest) {
+    auto histograms = std::make_shared<TransmissionHistograms>();
+    InstrumentedProxyReader reader(createReader(), histograms);
+    auto cardRequest = createCardRequest({UNKNOWN});
+    std::static_pointer_cast<ApduRequestAdapter>(cardRequest->getApduRequests()[0])
+        ->addSuccessfulStatusWord(0x6D00);
+
+    reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+    reader.tryTransmitCardRequest(createCardRequest({UNKNOWN}), ChannelControl::KEEP_OPEN);
+
+    const std::vector<TransmissionHistograms::Snapshot> apdus = histograms->scrapeApdus();
+    ASSERT_EQ(apdus.size(), 1u);
+    ASSERT_EQ(apdus[0].count, 2u);
+    ASSERT_EQ(apdus[0].successCount, 1u);
+}
+
+TEST(InstrumentedProxyReaderTest, histograms_shouldCountChainedResponsesAsReaderDoes) {
+    const std::vector<uint8_t> getResponse = {0x00, 0xC0};
+    const std::vector<uint8_t> moreData = {0x61, 0x02};
+    auto card = std::make_shared<SimulatedCard>();
+    card->addResponse(ByteSpan(READ).first(2), ByteSpan(moreData))
+        .addResponse(ByteSpan(getResponse), ByteSpan(RECORD));
+    auto histograms = std::make_shared<TransmissionHistograms>();
+    InstrumentedProxyReader reader(std::make_shared<SimulatedProxyReader>(card), histograms);
+    auto cardRequest = createCardRequest({READ});
+    cardRequest->setApduChaining(std::make_shared<Iso7816ApduChaining>());
+
+    reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    const std::vector<TransmissionHistograms::Snapshot> apdus = histograms->scrapeApdus();
+    ASSERT_EQ(apdus.size(), 1u);
+    ASSERT_EQ(apdus[0].key, "Read");
+    ASSERT_EQ(apdus[0].count, 2u);
+    ASSERT_EQ(apdus[0].successCount, 2u);
+}
+
+TEST(InstrumentedProxyReaderTest, transmitCardRequest_withSegmentedCommand_shouldReportDataLength) {
+    auto histograms = std::make_shared<TransmissionHistograms>();
+    InstrumentedProxyReader reader(createReader(), histograms);
+    /* Too long for a single APDU */
+    const std::vector<uint8_t> data(70000, 0x5A);
+    ApduCommand command(0x00, 0xD6, 0x00, 0x00);
+    command.addData(ByteSpan(data));
+    auto cardRequest = std::make_shared<CardRequestAdapter>(false);
+    cardRequest->addApduRequest(std::make_shared<SegmentedApduRequest>(command));
+
+    reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(histograms->scrapeApdus()[0].commandLength, 4u + data.size());
+}
+
+TEST(InstrumentedProxyReaderTest, getBucketIndex_shouldBeLog2OfNanoseconds) {
+    ASSERT_EQ(TransmissionHistograms::getBucketIndex(std::chrono::nanoseconds(0)), 0u);
+    ASSERT_EQ(TransmissionHistograms::getBucketIndex(std::chrono::nanoseconds(1)), 0u);
+    ASSERT_EQ(TransmissionHistograms::getBucketIndex(std::chrono::nanoseconds(1023)), 9u);
+    ASSERT_EQ(TransmissionHistograms::getBucketIndex(std::chrono::nanoseconds(1024)), 10u);
+    ASSERT_EQ(TransmissionHistograms::getBucketIndex(std::chrono::hours(1)), 31u);
+}
@@ -0,0 +1,91 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/Iso7816ApduChaining.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ByteSpan;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::ApduRequestSpi;
+using keypop::card::spi::Iso7816ApduChaining;
+
+static std::shared_ptr<ApduRequestSpi>
+request(const std::vector<uint8_t>& apdu) {
+    return std::make_shared<ApduRequestAdapter>(ByteSpan(apdu));
+}
+
+static std::shared_ptr<ApduResponseAdapter>
+response(const std::vector<uint8_t>& apdu) {
+    return std::make_shared<ApduResponseAdapter>(ByteSpan(apdu));
+}
+
+TEST(Iso7816ApduChainingTest, successfulResponse_shouldEndChain) {
+    Iso7816ApduChaining chaining;
+
+    auto next = chaining.getNextApduRequest(
+        request({0x00, 0xB2, 0x01, 0x04, 0x00}), response({0x90, 0x00}));
+
+    ASSERT_EQ(next, nullptr);
+}
+
+TEST(Iso7816ApduChainingTest, sw61xx_shouldGenerateGetResponseWithSameCla) {
+    Iso7816ApduChaining chaining;
+    auto previous = request({0x94, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54});
+
+    auto next = chaining.getNextApduRequest(previous, response({0x61, 0x1F}));
+
+    ASSERT_NE(next, nullptr);
+    ASSERT_EQ(next->getApduView().toVector(), std::vector<uint8_t>({0x94, 0xC0, 0x00, 0x00, 0x1F}));
+    ASSERT_EQ(next->getSuccessfulStatusWordSet(), previous->getSuccessfulStatusWordSet());
+}
+
+TEST(Iso7816ApduChainingTest, sw6Cxx_onCase2_shouldReplaceLe) {
+    Iso7816ApduChaining chaining;
+
+    auto next = chaining.getNextApduRequest(
+        request({0x00, 0xB2, 0x01, 0x04, 0x00}), response({0x6C, 0x1D}));
+
+    ASSERT_EQ(next->getApduView().toVector(), std::vector<uint8_t>({0x00, 0xB2, 0x01, 0x04, 0x1D}));
+}
+
+TEST(Iso7816ApduChainingTest, sw6Cxx_onCase3_shouldAppendLe) {
+    Iso7816ApduChaining chaining;
+
+    auto next = chaining.getNextApduRequest(
+        request({0x00, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54}), response({0x6C, 0x20}));
+
+    ASSERT_EQ(
+        next->getApduView().toVector(),
+        std::vector<uint8_t>({0x00, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54, 0x20}));
+}
+
+TEST(Iso7816ApduChainingTest, chainLength_shouldBeBounded) {
+    Iso7816ApduChaining chaining(2);
+    auto moreData = response({0x61, 0x10});
+
+    auto first = chaining.getNextApduRequest(request({0x00, 0xB2, 0x01, 0x04, 0x00}), moreData);
+    auto second = chaining.getNextApduRequest(first, moreData);
+    auto third = chaining.getNextApduRequest(second, moreData);
+
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_EQ(third, nullptr);
+    ASSERT_NE(
+        chaining.getNextApduRequest(request({0x00, 0xB2, 0x02, 0x04, 0x00}), moreData), nullptr);
+}
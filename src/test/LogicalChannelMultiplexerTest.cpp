@@ -0,0 +1,297 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/LogicalChannelMultiplexer.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/spi/ApduRequestAdapter.hpp"
+#include "keypop/card/spi/CardRequestAdapter.hpp"
+#include "keypop/card/spi/Iso7816ApduChaining.hpp"
+
+#include "CardTestFixture.hpp"
+
+using keypop::card::ApduResponseBuffer;
+using keypop::card::ByteSpan;
+using keypop::card::CardResponseApi;
+using keypop::card::ChannelControl;
+using keypop::card::LogicalChannelMultiplexer;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::UnexpectedStatusWordException;
+using keypop::card::spi::ApduRequestAdapter;
+using keypop::card::spi::CardRequestAdapter;
+using keypop::card::spi::Iso7816ApduChaining;
+
+/**
+ * Card assigning the logical channels from a first number, and answering the other commands with
+ * the channel decoded from the class byte and the INS byte (6D00h for INS EEh).
+ */
+struct MultiChannelCard {
+    explicit MultiChannelCard(const int firstChannelNumber)
+    : card(std::make_shared<SimulatedCard>())
+    , nextChannelNumber(firstChannelNumber)
+    , isOpen(0x100, false) {
+        isOpen[0] = true;
+        card->addHandler(ByteSpan(), [this](const ByteSpan command, ApduResponseBuffer& response) {
+            process(command, response);
+        });
+    }
+
+    void
+    process(const ByteSpan command, ApduResponseBuffer& response) {
+        const int channelNumber
+            = (command[0] & 0x40) != 0 ? (command[0] & 0x0F) + 4 : command[0] & 0x03;
+        classBytes.push_back(command[0]);
+        if (!isOpen[channelNumber]) {
+            response.push_back(0x68);
+            response.push_back(0x81);
+            return;
+        }
+        if (command[1] == 0x70 && command[2] == 0x00) {
+            isOpen[nextChannelNumber] = true;
+            response.push_back(static_cast<uint8_t>(nextChannelNumber++));
+        } else if (command[1] == 0x70 && command[2] == 0x80) {
+            isOpen[command[3]] = false;
+        } else if (command[1] == 0xEE) {
+            response.push_back(0x6D);
+            response.push_back(0x00);
+            return;
+        } else if (command[1] == 0xB0) {
+            /* Data available with GET RESPONSE */
+            response.push_back(0x61);
+            response.push_back(0x02);
+            return;
+        } else {
+            response.push_back(static_cast<uint8_t>(channelNumber));
+            response.push_back(command[1]);
+        }
+        response.push_back(0x90);
+        response.push_back(0x00);
+    }
+
+    std::shared_ptr<SimulatedCard> card;
+    int nextChannelNumber;
+    std::vector<bool> isOpen;
+    std::vector<uint8_t> classBytes;
+};
+
+static std::shared_ptr<CardRequestAdapter>
+createCardRequest(const uint8_t ins) {
+    const uint8_t apdu[] = {0x00, ins, 0x00, 0x00, 0x00};
+    auto cardRequest = std::make_shared<CardRequestAdapter>(true);
+    cardRequest->addApduRequest(std::make_shared<ApduRequestAdapter>(ByteSpan(apdu, sizeof(apdu))));
+
+    return cardRequest;
+}
+
+TEST(LogicalChannelMultiplexerTest, encodeClassByte_shouldApplyIso7816Classes) {
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x00, 0), 0x00);
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x00, 3), 0x03);
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x00, 4), 0x40);
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x00, 19), 0x4F);
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x10, 5), 0x51);
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x08, 4), 0x60);
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x6F, 2), 0x0A);
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x04, 3), 0x07);
+    ASSERT_EQ(LogicalChannelMultiplexer::encodeClassByte(0x94, 0), 0x94);
+    ASSERT_THROW(LogicalChannelMultiplexer::encodeClassByte(0x94, 1), std::invalid_argument);
+    ASSERT_THROW(LogicalChannelMultiplexer::encodeClassByte(0x04, 4), std::invalid_argument);
+    ASSERT_THROW(LogicalChannelMultiplexer::encodeClassByte(0x0C, 4), std::invalid_argument);
+    ASSERT_THROW(LogicalChannelMultiplexer::encodeClassByte(0x00, 20), std::invalid_argument);
+}
+
+TEST(LogicalChannelMultiplexerTest, openChannel_shouldAddressChannelAssignedByCard) {
+    MultiChannelCard card(4);
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+
+    const auto channel = multiplexer.openChannel();
+    auto cardResponse
+        = channel->transmitCardRequest(createCardRequest(0xCA), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(channel->getChannelNumber(), 4);
+    ASSERT_EQ(multiplexer.getOpenChannelCount(), 1u);
+    ASSERT_EQ(card.classBytes, std::vector<uint8_t>({0x00, 0x40}));
+    ASSERT_EQ(
+        cardResponse->getApduResponses()[0]->getApdu(),
+        std::vector<uint8_t>({0x04, 0xCA, 0x90, 0x00}));
+    ASSERT_TRUE(cardResponse->isLogicalChannelOpen());
+}
+
+TEST(LogicalChannelMultiplexerTest, closeAfter_shouldCloseLogicalChannelOnly) {
+    MultiChannelCard card(1);
+    auto reader = std::make_shared<SimulatedProxyReader>(card.card);
+    LogicalChannelMultiplexer multiplexer(reader);
+    const auto channel1 = multiplexer.openChannel();
+    const auto channel2 = multiplexer.openChannel();
+
+    auto cardResponse
+        = channel1->transmitCardRequest(createCardRequest(0xCA), ChannelControl::CLOSE_AFTER);
+
+    ASSERT_FALSE(cardResponse->isLogicalChannelOpen());
+    ASSERT_FALSE(channel1->isOpen());
+    ASSERT_FALSE(card.isOpen[1]);
+    ASSERT_EQ(multiplexer.getOpenChannelCount(), 1u);
+    ASSERT_THROW(
+        channel1->transmitCardRequest(createCardRequest(0xCA), ChannelControl::KEEP_OPEN),
+        std::logic_error);
+    ASSERT_TRUE(
+        channel2->transmitCardRequest(createCardRequest(0xCA), ChannelControl::KEEP_OPEN)
+            ->isLogicalChannelOpen());
+    ASSERT_TRUE(reader->isCardPresent());
+}
+
+TEST(LogicalChannelMultiplexerTest, transmitCardRequestByReference_shouldAddressChannel) {
+    MultiChannelCard card(5);
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+    const auto channel = multiplexer.openChannel();
+    const auto cardRequest = createCardRequest(0xCA);
+
+    std::unique_ptr<CardResponseApi> cardResponse
+        = channel->transmitCardRequest(*cardRequest, ChannelControl::CLOSE_AFTER);
+
+    ASSERT_EQ(card.classBytes, std::vector<uint8_t>({0x00, 0x41, 0x00}));
+    ASSERT_EQ(
+        cardResponse->getApduResponses()[0]->getApdu(),
+        std::vector<uint8_t>({0x05, 0xCA, 0x90, 0x00}));
+    ASSERT_FALSE(cardResponse->isLogicalChannelOpen());
+    ASSERT_FALSE(channel->isOpen());
+    ASSERT_EQ(cardRequest.use_count(), 1);
+}
+
+TEST(LogicalChannelMultiplexerTest, transmitCardRequest_withApduSequence_shouldKeepBulkAccess) {
+    MultiChannelCard card(6);
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+    const auto channel = multiplexer.openChannel();
+    const uint8_t getData[] = {0x00, 0xCA, 0x00, 0x00, 0x00};
+    const uint8_t readRecord[] = {0x08, 0xB2, 0x01, 0x04, 0x00};
+    auto cardRequest = std::make_shared<SequenceCardRequest>();
+    cardRequest->arena.addApdu(ByteSpan(getData, sizeof(getData)))
+        .addApdu(ByteSpan(readRecord, sizeof(readRecord)));
+
+    auto cardResponse = channel->transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(cardRequest->legacyCallCount, 0);
+    ASSERT_EQ(card.classBytes, std::vector<uint8_t>({0x00, 0x42, 0x62}));
+    ASSERT_EQ(cardResponse->getApduResponses().size(), 2u);
+    ASSERT_EQ(
+        cardResponse->getApduResponses()[1]->getApdu(),
+        std::vector<uint8_t>({0x06, 0xB2, 0x90, 0x00}));
+    ASSERT_EQ(cardRequest->arena.getApduSequence().getApdu(1)[0], 0x08);
+}
+
+TEST(LogicalChannelMultiplexerTest, openChannel_whenRefused_shouldThrowUnexpectedStatusWord) {
+    MultiChannelCard card(1);
+    card.isOpen[0] = false;
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+
+    ASSERT_THROW(multiplexer.openChannel(), UnexpectedStatusWordException);
+    ASSERT_EQ(multiplexer.getOpenChannelCount(), 0u);
+}
+
+TEST(LogicalChannelMultiplexerTest, closeAfter_whenStatusWordIsUnexpected_shouldCloseChannel) {
+    MultiChannelCard card(1);
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+    const auto channel = multiplexer.openChannel();
+
+    ASSERT_THROW(
+        channel->transmitCardRequest(createCardRequest(0xEE), ChannelControl::CLOSE_AFTER),
+        UnexpectedStatusWordException);
+
+    ASSERT_FALSE(channel->isOpen());
+    ASSERT_FALSE(card.isOpen[1]);
+    ASSERT_EQ(multiplexer.getOpenChannelCount(), 0u);
+}
+
+TEST(LogicalChannelMultiplexerTest, openChannel_whenNumberIsAlreadyOpen_shouldCloseIt) {
+    MultiChannelCard card(1);
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+    const auto channel = multiplexer.openChannel();
+    /* The card lost the channel and reassigns its number */
+    card.isOpen[1] = false;
+    card.nextChannelNumber = 1;
+
+    ASSERT_THROW(multiplexer.openChannel(), std::runtime_error);
+
+    ASSERT_FALSE(card.isOpen[1]);
+    ASSERT_FALSE(channel->isOpen());
+    ASSERT_EQ(multiplexer.getOpenChannelCount(), 0u);
+}
+
+TEST(LogicalChannelMultiplexerTest, openChannel_whenNumberIsOutOfRange_shouldCloseIt) {
+    MultiChannelCard card(LogicalChannelMultiplexer::MAX_CHANNEL_NUMBER + 1);
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+
+    ASSERT_THROW(multiplexer.openChannel(), std::runtime_error);
+
+    ASSERT_FALSE(card.isOpen[LogicalChannelMultiplexer::MAX_CHANNEL_NUMBER + 1]);
+    ASSERT_EQ(card.classBytes, std::vector<uint8_t>({0x00, 0x00}));
+    ASSERT_EQ(multiplexer.getOpenChannelCount(), 0u);
+}
+
+TEST(LogicalChannelMultiplexerTest, chaining_shouldGenerateRequestsOnLogicalChannel) {
+    MultiChannelCard card(2);
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+    const auto channel = multiplexer.openChannel();
+    auto cardRequest = createCardRequest(0xB0);
+    cardRequest->setApduChaining(std::make_shared<Iso7816ApduChaining>());
+
+    auto cardResponse = channel->transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(cardResponse->getApduResponses().size(), 2u);
+    ASSERT_EQ(
+        cardResponse->getApduResponses()[1]->getApdu(),
+        std::vector<uint8_t>({0x02, 0xC0, 0x90, 0x00}));
+}
+
+TEST(LogicalChannelMultiplexerTest, channels_shouldBeUsableFromConcurrentThreads) {
+    MultiChannelCard card(3);
+    LogicalChannelMultiplexer multiplexer(std::make_shared<SimulatedProxyReader>(card.card));
+    std::vector<std::shared_ptr<LogicalChannelMultiplexer::Channel>> channels;
+    for (int i = 0; i < 3; i++) {
+        channels.push_back(multiplexer.openChannel());
+    }
+    std::vector<int> errorCounts(channels.size(), 0);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < channels.size(); i++) {
+        threads.emplace_back([&channels, &errorCounts, i]() {
+            for (int j = 0; j < 200; j++) {
+                const std::shared_ptr<CardResponseApi> cardResponse
+                    = channels[i]->transmitCardRequest(
+                        createCardRequest(0xCA), ChannelControl::KEEP_OPEN);
+                if (cardResponse->getApduResponses()[0]->getApdu()[0]
+                    != channels[i]->getChannelNumber()) {
+                    errorCounts[i]++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(channels[0]->getChannelNumber(), 3);
+    ASSERT_EQ(channels[2]->getChannelNumber(), 5);
+    ASSERT_EQ(errorCounts, std::vector<int>(channels.size(), 0));
+    ASSERT_EQ(card.classBytes.size(), 3u + 3 * 200);
+
+    multiplexer.releaseChannels();
+
+    ASSERT_EQ(multiplexer.getOpenChannelCount(), 0u);
+    ASSERT_FALSE(card.isOpen[3] || card.isOpen[4] || card.isOpen[5]);
+}
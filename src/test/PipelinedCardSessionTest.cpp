@@ -0,0 +1,197 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/PipelinedCardSession.hpp"
+#include "keypop/card/SimulatedProxyReader.hpp"
+
+#include "CardTestFixture.hpp"
+
+using keypop::card::ApduResponseBuffer;
+using keypop::card::ByteSpan;
+using keypop::card::CardRequestAbortedException;
+using keypop::card::CardResponseApi;
+using keypop::card::ChannelControl;
+using keypop::card::PipelinedCardSession;
+using keypop::card::ProxyReaderApi;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::UnexpectedStatusWordException;
+using keypop::card::spi::CardRequestSpi;
+
+/* Card answering READ only, blocked on its first command until the gate is opened */
+static std::shared_ptr<SimulatedCard>
+createGatedCard(const std::shared_future<void>& gate) {
+    auto card = std::make_shared<SimulatedCard>();
+    card->addHandler(ByteSpan(), [gate](const ByteSpan command, ApduResponseBuffer& response) {
+        gate.wait();
+        if (command[1] == READ[1]) {
+            response.append(ByteSpan(RECORD));
+        } else {
+            response.push_back(0x6D);
+            response.push_back(0x00);
+        }
+    });
+
+    return card;
+}
+
+/* Reader counting the releases of the channel */
+class ReleaseCountingReader final : public ProxyReaderApi {
+public:
+    using ProxyReaderApi::transmitCardRequest;
+
+    explicit ReleaseCountingReader(const std::shared_ptr<ProxyReaderApi>& reader)
+    : releaseCount(0)
+    , mReader(reader) {
+    }
+
+    const std::shared_ptr<CardResponseApi>
+    transmitCardRequest(
+        const std::shared_ptr<CardRequestSpi> cardRequest,
+        const ChannelControl channelControl) override {
+        return mReader->transmitCardRequest(cardRequest, channelControl);
+    }
+
+    void
+    releaseChannel() override {
+        releaseCount++;
+        mReader->releaseChannel();
+    }
+
+    int releaseCount;
+
+private:
+    const std::shared_ptr<ProxyReaderApi> mReader;
+};
+
+TEST(PipelinedCardSessionTest, enqueue_shouldTransmitInOrder) {
+    std::promise<void> gate;
+    auto reader = std::make_shared<SimulatedProxyReader>(createGatedCard(gate.get_future()));
+    PipelinedCardSession session(reader);
+
+    std::vector<std::future<std::shared_ptr<CardResponseApi>>> futures;
+    for (int i = 0; i < 5; i++) {
+        futures.push_back(session.enqueue(createCardRequest({READ}), ChannelControl::KEEP_OPEN));
+    }
+    ASSERT_GE(session.getPendingCount(), 4u);
+    gate.set_value();
+
+    for (auto& future : futures) {
+        ASSERT_EQ(future.get()->getApduResponses()[0]->getApdu(), RECORD);
+    }
+    ASSERT_EQ(reader->getExchangedApduCount(), 5u);
+    ASSERT_FALSE(session.isAborted());
+}
+
+TEST(PipelinedCardSessionTest, failure_shouldAbortFollowingRequestsUntilResume) {
+    std::promise<void> gate;
+    auto reader = std::make_shared<SimulatedProxyReader>(createGatedCard(gate.get_future()));
+    PipelinedCardSession session(reader);
+
+    auto first = session.enqueue(createCardRequest({READ}), ChannelControl::KEEP_OPEN);
+    auto failing = session.enqueue(createCardRequest({UNKNOWN}), ChannelControl::KEEP_OPEN);
+    auto third = session.enqueue(createCardRequest({READ}), ChannelControl::KEEP_OPEN);
+    auto fourth = session.enqueue(createCardRequest({READ}), ChannelControl::CLOSE_AFTER);
+    gate.set_value();
+
+    ASSERT_EQ(first.get()->getApduResponses().size(), 1u);
+    ASSERT_THROW(failing.get(), UnexpectedStatusWordException);
+    try {
+        third.get();
+        FAIL();
+    } catch (CardRequestAbortedException& e) {
+        ASSERT_TRUE(e.getCardResponse()->getApduResponses().empty());
+        ASSERT_FALSE(e.isCardResponseComplete());
+    }
+    ASSERT_THROW(fourth.get(), CardRequestAbortedException);
+    ASSERT_TRUE(session.isAborted());
+    ASSERT_THROW(
+        session.enqueue(createCardRequest({READ}), ChannelControl::KEEP_OPEN).get(),
+        CardRequestAbortedException);
+    ASSERT_EQ(reader->getExchangedApduCount(), 2u);
+
+    session.resume();
+
+    ASSERT_FALSE(session.isAborted());
+    ASSERT_EQ(
+        session.enqueue(createCardRequest({READ}), ChannelControl::KEEP_OPEN)
+            .get()
+            ->getApduResponses()[0]
+            ->getApdu(),
+        RECORD);
+}
+
+TEST(PipelinedCardSessionTest, failure_whenAbortedRequestClosesChannel_shouldReleaseChannel) {
+    std::promise<void> gate;
+    auto reader = std::make_shared<ReleaseCountingReader>(
+        std::make_shared<SimulatedProxyReader>(createGatedCard(gate.get_future())));
+    PipelinedCardSession session(reader);
+
+    auto failing = session.enqueue(createCardRequest({UNKNOWN}), ChannelControl::KEEP_OPEN);
+    auto aborted = session.enqueue(createCardRequest({READ}), ChannelControl::CLOSE_AFTER);
+    gate.set_value();
+
+    ASSERT_THROW(failing.get(), UnexpectedStatusWordException);
+    ASSERT_THROW(aborted.get(), CardRequestAbortedException);
+    ASSERT_EQ(reader->releaseCount, 1);
+}
+
+TEST(PipelinedCardSessionTest, enqueue_whenAbortedAndClosingChannel_shouldReleaseChannel) {
+    std::promise<void> gate;
+    gate.set_value();
+    auto reader = std::make_shared<ReleaseCountingReader>(
+        std::make_shared<SimulatedProxyReader>(createGatedCard(gate.get_future())));
+    PipelinedCardSession session(reader);
+
+    ASSERT_THROW(
+        session.enqueue(createCardRequest({UNKNOWN}), ChannelControl::KEEP_OPEN).get(),
+        UnexpectedStatusWordException);
+    ASSERT_TRUE(session.isAborted());
+    ASSERT_THROW(
+        session.enqueue(createCardRequest({READ}), ChannelControl::KEEP_OPEN).get(),
+        CardRequestAbortedException);
+    ASSERT_EQ(reader->releaseCount, 0);
+
+    ASSERT_THROW(
+        session.enqueue(createCardRequest({READ}), ChannelControl::CLOSE_AFTER).get(),
+        CardRequestAbortedException);
+    ASSERT_EQ(reader->releaseCount, 1);
+    ASSERT_TRUE(session.isAborted());
+}
+
+TEST(PipelinedCardSessionTest, close_shouldProcessPendingRequestsThenRefuse) {
+    std::promise<void> gate;
+    auto reader = std::make_shared<SimulatedProxyReader>(createGatedCard(gate.get_future()));
+    PipelinedCardSession session(reader);
+
+    auto first = session.enqueue(createCardRequest({READ}), ChannelControl::KEEP_OPEN);
+    auto second = session.enqueue(createCardRequest({READ}), ChannelControl::CLOSE_AFTER);
+    gate.set_value();
+    session.close();
+
+    ASSERT_EQ(first.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_FALSE(second.get()->isLogicalChannelOpen());
+    ASSERT_THROW(
+        session.enqueue(createCardRequest({READ}), ChannelControl::KEEP_OPEN), std::logic_error);
+}
+
+TEST(PipelinedCardSessionTest, constructor_whenReaderIsNull_shouldThrow) {
+    ASSERT_THROW(PipelinedCardSession(nullptr), std::invalid_argument);
+}
@@ -0,0 +1,221 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/ProxyReaderApi.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ApduResponseApi;
+using keypop::card::ByteSpan;
+using keypop::card::CardRequestTimeoutException;
+using keypop::card::CardResponseAdapter;
+using keypop::card::CardResponseApi;
+using keypop::card::CardTransmitResult;
+using keypop::card::CardTransmitStatus;
+using keypop::card::ChannelControl;
+using keypop::card::ProxyReaderApi;
+using keypop::card::ReaderBrokenCommunicationException;
+using keypop::card::UnexpectedStatusWordException;
+using keypop::card::spi::ApduRequestSpi;
+using keypop::card::spi::CardRequestSpi;
+using keypop::card::spi::CardResponseCallbackSpi;
+
+using testing::_;
+using testing::Return;
+using testing::Throw;
+
+class CardRequestSpiMock final : public CardRequestSpi {
+public:
+    MOCK_METHOD(
+        (const std::vector<std::shared_ptr<ApduRequestSpi>>&),
+        getApduRequests,
+        (),
+        (const, override));
+    MOCK_METHOD(bool, stopOnUnsuccessfulStatusWord, (), (const, override));
+};
+
+class CardResponseApiMock final : public CardResponseApi {
+public:
+    MOCK_METHOD(
+        (const std::vector<std::shared_ptr<ApduResponseApi>>&),
+        getApduResponses,
+        (),
+        (const, override));
+    MOCK_METHOD(bool, isLogicalChannelOpen, (), (const, override));
+};
+
+class ProxyReaderApiMock final : public ProxyReaderApi {
+public:
+    MOCK_METHOD(
+        const std::shared_ptr<CardResponseApi>,
+        transmitCardRequest,
+        (const std::shared_ptr<CardRequestSpi>, const ChannelControl),
+        (override));
+    MOCK_METHOD(void, releaseChannel, (), (override));
+};
+
+class CardResponseCallbackSpiMock final : public CardResponseCallbackSpi {
+public:
+    MOCK_METHOD(void, onCardResponse, (const std::shared_ptr<CardResponseApi>), (override));
+    MOCK_METHOD(void, onCardRequestFailure, (const std::exception_ptr), (override));
+};
+
+TEST(ProxyReaderApiTest, transmitCardRequestAsync_whenSuccessful_shouldNotifyResponse) {
+    ProxyReaderApiMock reader;
+    auto request = std::make_shared<CardRequestSpiMock>();
+    auto response = std::make_shared<CardResponseApiMock>();
+    auto callback = std::make_shared<CardResponseCallbackSpiMock>();
+
+    EXPECT_CALL(reader, transmitCardRequest(_, ChannelControl::CLOSE_AFTER))
+        .WillOnce(Return(response));
+    EXPECT_CALL(*callback, onCardResponse(std::shared_ptr<CardResponseApi>(response))).Times(1);
+    EXPECT_CALL(*callback, onCardRequestFailure(_)).Times(0);
+
+    reader.transmitCardRequestAsync(request, ChannelControl::CLOSE_AFTER, callback);
+}
+
+TEST(ProxyReaderApiTest, transmitCardRequestAsync_whenFailed_shouldNotifyOriginalException) {
+    ProxyReaderApiMock reader;
+    auto request = std::make_shared<CardRequestSpiMock>();
+    auto callback = std::make_shared<CardResponseCallbackSpiMock>();
+    std::exception_ptr failure;
+
+    EXPECT_CALL(reader, transmitCardRequest(_, _))
+        .WillOnce(Throw(std::invalid_argument("cardRequest")));
+    EXPECT_CALL(*callback, onCardResponse(_)).Times(0);
+    EXPECT_CALL(*callback, onCardRequestFailure(_))
+        .WillOnce(testing::SaveArg<0>(&failure));
+
+    reader.transmitCardRequestAsync(request, ChannelControl::KEEP_OPEN, callback);
+
+    ASSERT_THROW(std::rethrow_exception(failure), std::invalid_argument);
+}
+
+TEST(ProxyReaderApiTest, transmitCardRequestByReference_shouldBorrowRequestAndOwnResponse) {
+    ProxyReaderApiMock reader;
+    CardRequestSpiMock request;
+    auto response = std::make_shared<CardResponseApiMock>();
+    const std::vector<std::shared_ptr<ApduResponseApi>> apduResponses(2);
+    std::shared_ptr<CardRequestSpi> transmittedRequest;
+
+    EXPECT_CALL(*response, getApduResponses()).WillRepeatedly(testing::ReturnRef(apduResponses));
+    EXPECT_CALL(*response, isLogicalChannelOpen()).WillRepeatedly(Return(true));
+    EXPECT_CALL(reader, transmitCardRequest(_, ChannelControl::KEEP_OPEN))
+        .WillOnce(testing::DoAll(testing::SaveArg<0>(&transmittedRequest), Return(response)));
+
+    std::unique_ptr<CardResponseApi> ownedResponse
+        = static_cast<ProxyReaderApi&>(reader).transmitCardRequest(
+            static_cast<const CardRequestSpi&>(request), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(transmittedRequest.get(), &request);
+    ASSERT_EQ(transmittedRequest.use_count(), 0);
+    ASSERT_EQ(ownedResponse->getApduResponses().size(), 2U);
+    ASSERT_TRUE(ownedResponse->isLogicalChannelOpen());
+}
+
+TEST(ProxyReaderApiTest, transmitCardRequestByReference_shouldKeepSummaryOfReader) {
+    ProxyReaderApiMock reader;
+    CardRequestSpiMock request;
+    const uint8_t apdu[] = {0x62, 0x83};
+    auto response = std::make_shared<CardResponseAdapter>();
+    response->addApduResponse(
+        std::make_shared<ApduResponseAdapter>(ByteSpan(apdu, sizeof(apdu))), true);
+
+    EXPECT_CALL(reader, transmitCardRequest(_, ChannelControl::KEEP_OPEN))
+        .WillOnce(Return(response));
+
+    std::unique_ptr<CardResponseApi> ownedResponse
+        = static_cast<ProxyReaderApi&>(reader).transmitCardRequest(
+            static_cast<const CardRequestSpi&>(request), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(&ownedResponse->getApduResponses(), &response->getApduResponses());
+    ASSERT_TRUE(ownedResponse->getSummary().isAllSuccessful());
+}
+
+TEST(ProxyReaderApiTest, tryTransmitCardRequest_whenSuccessful_shouldReturnResponse) {
+    ProxyReaderApiMock reader;
+    auto request = std::make_shared<CardRequestSpiMock>();
+    auto response = std::make_shared<CardResponseApiMock>();
+
+    EXPECT_CALL(reader, transmitCardRequest(_, ChannelControl::KEEP_OPEN))
+        .WillOnce(Return(response));
+
+    const CardTransmitResult result
+        = reader.tryTransmitCardRequest(request, ChannelControl::KEEP_OPEN);
+
+    ASSERT_TRUE(result.isSuccessful());
+    ASSERT_EQ(result.getCardResponse(), response);
+    ASSERT_TRUE(result.isCardResponseComplete());
+}
+
+TEST(ProxyReaderApiTest, tryTransmitCardRequest_whenUnexpectedSw_shouldReturnPartialResponse) {
+    ProxyReaderApiMock reader;
+    auto request = std::make_shared<CardRequestSpiMock>();
+    auto response = std::make_shared<CardResponseApiMock>();
+
+    EXPECT_CALL(reader, transmitCardRequest(_, _))
+        .WillOnce(Throw(UnexpectedStatusWordException(response, false, "6283")));
+
+    const CardTransmitResult result
+        = reader.tryTransmitCardRequest(request, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(result.getStatus(), CardTransmitStatus::UNEXPECTED_STATUS_WORD);
+    ASSERT_EQ(result.getCardResponse(), response);
+    ASSERT_FALSE(result.isCardResponseComplete());
+    ASSERT_THROW(result.throwIfUnsuccessful(), UnexpectedStatusWordException);
+}
+
+TEST(ProxyReaderApiTest, tryTransmitCardRequest_whenReaderFailure_shouldReturnReaderStatus) {
+    ProxyReaderApiMock reader;
+    auto request = std::make_shared<CardRequestSpiMock>();
+    auto response = std::make_shared<CardResponseApiMock>();
+
+    EXPECT_CALL(reader, transmitCardRequest(_, _))
+        .WillOnce(Throw(ReaderBrokenCommunicationException(response, false, "reader")));
+
+    const CardTransmitResult result
+        = reader.tryTransmitCardRequest(request, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(result.getStatus(), CardTransmitStatus::READER_BROKEN_COMMUNICATION);
+}
+
+TEST(ProxyReaderApiTest, tryTransmitCardRequest_whenTimeout_shouldReturnTimeoutStatus) {
+    ProxyReaderApiMock reader;
+    auto request = std::make_shared<CardRequestSpiMock>();
+    auto response = std::make_shared<CardResponseApiMock>();
+
+    EXPECT_CALL(reader, transmitCardRequest(_, _))
+        .WillOnce(Throw(CardRequestTimeoutException(response, false, "deadline")));
+
+    const CardTransmitResult result
+        = reader.tryTransmitCardRequest(request, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(result.getStatus(), CardTransmitStatus::TIMEOUT);
+    ASSERT_EQ(result.getCardResponse(), response);
+    ASSERT_THROW(result.throwIfUnsuccessful(), CardRequestTimeoutException);
+}
+
+TEST(ProxyReaderApiTest, cardRequestSpi_shouldHaveNoDeadlineByDefault) {
+    CardRequestSpiMock request;
+
+    ASSERT_EQ(request.getDeadline(), std::chrono::steady_clock::time_point::max());
+    ASSERT_EQ(request.getApduTimeout().count(), 0);
+}
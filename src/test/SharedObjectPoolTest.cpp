@@ -0,0 +1,156 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/ApduResponseAdapter.hpp"
+#include "keypop/card/CardResponseAdapter.hpp"
+#include "keypop/card/SharedObjectPool.hpp"
+
+using keypop::card::ApduResponseAdapter;
+using keypop::card::ByteSpan;
+using keypop::card::CardResponseAdapter;
+using keypop::card::SharedObjectPool;
+
+static std::unique_ptr<ApduResponseAdapter>
+createApduResponse() {
+    return std::unique_ptr<ApduResponseAdapter>(new ApduResponseAdapter());
+}
+
+/* Pooled object counting its destructions */
+struct CountedObject {
+    explicit CountedObject(int& destructionCount)
+    : mDestructionCount(destructionCount) {
+    }
+
+    ~CountedObject() {
+        mDestructionCount++;
+    }
+
+    void
+    reset() {
+    }
+
+    int& mDestructionCount;
+};
+
+TEST(SharedObjectPoolTest, acquire_whenReleased_shouldRecycleResetObject) {
+    SharedObjectPool<ApduResponseAdapter> pool(createApduResponse, 4);
+    const std::vector<uint8_t> apdu = {0x12, 0x90, 0x00};
+
+    auto first = pool.acquire();
+    first->setApdu(ByteSpan(apdu));
+    ApduResponseAdapter* const address = first.get();
+    first.reset();
+
+    ASSERT_EQ(pool.size(), 1U);
+
+    auto second = pool.acquire();
+
+    ASSERT_EQ(second.get(), address);
+    ASSERT_TRUE(second->getApduView().empty());
+    ASSERT_EQ(pool.size(), 0U);
+}
+
+TEST(SharedObjectPoolTest, acquire_whenStillReferenced_shouldCreateNewObject) {
+    SharedObjectPool<ApduResponseAdapter> pool(createApduResponse, 4);
+
+    auto first = pool.acquire();
+    auto second = pool.acquire();
+
+    ASSERT_NE(first.get(), second.get());
+    ASSERT_EQ(pool.size(), 0U);
+}
+
+TEST(SharedObjectPoolTest, release_beyondMaxSize_shouldDestroyObject) {
+    int destructionCount = 0;
+    SharedObjectPool<CountedObject> pool(
+        [&destructionCount]() {
+            return std::unique_ptr<CountedObject>(new CountedObject(destructionCount));
+        },
+        1);
+
+    auto first = pool.acquire();
+    auto second = pool.acquire();
+    first.reset();
+    second.reset();
+
+    ASSERT_EQ(pool.size(), 1U);
+    ASSERT_EQ(destructionCount, 1);
+}
+
+TEST(SharedObjectPoolTest, weakReference_shouldExpireWhenObjectIsReleased) {
+    SharedObjectPool<ApduResponseAdapter> pool(createApduResponse, 4);
+
+    auto first = pool.acquire();
+    const std::weak_ptr<ApduResponseAdapter> weakReference = first;
+    first.reset();
+    auto second = pool.acquire();
+
+    ASSERT_TRUE(weakReference.expired());
+    ASSERT_EQ(weakReference.lock(), nullptr);
+    ASSERT_EQ(second.use_count(), 1);
+}
+
+TEST(SharedObjectPoolTest, weakReference_shouldKeepSlotUntilExpired) {
+    SharedObjectPool<ApduResponseAdapter> pool(createApduResponse, 4);
+
+    auto first = pool.acquire();
+    std::weak_ptr<ApduResponseAdapter> weakReference = first;
+    first.reset();
+
+    ASSERT_EQ(pool.size(), 0U);
+
+    weakReference.reset();
+
+    ASSERT_EQ(pool.size(), 1U);
+}
+
+TEST(SharedObjectPoolTest, release_afterPoolDestruction_shouldDestroyObject) {
+    int destructionCount = 0;
+    std::shared_ptr<CountedObject> object;
+    {
+        SharedObjectPool<CountedObject> pool([&destructionCount]() {
+            return std::unique_ptr<CountedObject>(new CountedObject(destructionCount));
+        });
+        object = pool.acquire();
+    }
+
+    object.reset();
+
+    ASSERT_EQ(destructionCount, 1);
+}
+
+TEST(SharedObjectPoolTest, cardResponseRelease_shouldReleaseApduResponses) {
+    SharedObjectPool<ApduResponseAdapter> apduResponsePool(createApduResponse, 4);
+    SharedObjectPool<CardResponseAdapter> cardResponsePool([]() {
+        return std::unique_ptr<CardResponseAdapter>(new CardResponseAdapter(8));
+    });
+
+    auto cardResponse = cardResponsePool.acquire();
+    cardResponse->addApduResponse(apduResponsePool.acquire());
+    cardResponse->setLogicalChannelOpen(true);
+    ApduResponseAdapter* const apduResponse
+        = static_cast<ApduResponseAdapter*>(cardResponse->getApduResponses()[0].get());
+    cardResponse.reset();
+
+    ASSERT_EQ(apduResponsePool.size(), 1U);
+
+    cardResponse = cardResponsePool.acquire();
+
+    ASSERT_TRUE(cardResponse->getApduResponses().empty());
+    ASSERT_FALSE(cardResponse->isLogicalChannelOpen());
+    ASSERT_EQ(apduResponsePool.acquire().get(), apduResponse);
+}
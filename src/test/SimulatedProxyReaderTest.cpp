@@ -0,0 +1,259 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/SimulatedProxyReader.hpp"
+
+#include "CardTestFixture.hpp"
+
+using keypop::card::ApduResponseBuffer;
+using keypop::card::ByteSpan;
+using keypop::card::CardBrokenCommunicationException;
+using keypop::card::CardRequestTimeoutException;
+using keypop::card::CardResponseApi;
+using keypop::card::CardTransmitResult;
+using keypop::card::CardTransmitStatus;
+using keypop::card::ChannelControl;
+using keypop::card::ReaderBrokenCommunicationException;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::UnexpectedStatusWordException;
+
+TEST(SimulatedProxyReaderTest, transmitCardRequest_shouldApplyRules) {
+    SimulatedProxyReader reader(createCard());
+
+    auto cardResponse
+        = reader.transmitCardRequest(createCardRequest({SELECT, READ}), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(cardResponse->getApduResponses().size(), 2u);
+    ASSERT_EQ(cardResponse->getApduResponses()[0]->getApdu(), FCI);
+    ASSERT_EQ(cardResponse->getApduResponses()[1]->getApdu(), RECORD);
+    ASSERT_TRUE(cardResponse->isLogicalChannelOpen());
+    ASSERT_EQ(reader.getExchangedApduCount(), 2u);
+}
+
+TEST(SimulatedProxyReaderTest, transmitCardRequest_withCloseAfter_shouldCloseChannel) {
+    SimulatedProxyReader reader(createCard());
+
+    auto cardResponse
+        = reader.transmitCardRequest(createCardRequest({SELECT}), ChannelControl::CLOSE_AFTER);
+
+    ASSERT_FALSE(cardResponse->isLogicalChannelOpen());
+}
+
+TEST(SimulatedProxyReaderTest, droppedResponses_shouldBeRecycled) {
+    SimulatedProxyReader reader(createCard());
+    auto cardResponse
+        = reader.transmitCardRequest(createCardRequest({SELECT}), ChannelControl::KEEP_OPEN);
+    const void* const cardResponseAddress = cardResponse.get();
+    const void* const apduResponseAddress = cardResponse->getApduResponses()[0].get();
+    cardResponse.reset();
+
+    cardResponse = reader.transmitCardRequest(createCardRequest({READ}), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(cardResponse.get(), cardResponseAddress);
+    ASSERT_EQ(cardResponse->getApduResponses().size(), 1u);
+    ASSERT_EQ(cardResponse->getApduResponses()[0].get(), apduResponseAddress);
+    ASSERT_EQ(cardResponse->getApduResponses()[0]->getApdu(), RECORD);
+}
+
+TEST(SimulatedProxyReaderTest, responses_shouldOutliveReader) {
+    std::shared_ptr<CardResponseApi> cardResponse;
+    {
+        SimulatedProxyReader reader(createCard());
+        cardResponse
+            = reader.transmitCardRequest(createCardRequest({SELECT}), ChannelControl::KEEP_OPEN);
+    }
+
+    ASSERT_EQ(cardResponse->getApduResponses()[0]->getApdu(), FCI);
+}
+
+TEST(SimulatedProxyReaderTest, unknownCommand_shouldThrowUnexpectedStatusWord) {
+    SimulatedProxyReader reader(createCard());
+    const std::vector<uint8_t> unknown = {0x00, 0x84, 0x00, 0x00, 0x08};
+
+    try {
+        reader.transmitCardRequest(createCardRequest({SELECT, unknown}), ChannelControl::KEEP_OPEN);
+        FAIL();
+    } catch (UnexpectedStatusWordException& e) {
+        ASSERT_EQ(e.getCardResponse()->getApduResponses().size(), 2u);
+        ASSERT_EQ(e.getCardResponse()->getApduResponses()[1]->getStatusWord(), 0x6D00);
+        ASSERT_TRUE(e.isCardResponseComplete());
+    }
+}
+
+TEST(SimulatedProxyReaderTest, tryTransmitCardRequest_withUnknownCommand_shouldReturnResult) {
+    SimulatedProxyReader reader(createCard());
+    const std::vector<uint8_t> unknown = {0x00, 0x84, 0x00, 0x00, 0x08};
+
+    const CardTransmitResult result = reader.tryTransmitCardRequest(
+        createCardRequest({unknown, READ}), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(result.getStatus(), CardTransmitStatus::UNEXPECTED_STATUS_WORD);
+    ASSERT_EQ(result.getCardResponse()->getApduResponses().size(), 1u);
+    ASSERT_FALSE(result.isCardResponseComplete());
+}
+
+TEST(SimulatedProxyReaderTest, unexpectedStatusWord_withCloseAfter_shouldCloseChannel) {
+    SimulatedProxyReader reader(createCard());
+    const std::vector<uint8_t> unknown = {0x00, 0x84, 0x00, 0x00, 0x08};
+
+    const CardTransmitResult result = reader.tryTransmitCardRequest(
+        createCardRequest({SELECT, unknown}), ChannelControl::CLOSE_AFTER);
+
+    ASSERT_EQ(result.getStatus(), CardTransmitStatus::UNEXPECTED_STATUS_WORD);
+    ASSERT_FALSE(result.getCardResponse()->isLogicalChannelOpen());
+}
+
+TEST(SimulatedProxyReaderTest, transmitCardRequestByReference_shouldOwnResponseOutsideOfPool) {
+    SimulatedProxyReader reader(createCard());
+    const auto cardRequest = createCardRequest({SELECT, READ});
+
+    std::unique_ptr<CardResponseApi> cardResponse
+        = reader.transmitCardRequest(*cardRequest, ChannelControl::CLOSE_AFTER);
+
+    ASSERT_NE(dynamic_cast<keypop::card::CardResponseAdapter*>(cardResponse.get()), nullptr);
+    ASSERT_EQ(cardResponse->getApduResponses().size(), 2u);
+    ASSERT_EQ(cardResponse->getApduResponses()[1]->getApdu(), RECORD);
+    ASSERT_FALSE(cardResponse->isLogicalChannelOpen());
+    ASSERT_EQ(cardRequest.use_count(), 1);
+}
+
+TEST(SimulatedProxyReaderTest, transmitCardRequestByReference_withUnknownCommand_shouldThrow) {
+    SimulatedProxyReader reader(createCard());
+
+    try {
+        reader.transmitCardRequest(*createCardRequest({UNKNOWN, READ}), ChannelControl::KEEP_OPEN);
+        FAIL();
+    } catch (UnexpectedStatusWordException& e) {
+        ASSERT_EQ(e.getCardResponse()->getApduResponses().size(), 1u);
+        ASSERT_EQ(e.getCardResponse()->getApduResponses()[0]->getStatusWord(), 0x6D00);
+        ASSERT_FALSE(e.isCardResponseComplete());
+    }
+}
+
+TEST(SimulatedProxyReaderTest, handler_shouldSeeCommand) {
+    auto card = std::make_shared<SimulatedCard>();
+    card->addHandler(ByteSpan(), SimulatedCard::echo(0x9000));
+    SimulatedProxyReader reader(card);
+
+    auto cardResponse
+        = reader.transmitCardRequest(createCardRequest({SELECT}), ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(
+        cardResponse->getApduResponses()[0]->getApdu(),
+        std::vector<uint8_t>({0x31, 0x54, 0x90, 0x00}));
+}
+
+TEST(SimulatedProxyReaderTest, scheduledTearing_shouldProcessCommandAndRemoveCard) {
+    int processedCount = 0;
+    auto card = std::make_shared<SimulatedCard>();
+    card->addHandler(ByteSpan(), [&processedCount](const ByteSpan, ApduResponseBuffer& response) {
+        processedCount++;
+        response.push_back(0x90);
+        response.push_back(0x00);
+    });
+    SimulatedProxyReader reader(card);
+    reader.scheduleFault(1, SimulatedProxyReader::Fault::CARD_TEARING);
+
+    try {
+        reader.transmitCardRequest(createCardRequest({SELECT, READ}), ChannelControl::KEEP_OPEN);
+        FAIL();
+    } catch (CardBrokenCommunicationException& e) {
+        ASSERT_EQ(e.getCardResponse()->getApduResponses().size(), 1u);
+        ASSERT_FALSE(e.getCardResponse()->isLogicalChannelOpen());
+        ASSERT_FALSE(e.isCardResponseComplete());
+    }
+    ASSERT_EQ(processedCount, 2);
+    ASSERT_FALSE(reader.isCardPresent());
+    ASSERT_THROW(
+        reader.transmitCardRequest(createCardRequest({READ}), ChannelControl::KEEP_OPEN),
+        CardBrokenCommunicationException);
+
+    reader.insertCard();
+
+    ASSERT_NO_THROW(
+        reader.transmitCardRequest(createCardRequest({READ}), ChannelControl::KEEP_OPEN));
+}
+
+TEST(SimulatedProxyReaderTest, readerFaultProbability_shouldThrowReaderBrokenCommunication) {
+    SimulatedProxyReader reader(createCard());
+    reader.setFaultProbability(SimulatedProxyReader::Fault::READER_BROKEN_COMMUNICATION, 1.0);
+
+    ASSERT_THROW(
+        reader.transmitCardRequest(createCardRequest({SELECT}), ChannelControl::KEEP_OPEN),
+        ReaderBrokenCommunicationException);
+    ASSERT_EQ(reader.getExchangedApduCount(), 0u);
+}
+
+TEST(SimulatedProxyReaderTest, virtualLatency_shouldBeAccumulatedWithinJitterBounds) {
+    SimulatedProxyReader reader(createCard(), 42);
+    reader.setLatency(std::chrono::microseconds(1000), std::chrono::microseconds(200))
+        .setRealTime(false);
+
+    for (int i = 0; i < 100; i++) {
+        reader.transmitCardRequest(createCardRequest({READ}), ChannelControl::KEEP_OPEN);
+    }
+
+    ASSERT_GE(reader.getElapsedLatency().count(), 100 * 800);
+    ASSERT_LE(reader.getElapsedLatency().count(), 100 * 1200);
+}
+
+TEST(SimulatedProxyReaderTest, deadline_shouldStopRemainingApdusWithPartialResponse) {
+    SimulatedProxyReader reader(createCard());
+    reader.setLatency(std::chrono::microseconds(50000)).setRealTime(false);
+    auto cardRequest = createCardRequest({SELECT, READ, READ, READ, READ});
+    cardRequest->setTimeout(std::chrono::microseconds(150000));
+
+    const CardTransmitResult result
+        = reader.tryTransmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(result.getStatus(), CardTransmitStatus::TIMEOUT);
+    ASSERT_EQ(result.getCardResponse()->getApduResponses().size(), 3u);
+    ASSERT_TRUE(result.getCardResponse()->isLogicalChannelOpen());
+    ASSERT_FALSE(result.isCardResponseComplete());
+    ASSERT_EQ(reader.getExchangedApduCount(), 3u);
+}
+
+TEST(SimulatedProxyReaderTest, apduTimeout_shouldCloseChannelAndThrowWithPartialResponse) {
+    SimulatedProxyReader reader(createCard());
+    reader.setLatency(std::chrono::microseconds(1000), std::chrono::microseconds(1000))
+        .setRealTime(false);
+    auto cardRequest = createCardRequest({READ, READ, READ, READ, READ, READ, READ, READ});
+    cardRequest->setApduTimeout(std::chrono::microseconds(1500));
+
+    try {
+        reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+        FAIL();
+    } catch (CardRequestTimeoutException& e) {
+        ASSERT_LT(e.getCardResponse()->getApduResponses().size(), 8u);
+        ASSERT_FALSE(e.getCardResponse()->isLogicalChannelOpen());
+        ASSERT_FALSE(e.isCardResponseComplete());
+    }
+    ASSERT_LT(reader.getElapsedLatency().count(), 8 * 1500 + 1);
+}
+
+TEST(SimulatedProxyReaderTest, deadline_whenNotReached_shouldNotInterfere) {
+    SimulatedProxyReader reader(createCard());
+    auto cardRequest = createCardRequest({SELECT, READ});
+    cardRequest->setTimeout(std::chrono::microseconds(std::chrono::seconds(10)))
+        .setApduTimeout(std::chrono::microseconds(std::chrono::seconds(1)));
+
+    ASSERT_EQ(
+        reader.tryTransmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN).getStatus(),
+        CardTransmitStatus::SUCCESSFUL);
+}
@@ -0,0 +1,92 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/StaticApdu.hpp"
+#include "keypop/card/StaticStatusWords.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/ApduCommand.hpp"
+#include "keypop/card/spi/StaticApduRequest.hpp"
+
+using keypop::card::StaticApdu;
+using keypop::card::StaticStatusWords;
+using keypop::card::StatusWordSet;
+using keypop::card::spi::ApduCommand;
+using keypop::card::spi::StaticApduRequest;
+
+using Verify = StaticApdu<0x00, 0x20, 0x00, 0x01, ApduCommand::NO_LE>;
+using ReadRecord = StaticApdu<0x94, 0xB2, 0x01, 0x3C, 0x1D>;
+using ReadBinary = StaticApdu<0x00, 0xB0, 0x00, 0x00, 256>;
+using UpdateRecord = StaticApdu<0x94, 0xDC, 0x01, 0x44, ApduCommand::NO_LE, 0x11, 0x22, 0x33>;
+using Select = StaticApdu<0x00, 0xA4, 0x04, 0x00, 256, 0x31, 0x54>;
+using ReadRecordStatusWords = StaticStatusWords<0x9000, 0x6282>;
+
+static_assert(Verify::LENGTH == 4, "Case 1");
+static_assert(ReadRecord::LENGTH == 5, "Case 2");
+static_assert(UpdateRecord::LENGTH == 8 && UpdateRecord::DATA_LENGTH == 3, "Case 3");
+static_assert(Select::LENGTH == 8, "Case 4");
+static_assert(ReadRecord::getBytes()[4] == 0x1D, "Le");
+static_assert(Select::getBytes()[4] == 0x02 && Select::getBytes()[7] == 0x00, "Lc and Le");
+static_assert(ReadRecordStatusWords::contains(0x6282), "Member");
+static_assert(!ReadRecordStatusWords::contains(0x6A82), "Not member");
+
+TEST(StaticApduTest, getBytes_shouldEncodeAllCases) {
+    ASSERT_EQ(Verify::getBytes().toVector(), std::vector<uint8_t>({0x00, 0x20, 0x00, 0x01}));
+    ASSERT_EQ(
+        ReadRecord::getBytes().toVector(), std::vector<uint8_t>({0x94, 0xB2, 0x01, 0x3C, 0x1D}));
+    ASSERT_EQ(
+        ReadBinary::getBytes().toVector(), std::vector<uint8_t>({0x00, 0xB0, 0x00, 0x00, 0x00}));
+    ASSERT_EQ(
+        UpdateRecord::getBytes().toVector(),
+        std::vector<uint8_t>({0x94, 0xDC, 0x01, 0x44, 0x03, 0x11, 0x22, 0x33}));
+    ASSERT_EQ(
+        Select::getBytes().toVector(),
+        std::vector<uint8_t>({0x00, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54, 0x00}));
+}
+
+TEST(StaticApduTest, getBytes_shouldViewStaticStorage) {
+    ASSERT_EQ(ReadRecord::getBytes().data(), ReadRecord::getBytes().data());
+}
+
+TEST(StaticApduTest, staticStatusWords_getSet_shouldMatchAndBeShared) {
+    const std::shared_ptr<const StatusWordSet>& statusWordSet = ReadRecordStatusWords::getSet();
+
+    ASSERT_TRUE(statusWordSet->contains(0x9000));
+    ASSERT_TRUE(statusWordSet->contains(0x6282));
+    ASSERT_FALSE(statusWordSet->contains(0x6A82));
+    ASSERT_EQ(statusWordSet, ReadRecordStatusWords::getSet());
+    ASSERT_EQ(StaticStatusWords<0x9000>::getSet(), StatusWordSet::getDefault());
+}
+
+TEST(StaticApduTest, staticApduRequest_of_shouldBeSharedView) {
+    const auto& apduRequest = StaticApduRequest::of<ReadRecord, ReadRecordStatusWords>();
+
+    ASSERT_EQ(apduRequest, (StaticApduRequest::of<ReadRecord, ReadRecordStatusWords>()));
+    ASSERT_NE(apduRequest, StaticApduRequest::of<ReadRecord>());
+    ASSERT_EQ(apduRequest->getApduView().data(), ReadRecord::getBytes().data());
+    ASSERT_EQ(apduRequest->getApdu(), ReadRecord::getBytes().toVector());
+    ASSERT_EQ(apduRequest->getSuccessfulStatusWordSet(), ReadRecordStatusWords::getSet());
+    ASSERT_EQ(
+        StaticApduRequest::of<ReadRecord>()->getSuccessfulStatusWordSet(),
+        StatusWordSet::getDefault());
+}
+
+TEST(StaticApduTest, staticApduRequest_constructor_shouldKeepInfo) {
+    StaticApduRequest apduRequest(Verify::getBytes(), nullptr, "Verify PIN");
+
+    ASSERT_EQ(apduRequest.getInfo(), "Verify PIN");
+    ASSERT_EQ(apduRequest.getSuccessfulStatusWords(), std::vector<int>({0x9000}));
+}
@@ -0,0 +1,81 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+#include <sstream>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/StatusWordSet.hpp"
+
+using keypop::card::StatusWordSet;
+
+TEST(StatusWordSetTest, getDefault_shouldOnlyContain9000) {
+    const auto& set = StatusWordSet::getDefault();
+
+    ASSERT_TRUE(set->contains(0x9000));
+    ASSERT_FALSE(set->contains(0x9001));
+    ASSERT_FALSE(set->contains(0x6283));
+    ASSERT_EQ(set->getStatusWords(), std::vector<int>({0x9000}));
+}
+
+TEST(StatusWordSetTest, of_whenOnly9000_shouldReturnInternedInstance) {
+    ASSERT_EQ(StatusWordSet::of({0x9000}), StatusWordSet::getDefault());
+    ASSERT_NE(StatusWordSet::of({0x9000, 0x6283}), StatusWordSet::getDefault());
+}
+
+TEST(StatusWordSetTest, addSw1_shouldMatchWholeClass) {
+    const auto set = StatusWordSet::Builder().add(0x9000).addSw1(0x61).build();
+
+    ASSERT_TRUE(set->contains(0x6100));
+    ASSERT_TRUE(set->contains(0x61FF));
+    ASSERT_FALSE(set->contains(0x6200));
+    ASSERT_EQ(set->getStatusWords().size(), 257U);
+    ASSERT_EQ(set->getStatusWords().front(), 0x6100);
+    ASSERT_EQ(set->getStatusWords().back(), 0x9000);
+}
+
+TEST(StatusWordSetTest, addRange_shouldMatchBounds) {
+    const auto set = StatusWordSet::Builder().addRange(0x62FE, 0x6301).build();
+
+    ASSERT_FALSE(set->contains(0x62FD));
+    ASSERT_TRUE(set->contains(0x62FE));
+    ASSERT_TRUE(set->contains(0x6300));
+    ASSERT_TRUE(set->contains(0x6301));
+    ASSERT_FALSE(set->contains(0x6302));
+}
+
+TEST(StatusWordSetTest, contains_whenOutOfRange_shouldReturnFalse) {
+    const auto set = StatusWordSet::Builder().addSw1(0x00).addSw1(0xFF).build();
+
+    ASSERT_FALSE(set->contains(-1));
+    ASSERT_FALSE(set->contains(0x10000));
+    ASSERT_TRUE(set->contains(0xFFFF));
+}
+
+TEST(StatusWordSetTest, addAll_shouldMergeSets) {
+    const auto first = StatusWordSet::Builder().add(0x9000).addSw1(0x6C).build();
+    const auto merged = StatusWordSet::Builder().addAll(*first).add(0x6283).build();
+
+    ASSERT_TRUE(merged->contains(0x9000));
+    ASSERT_TRUE(merged->contains(0x6C10));
+    ASSERT_TRUE(merged->contains(0x6283));
+    ASSERT_FALSE(first->contains(0x6283));
+}
+
+TEST(StatusWordSetTest, operatorOutput_shouldCollapseWholeSw1Classes) {
+    const auto set = StatusWordSet::Builder().add(0x9000).addSw1(0x61).add(0x6283).build();
+    std::ostringstream os;
+
+    os << *set;
+
+    ASSERT_EQ(os.str(), "{61xx, 6283, 9000}");
+}
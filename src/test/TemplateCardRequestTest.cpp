@@ -0,0 +1,138 @@
+/**************************************************************************************************
+ * Copyright (c) 2024 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the                       *
+ * terms of the MIT License which is available at https://opensource.org/licenses/MIT.            *
+ *                                                                                                *
+ * SPDX-License-Identifier: MIT                                                                   *
+ **************************************************************************************************/
+
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keypop Card */
+#include "keypop/card/SimulatedProxyReader.hpp"
+#include "keypop/card/StatusWordSet.hpp"
+#include "keypop/card/spi/CardRequestTemplate.hpp"
+#include "keypop/card/spi/TemplateCardRequest.hpp"
+
+using keypop::card::ByteSpan;
+using keypop::card::ChannelControl;
+using keypop::card::SimulatedCard;
+using keypop::card::SimulatedProxyReader;
+using keypop::card::StatusWordSet;
+using keypop::card::spi::ApduRequestSpi;
+using keypop::card::spi::CardRequestTemplate;
+using keypop::card::spi::TemplateCardRequest;
+
+static const std::vector<uint8_t> SELECT = {0x00, 0xA4, 0x04, 0x00, 0x02, 0x31, 0x54};
+static const std::vector<uint8_t> OPEN_SESSION
+    = {0x00, 0x8A, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+static std::shared_ptr<const CardRequestTemplate>
+createTemplate() {
+    return CardRequestTemplate::Builder()
+        .addApdu(ByteSpan(SELECT), nullptr, "Select")
+        .addApdu(ByteSpan(OPEN_SESSION), StatusWordSet::of({0x9000, 0x6200}), "Open Session")
+        .addField("p1", 1, 2, 1)
+        .addField("challenge", 1, 5, 4)
+        .build();
+}
+
+TEST(TemplateCardRequestTest, newInstance_shouldViewTemplateBytes) {
+    TemplateCardRequest cardRequest(createTemplate());
+
+    const auto& apduRequests = cardRequest.getApduRequests();
+
+    ASSERT_EQ(apduRequests.size(), 2u);
+    ASSERT_EQ(apduRequests[0]->getApduView().toVector(), SELECT);
+    ASSERT_EQ(apduRequests[1]->getApdu(), OPEN_SESSION);
+    ASSERT_EQ(apduRequests[1]->getInfo(), "Open Session");
+    ASSERT_TRUE(apduRequests[1]->getSuccessfulStatusWordSet()->contains(0x6200));
+    ASSERT_EQ(apduRequests[0]->getSuccessfulStatusWordSet(), StatusWordSet::getDefault());
+    ASSERT_TRUE(cardRequest.stopOnUnsuccessfulStatusWord());
+}
+
+TEST(TemplateCardRequestTest, patch_shouldWriteFieldsInPlace) {
+    const auto cardRequestTemplate = createTemplate();
+    const std::size_t p1 = cardRequestTemplate->getFieldIndex("p1");
+    const std::size_t challenge = cardRequestTemplate->getFieldIndex("challenge");
+    TemplateCardRequest cardRequest(cardRequestTemplate);
+    const std::shared_ptr<ApduRequestSpi> openSession = cardRequest.getApduRequests()[1];
+
+    cardRequest.patch(p1, 0x03).patch(challenge, std::vector<uint8_t>({0xC1, 0xC2, 0xC3, 0xC4}));
+
+    ASSERT_EQ(
+        openSession->getApduView().toVector(),
+        std::vector<uint8_t>({0x00, 0x8A, 0x03, 0x00, 0x04, 0xC1, 0xC2, 0xC3, 0xC4, 0x00}));
+    ASSERT_EQ(cardRequestTemplate->getBytes().subspan(SELECT.size(), 10).toVector(), OPEN_SESSION);
+
+    cardRequest.reset();
+
+    ASSERT_EQ(openSession->getApduView().toVector(), OPEN_SESSION);
+}
+
+TEST(TemplateCardRequestTest, patchInteger_shouldWriteBigEndian) {
+    const auto cardRequestTemplate = createTemplate();
+    TemplateCardRequest cardRequest(cardRequestTemplate);
+
+    cardRequest.patch(cardRequestTemplate->getFieldIndex("challenge"), 0x01020304u);
+
+    ASSERT_EQ(
+        cardRequest.getApduRequests()[1]->getApduView().subspan(5, 4).toVector(),
+        std::vector<uint8_t>({0x01, 0x02, 0x03, 0x04}));
+}
+
+TEST(TemplateCardRequestTest, invalidFields_shouldThrow) {
+    const auto cardRequestTemplate = createTemplate();
+    TemplateCardRequest cardRequest(cardRequestTemplate);
+
+    ASSERT_THROW(cardRequestTemplate->getFieldIndex("unknown"), std::invalid_argument);
+    ASSERT_THROW(cardRequest.patch("p1", std::vector<uint8_t>({1, 2})), std::invalid_argument);
+    ASSERT_THROW(
+        CardRequestTemplate::Builder().addApdu(ByteSpan(SELECT)).addField("p1", 0, 6, 2),
+        std::invalid_argument);
+    ASSERT_THROW(CardRequestTemplate::Builder().addField("p1", 0, 2, 1), std::invalid_argument);
+}
+
+TEST(TemplateCardRequestTest, apduRequests_shouldOutliveInstance) {
+    std::shared_ptr<ApduRequestSpi> select;
+    {
+        TemplateCardRequest cardRequest(createTemplate());
+        select = cardRequest.getApduRequests()[0];
+    }
+
+    ASSERT_EQ(select->getApduView().toVector(), SELECT);
+}
+
+TEST(TemplateCardRequestTest, transmit_shouldSendPatchedBytes) {
+    auto card = std::make_shared<SimulatedCard>();
+    card->addHandler(ByteSpan(), SimulatedCard::echo(0x9000));
+    SimulatedProxyReader reader(card);
+    const auto cardRequestTemplate = createTemplate();
+    auto cardRequest = std::make_shared<TemplateCardRequest>(cardRequestTemplate);
+
+    cardRequest->patch("challenge", std::vector<uint8_t>({0xAA, 0xBB, 0xCC, 0xDD}));
+    auto cardResponse = reader.transmitCardRequest(cardRequest, ChannelControl::KEEP_OPEN);
+
+    ASSERT_EQ(
+        cardResponse->getApduResponses()[1]->getDataOut(),
+        std::vector<uint8_t>({0xAA, 0xBB, 0xCC, 0xDD}));
+}
+
+TEST(TemplateCardRequestTest, getApduSequence_shouldReflectPatches) {
+    const auto cardRequestTemplate = createTemplate();
+    TemplateCardRequest cardRequest(cardRequestTemplate);
+
+    cardRequest.patch(cardRequestTemplate->getFieldIndex("p1"), 0x7Fu);
+
+    ASSERT_EQ(cardRequest.getApduSequence().size(), 2u);
+    ASSERT_EQ(cardRequest.getApduSequence().getApdu(1)[2], 0x7F);
+    ASSERT_EQ(cardRequest.getApduSequence().getApdu(0).toVector(), SELECT);
+}